@@ -0,0 +1,230 @@
+/******************************************************************************
+ * File Name: capture_io.c
+ *
+ * Description: Host-side reading and writing of raw-count captures.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "capture_io.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define CAPTURE_IO_BUFFER_SIZE      (1UL << 16)
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static bool header_valid(const char *path, const capture_header_t *header)
+{
+    if (CAPTURE_MAGIC != header->magic)
+    {
+        fprintf(stderr, "%s: not a touchpad capture\n", path);
+        return false;
+    }
+    if ((CAPTURE_VERSION != header->version) ||
+        (sizeof(capture_header_t) != header->header_size) ||
+        (sizeof(capture_frame_t) != header->frame_size) ||
+        (CAPTURE_TOUCHPAD_NUM_COLS != header->num_cols) ||
+        (CAPTURE_TOUCHPAD_NUM_ROWS != header->num_rows))
+    {
+        fprintf(stderr, "%s: unsupported capture version %u (%u x %u sensors, %u-byte frames)\n", path,
+                header->version, header->num_cols, header->num_rows, header->frame_size);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Reader
+ ******************************************************************************/
+bool capture_reader_open(capture_reader_t *reader, const char *path)
+{
+    struct stat st;
+    int fd;
+
+    memset(reader, 0, sizeof(*reader));
+
+    if (0 == strcmp(path, "-"))
+    {
+        fd = -1;
+        reader->file = stdin;
+    }
+    else
+    {
+        fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            return false;
+        }
+    }
+
+    if ((fd >= 0) && (0 == fstat(fd, &st)) && S_ISREG(st.st_mode) && (st.st_size > 0))
+    {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (MAP_FAILED != map)
+        {
+            (void)madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            reader->map = (const uint8_t *)map;
+            reader->map_size = (size_t)st.st_size;
+        }
+    }
+
+    if (NULL != reader->map)
+    {
+        close(fd);
+        if (reader->map_size < sizeof(capture_header_t))
+        {
+            fprintf(stderr, "%s: truncated header\n", path);
+            capture_reader_close(reader);
+            return false;
+        }
+        memcpy(&reader->header, reader->map, sizeof(capture_header_t));
+        reader->offset = sizeof(capture_header_t);
+    }
+    else
+    {
+        if (fd >= 0)
+        {
+            reader->file = fdopen(fd, "rb");
+            if (NULL == reader->file)
+            {
+                close(fd);
+                return false;
+            }
+        }
+        (void)setvbuf(reader->file, NULL, _IOFBF, CAPTURE_IO_BUFFER_SIZE);
+        if (1U != fread(&reader->header, sizeof(capture_header_t), 1U, reader->file))
+        {
+            fprintf(stderr, "%s: truncated header\n", path);
+            capture_reader_close(reader);
+            return false;
+        }
+    }
+
+    if (!header_valid(path, &reader->header))
+    {
+        capture_reader_close(reader);
+        return false;
+    }
+    return true;
+}
+
+/* Returns the next frame, or NULL at the end of the capture. A trailing
+ * partial frame, as left by a writer that was cut off, is ignored. */
+const capture_frame_t *capture_reader_next(capture_reader_t *reader)
+{
+    const capture_frame_t *frame;
+
+    if (NULL != reader->map)
+    {
+        if ((reader->map_size - reader->offset) < sizeof(capture_frame_t))
+        {
+            return NULL;
+        }
+        frame = (const capture_frame_t *)(const void *)(reader->map + reader->offset);
+        reader->offset += sizeof(capture_frame_t);
+    }
+    else
+    {
+        if (1U != fread(&reader->frame, sizeof(capture_frame_t), 1U, reader->file))
+        {
+            return NULL;
+        }
+        frame = &reader->frame;
+    }
+    reader->frames++;
+    return frame;
+}
+
+void capture_reader_close(capture_reader_t *reader)
+{
+    if (NULL != reader->map)
+    {
+        (void)munmap((void *)(uintptr_t)reader->map, reader->map_size);
+        reader->map = NULL;
+    }
+    if ((NULL != reader->file) && (stdin != reader->file))
+    {
+        fclose(reader->file);
+    }
+    reader->file = NULL;
+}
+
+/*******************************************************************************
+ * Writer
+ ******************************************************************************/
+bool capture_writer_open(capture_writer_t *writer, const char *path, const capture_header_t *header)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->file = (0 == strcmp(path, "-")) ? stdout : fopen(path, "wb");
+    if (NULL == writer->file)
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    (void)setvbuf(writer->file, NULL, _IOFBF, CAPTURE_IO_BUFFER_SIZE);
+    return (1U == fwrite(header, sizeof(*header), 1U, writer->file));
+}
+
+bool capture_writer_write(capture_writer_t *writer, const capture_frame_t *frame)
+{
+    writer->frames++;
+    return (1U == fwrite(frame, sizeof(*frame), 1U, writer->file));
+}
+
+void capture_writer_close(capture_writer_t *writer)
+{
+    if ((NULL != writer->file) && (stdout != writer->file))
+    {
+        fclose(writer->file);
+    }
+    else if (NULL != writer->file)
+    {
+        fflush(writer->file);
+    }
+    writer->file = NULL;
+}
+
+/* [] END OF FILE */
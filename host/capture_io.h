@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File Name: capture_io.h
+ *
+ * Description: Host-side reading and writing of raw-count captures (see
+ * source/capture.h). Regular files are memory-mapped and walked in place, other
+ * inputs such as pipes are streamed through a small buffer, so captures of any
+ * length are processed without loading them whole.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CAPTURE_IO_H
+#define CAPTURE_IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "capture.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    capture_header_t header;
+    FILE *file;                 /* Streamed input, NULL when mapped */
+    const uint8_t *map;         /* Mapped input, NULL when streamed */
+    size_t map_size;
+    size_t offset;
+    capture_frame_t frame;      /* Read buffer of a streamed input */
+    uint64_t frames;            /* Frames returned so far */
+} capture_reader_t;
+
+typedef struct
+{
+    FILE *file;
+    uint64_t frames;
+} capture_writer_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+/* path "-" reads standard input. Returns false and prints the reason on error. */
+bool capture_reader_open(capture_reader_t *reader, const char *path);
+const capture_frame_t *capture_reader_next(capture_reader_t *reader);
+void capture_reader_close(capture_reader_t *reader);
+
+bool capture_writer_open(capture_writer_t *writer, const char *path, const capture_header_t *header);
+bool capture_writer_write(capture_writer_t *writer, const capture_frame_t *frame);
+void capture_writer_close(capture_writer_t *writer);
+
+#endif /* CAPTURE_IO_H */
+
+/* [] END OF FILE */
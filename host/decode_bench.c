@@ -0,0 +1,729 @@
+/******************************************************************************
+ * File Name: decode_bench.c
+ *
+ * Description: Gesture decode benchmark (touchpad_decode_bench). Runs synthetic
+ * finger trajectories with clean, noisy and liquid-contaminated raw counts
+ * through Cy_CapSense_ProcessWidget() and Cy_CapSense_DecodeWidgetGestures() of
+ * the touchpad, and reports the host time per frame, the heap allocations made
+ * by the processing chain and the gesture accuracy against the scripted ground
+ * truth as JSON. A sweep repeats the scripts at jittered frame periods with
+ * the gesture timestamp taken from the WDT counter by the firmware gesture
+ * clock, and with the fixed one tick per frame it replaces.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "synth.h"
+#include "gesture_names.h"
+#include "ilo_comp.h"
+#include "gesture_clock.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Touchpad scan period of the active power level */
+#define BENCH_FRAME_MS              (10U)
+
+/* Frame periods of the sweep: the wet interval of the active level, the
+ * active level, the touch-idle level and a slower candidate */
+#define BENCH_SWEEP_PERIODS_US      { 5000U, 10000U, 20000U, 40000U }
+
+/* ILO frequency of the sweep unless -i is given, the nominal rate */
+#define BENCH_ILO_HZ                (40000U)
+
+/* Each frame of the sweep runs late by up to this share of the period, for
+ * the processing time and the scan wait before Deep Sleep */
+#define BENCH_SWEEP_JITTER_PCT      (20U)
+
+/* Idle time before the first event, lets the baseline settle */
+#define BENCH_LEAD_MS               (300U)
+
+/* Start-to-start time of two events; longer than the double click interval */
+#define BENCH_EVENT_PITCH_MS        (1000U)
+
+/* Position jitter of the events, touchpad resolution units */
+#define BENCH_JITTER                (8)
+
+#define BENCH_MAX_EVENT_STROKES     (2U)
+#define BENCH_DEFAULT_ITERATIONS    (5U)
+#define BENCH_DEFAULT_REPETITIONS   (10U)
+
+/* Layout version of the JSON report */
+#define BENCH_REPORT_VERSION        (2U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* One scripted gesture. Strokes start relative to the event; the event is
+ * correct when the expected gesture is reported before the next event, and
+ * any other reported gesture except the allowed one is a false gesture. A
+ * fast scroll ends in a flick in the same direction and a flick starts as a
+ * scroll, so each allows the other. */
+typedef struct
+{
+    const char *name;
+    synth_stroke_t strokes[BENCH_MAX_EVENT_STROKES];
+    uint32_t num_strokes;
+    uint32_t expected;
+    uint32_t allowed;           /* Companion gesture, 0 - none */
+} bench_event_t;
+
+typedef enum
+{
+    BENCH_NOISE_CLEAN,          /* Synthesizer noise only */
+    BENCH_NOISE_WHITE,          /* White noise close to the noise threshold */
+    BENCH_NOISE_FILM,           /* Water film spreading over half the pad */
+    BENCH_NOISE_DROPLETS,       /* Droplets landing on random sensors */
+    BENCH_NOISE_COUNT
+} bench_noise_t;
+
+/* Source of the gesture timestamp interval of a frame */
+typedef enum
+{
+    BENCH_TIMEBASE_FIXED,       /* One tick per frame */
+    BENCH_TIMEBASE_WDT,         /* gesture_clock from the WDT counter */
+    BENCH_TIMEBASE_COUNT
+} bench_timebase_t;
+
+typedef struct
+{
+    uint32_t period_us;         /* Nominal frame period */
+    uint32_t jitter_pct;        /* Largest lateness of a frame, % of the period */
+    bench_timebase_t timebase;
+} bench_timing_t;
+
+typedef struct
+{
+    uint64_t frames;
+    uint64_t host_ns_best;
+    uint64_t host_ns_total;
+    uint64_t device_ns;
+    uint64_t allocations;
+    uint32_t events;
+    uint32_t hits;
+    uint32_t false_gestures;
+} bench_result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Gestures handled by the application, as in the demo script */
+static const bench_event_t bench_events[] =
+{
+    { "tap",            { {   0U, 150U, 1U,  80, 50,  80, 50,   0,   0 } }, 1U, 0x00000001UL, 0U },
+    { "double_tap",     { {   0U, 150U, 1U,  80, 50,  80, 50,   0,   0 },
+                          { 250U, 150U, 1U,  82, 50,  82, 50,   0,   0 } }, 2U, 0x00000002UL, 0x00000001UL },
+    { "scroll_right",   { {   0U, 300U, 1U,  20, 50, 140, 50,   0,   0 } }, 1U, 0x00020010UL, 0x02000080UL },
+    { "scroll_left",    { {   0U, 300U, 1U, 140, 50,  20, 50,   0,   0 } }, 1U, 0x00030010UL, 0x03000080UL },
+    { "scroll_up",      { {   0U, 200U, 1U,  80, 90,  80, 10,   0,   0 } }, 1U, 0x00000010UL, 0x00000080UL },
+    { "scroll_down",    { {   0U, 200U, 1U,  80, 10,  80, 90,   0,   0 } }, 1U, 0x00010010UL, 0x01000080UL },
+    { "flick_right",    { {   0U, 100U, 1U,  50, 50,  90, 50,   0,   0 } }, 1U, 0x02000080UL, 0x00020010UL },
+    { "flick_left",     { {   0U, 100U, 1U, 110, 50,  70, 50,   0,   0 } }, 1U, 0x03000080UL, 0x00030010UL },
+    { "two_finger_tap", { {   0U, 150U, 2U,  80, 50,  80, 50,  60,  60 } }, 1U, 0x00000008UL, 0U },
+    { "zoom_in",        { {   0U, 200U, 2U,  80, 50,  80, 50,  30, 140 } }, 1U, 0x00000200UL, 0U },
+    { "zoom_out",       { {   0U, 200U, 2U,  80, 50,  80, 50, 140,  30 } }, 1U, 0x00800200UL, 0U },
+};
+
+#define BENCH_NUM_EVENTS            (sizeof(bench_events) / sizeof(bench_events[0]))
+
+static const char *const bench_noise_names[BENCH_NOISE_COUNT] =
+{
+    "clean", "white", "film", "droplets"
+};
+
+static const char *const bench_timebase_names[BENCH_TIMEBASE_COUNT] =
+{
+    "fixed", "wdt"
+};
+
+static const uint32_t bench_sweep_periods_us[] = BENCH_SWEEP_PERIODS_US;
+
+#define BENCH_NUM_PERIODS           (sizeof(bench_sweep_periods_us) / sizeof(bench_sweep_periods_us[0]))
+
+/* Simulator setup of every pass; -i sets the ILO off its nominal rate */
+static sim_config_t bench_config = { 0 };
+
+/* Heap calls seen by the --wrap'ed allocator entry points */
+static uint64_t allocations = 0U;
+
+/*******************************************************************************
+ * Allocation counting
+ ******************************************************************************/
+/* The bench is linked with --wrap for these symbols, so every call from the
+ * processing chain lands here */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+    allocations++;
+    return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static uint32_t bench_rand(uint32_t *state)
+{
+    *state = (*state * 1664525UL) + 1013904223UL;
+    return *state >> 16;
+}
+
+static uint64_t elapsed_ns(const struct timespec *t0, const struct timespec *t1)
+{
+    return ((uint64_t)(t1->tv_sec - t0->tv_sec) * SIM_NS_PER_S) + (uint64_t)t1->tv_nsec - (uint64_t)t0->tv_nsec;
+}
+
+/* Places repetitions of the event on the timeline with jittered positions */
+static uint32_t build_script(const bench_event_t *event, uint32_t repetitions, synth_stroke_t *strokes)
+{
+    uint32_t seed = 7U;
+    uint32_t n = 0U;
+
+    for (uint32_t r = 0U; r < repetitions; r++)
+    {
+        int16_t dx = (int16_t)((int32_t)(bench_rand(&seed) % ((2U * BENCH_JITTER) + 1U)) - BENCH_JITTER);
+        int16_t dy = (int16_t)((int32_t)(bench_rand(&seed) % ((2U * BENCH_JITTER) + 1U)) - BENCH_JITTER);
+
+        for (uint32_t i = 0U; i < event->num_strokes; i++)
+        {
+            synth_stroke_t *s = &strokes[n++];
+
+            *s = event->strokes[i];
+            s->start_ms += BENCH_LEAD_MS + (r * BENCH_EVENT_PITCH_MS);
+            s->x0 = (int16_t)(s->x0 + dx);
+            s->x1 = (int16_t)(s->x1 + dx);
+            s->y0 = (int16_t)(s->y0 + dy);
+            s->y1 = (int16_t)(s->y1 + dy);
+        }
+    }
+    return n;
+}
+
+/* Adds the contamination to the raw counts of the frame at t_ms */
+static void add_noise(bench_noise_t noise, uint32_t t_ms, uint32_t period_us, uint32_t length_ms, uint32_t *seed,
+                      sim_frame_t *frame)
+{
+    static uint32_t drop_until_ms[CY_CAPSENSE_TOUCHPAD0_NUM_SNS];
+
+    switch (noise)
+    {
+    case BENCH_NOISE_WHITE:
+        for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+        {
+            frame->tp[i] = (uint16_t)(frame->tp[i] + (bench_rand(seed) % 30U) - 15U);
+        }
+        break;
+
+    case BENCH_NOISE_FILM:
+        /* The film grows over the left half of the pad during the run; it
+         * couples to all rows under it and ripples at 2 Hz */
+        for (uint32_t i = 0U; i < (CY_CAPSENSE_TOUCHPAD0_NUM_COLS / 2U); i++)
+        {
+            uint32_t level = (40U * t_ms) / length_ms;
+            uint32_t ripple = (((t_ms / 250U) & 1U) != 0U) ? 6U : 0U;
+
+            frame->tp[i] = (uint16_t)(frame->tp[i] + level + ripple);
+        }
+        for (uint32_t i = CY_CAPSENSE_TOUCHPAD0_NUM_COLS; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+        {
+            frame->tp[i] = (uint16_t)(frame->tp[i] + ((20U * t_ms) / length_ms));
+        }
+        break;
+
+    case BENCH_NOISE_DROPLETS:
+        if (0U == t_ms)
+        {
+            memset(drop_until_ms, 0, sizeof(drop_until_ms));
+        }
+        /* About one droplet per 200 ms, each on one column and one row for
+         * 300 to 800 ms; the signal is what remains with the shield driven,
+         * below the finger threshold */
+        if (0U == (bench_rand(seed) % ((200000U + period_us - 1U) / period_us)))
+        {
+            uint32_t col = bench_rand(seed) % CY_CAPSENSE_TOUCHPAD0_NUM_COLS;
+            uint32_t row = CY_CAPSENSE_TOUCHPAD0_NUM_COLS + (bench_rand(seed) % CY_CAPSENSE_TOUCHPAD0_NUM_ROWS);
+            uint32_t until = t_ms + 300U + (bench_rand(seed) % 500U);
+
+            drop_until_ms[col] = until;
+            drop_until_ms[row] = until;
+        }
+        for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+        {
+            if (t_ms < drop_until_ms[i])
+            {
+                frame->tp[i] = (uint16_t)(frame->tp[i] + 45U);
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* Renders the whole run before timing, so the synthesizer is not measured.
+ * Frame f is taken at times_us[f]; later frames run late by up to jitter_pct
+ * of the period, as a frame waits for the processing of the one before. */
+static sim_frame_t *render(const bench_event_t *event, bench_noise_t noise, uint32_t repetitions,
+                           const bench_timing_t *timing, uint64_t *num_frames, uint32_t **times_us)
+{
+    synth_stroke_t strokes[BENCH_MAX_EVENT_STROKES * 64U];
+    synth_t synth = { 0 };
+    sim_frame_t *frames;
+    uint32_t *times;
+    uint32_t noise_seed = 11U;
+    uint32_t jitter_seed = 13U;
+    uint32_t jitter_max = (timing->period_us * timing->jitter_pct) / 100U;
+    uint32_t length_ms = BENCH_LEAD_MS + (repetitions * BENCH_EVENT_PITCH_MS);
+    uint64_t n = ((uint64_t)length_ms * 1000U) / timing->period_us;
+
+    synth.strokes = strokes;
+    synth.num_strokes = build_script(event, repetitions, strokes);
+    synth.length_ms = length_ms;
+    synth.noise = 6U;
+    synth.seed = 1U;
+
+    frames = malloc((size_t)n * sizeof(sim_frame_t));
+    times = malloc((size_t)n * sizeof(uint32_t));
+    if ((NULL == frames) || (NULL == times))
+    {
+        free(frames);
+        free(times);
+        return NULL;
+    }
+    for (uint64_t i = 0U; i < n; i++)
+    {
+        uint32_t t_us = (uint32_t)i * timing->period_us;
+        uint32_t t_ms;
+
+        if ((0U != jitter_max) && (0U != i))
+        {
+            t_us += bench_rand(&jitter_seed) % (jitter_max + 1U);
+        }
+        t_ms = t_us / 1000U;
+        times[i] = t_us;
+        (void)synth_source(&synth, (uint64_t)t_us * SIM_NS_PER_US, &frames[i]);
+        add_noise(noise, t_ms, timing->period_us, length_ms, &noise_seed, &frames[i]);
+    }
+    *num_frames = n;
+    *times_us = times;
+    return frames;
+}
+
+/* WDT counter at t_us after the start of the run, at the simulated ILO rate */
+static uint32_t wdt_count(uint32_t t_us)
+{
+    return (uint32_t)(((uint64_t)t_us * bench_config.ilo_hz) / 1000000U) & GESTURE_CLOCK_WDT_MASK;
+}
+
+/* Processes the rendered frames once; scores the gestures when result is set.
+ * As in main(), the gestures are decoded only on frames that advance the
+ * timestamp. */
+static uint64_t run_chain(const sim_frame_t *frames, const uint32_t *times_us, uint64_t num_frames,
+                          const bench_event_t *event, bench_timebase_t timebase, bench_result_t *score)
+{
+    const cy_stc_capsense_widget_config_t *wd = &cy_capsense_context.ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID];
+    cy_stc_capsense_common_context_t *common = cy_capsense_context.ptrCommonContext;
+    struct timespec t0;
+    struct timespec t1;
+    uint64_t setup_ns;
+    uint32_t gest = 0U;
+    uint32_t lgest = 0U;
+    uint32_t hit_event = UINT32_MAX;
+
+    /* The ILO measurement of the gesture clock is not part of the chain */
+    sim_reset(&bench_config);
+    Cy_SysClk_IloEnable();
+    ilo_comp_init();
+    gesture_clock_init(wdt_count(times_us[0]));
+    setup_ns = sim_get_stats()->active_ns;
+
+    (void)Cy_CapSense_Init(&cy_capsense_context);
+    Cy_CapSense_SetGestureTimestamp(0U, &cy_capsense_context);
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+    {
+        wd->ptrSnsContext[i].raw = frames[0].tp[i];
+    }
+    Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint64_t f = 0U; f < num_frames; f++)
+    {
+        for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+        {
+            wd->ptrSnsContext[i].raw = frames[f].tp[i];
+        }
+        if (BENCH_TIMEBASE_WDT == timebase)
+        {
+            gesture_clock_update(wdt_count(times_us[f]));
+            common->timestampInterval = gesture_clock_take_ticks();
+        }
+        else
+        {
+            common->timestampInterval = 1U;
+        }
+        Cy_CapSense_IncrementGestureTimestamp(&cy_capsense_context);
+
+        (void)Cy_CapSense_ProcessWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+        if (0U != common->timestampInterval)
+        {
+            gest = Cy_CapSense_DecodeWidgetGestures(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+        }
+
+        /* Score changes of the decoded gesture, as the application reports them */
+        if ((NULL != score) && (gest != lgest) && (0U != gest))
+        {
+            uint32_t t_ms = times_us[f] / 1000U;
+            uint32_t ev = (t_ms >= BENCH_LEAD_MS) ? ((t_ms - BENCH_LEAD_MS) / BENCH_EVENT_PITCH_MS) : UINT32_MAX;
+
+            if ((gest == event->expected) && (UINT32_MAX != ev))
+            {
+                if (ev != hit_event)
+                {
+                    score->hits++;
+                    hit_event = ev;
+                }
+            }
+            else if ((gest != event->allowed) || (UINT32_MAX == ev))
+            {
+                score->false_gestures++;
+            }
+            else
+            {
+                /* Intermediate gesture of the event */
+            }
+        }
+        lgest = gest;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Modelled device time, identical in every iteration */
+    if (NULL != score)
+    {
+        score->device_ns = sim_get_stats()->active_ns - setup_ns;
+    }
+    return elapsed_ns(&t0, &t1);
+}
+
+static void run_scenario(const bench_event_t *event, bench_noise_t noise, uint32_t repetitions,
+                         uint32_t iterations, const bench_timing_t *timing, bench_result_t *result)
+{
+    sim_frame_t *frames;
+    uint32_t *times_us = NULL;
+    uint64_t num_frames = 0U;
+
+    memset(result, 0, sizeof(*result));
+    frames = render(event, noise, repetitions, timing, &num_frames, &times_us);
+    if (NULL == frames)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    result->frames = num_frames;
+    result->events = repetitions;
+    result->host_ns_best = UINT64_MAX;
+
+    for (uint32_t it = 0U; it < iterations; it++)
+    {
+        uint64_t allocs = allocations;
+        uint64_t ns = run_chain(frames, times_us, num_frames, event, timing->timebase, (0U == it) ? result : NULL);
+
+        result->allocations += allocations - allocs;
+        result->host_ns_total += ns;
+        if (ns < result->host_ns_best)
+        {
+            result->host_ns_best = ns;
+        }
+    }
+    free(times_us);
+    free(frames);
+}
+
+static double accuracy(const bench_result_t *r)
+{
+    return (0U != (r->events + r->false_gestures)) ?
+           ((double)r->hits / (double)(r->events + r->false_gestures)) : 0.0;
+}
+
+static void print_result(FILE *out, const char *event, const char *noise, const bench_result_t *r,
+                         uint32_t iterations, bool last)
+{
+    fprintf(out,
+            "    { \"event\": \"%s\", \"noise\": \"%s\", \"frames\": %llu, "
+            "\"ns_per_frame\": %.1f, \"ns_per_frame_mean\": %.1f, \"device_us_per_frame\": %.2f, "
+            "\"allocations\": %llu, \"events\": %u, \"hits\": %u, \"false_gestures\": %u, "
+            "\"accuracy\": %.4f }%s\n",
+            event, noise, (unsigned long long)r->frames,
+            (double)r->host_ns_best / (double)r->frames,
+            (double)r->host_ns_total / (double)r->frames / (double)iterations,
+            (double)r->device_ns / 1000.0 / (double)r->frames,
+            (unsigned long long)r->allocations, r->events, r->hits, r->false_gestures, accuracy(r),
+            last ? "" : ",");
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -n ITER   timed passes over every scenario (default %u)\n"
+            "  -r REPS   events per scenario (default %u, at most 32)\n"
+            "  -e NAME   run only the named event\n"
+            "  -i HZ     actual ILO frequency of the frame period sweep (default %u)\n"
+            "  -o FILE   write the JSON report to FILE (default: standard output)\n"
+            "  -q        do not print the summary table on standard error\n",
+            prog, BENCH_DEFAULT_ITERATIONS, BENCH_DEFAULT_REPETITIONS, BENCH_ILO_HZ);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the decode benchmark.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    bench_result_t results[BENCH_NUM_EVENTS][BENCH_NOISE_COUNT];
+    bench_result_t total = { 0 };
+    bench_result_t sweep[BENCH_NUM_PERIODS][BENCH_TIMEBASE_COUNT] = { { { 0 } } };
+    bench_timing_t timing = { BENCH_FRAME_MS * 1000U, 0U, BENCH_TIMEBASE_WDT };
+    uint32_t iterations = BENCH_DEFAULT_ITERATIONS;
+    uint32_t repetitions = BENCH_DEFAULT_REPETITIONS;
+    const char *only = NULL;
+    const char *out_path = NULL;
+    bool quiet = false;
+    FILE *out = stdout;
+    uint32_t runs = 0U;
+    uint32_t printed = 0U;
+    int opt;
+
+    bench_config.ilo_hz = BENCH_ILO_HZ;
+    while (-1 != (opt = getopt(argc, argv, "n:r:e:i:o:qh")))
+    {
+        switch (opt)
+        {
+        case 'n': iterations = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'r': repetitions = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'e': only = optarg; break;
+        case 'i': bench_config.ilo_hz = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'o': out_path = optarg; break;
+        case 'q': quiet = true; break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+    if ((optind != argc) || (0U == iterations) || (0U == repetitions) || (repetitions > 32U) ||
+        (0U == bench_config.ilo_hz))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    total.host_ns_best = 0U;
+    for (uint32_t e = 0U; e < BENCH_NUM_EVENTS; e++)
+    {
+        if ((NULL != only) && (0 != strcmp(only, bench_events[e].name)))
+        {
+            continue;
+        }
+        for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+        {
+            bench_result_t *r = &results[e][n];
+
+            run_scenario(&bench_events[e], (bench_noise_t)n, repetitions, iterations, &timing, r);
+            total.frames += r->frames;
+            total.host_ns_best += r->host_ns_best;
+            total.host_ns_total += r->host_ns_total;
+            total.device_ns += r->device_ns;
+            total.allocations += r->allocations;
+            total.events += r->events;
+            total.hits += r->hits;
+            total.false_gestures += r->false_gestures;
+            runs++;
+        }
+    }
+    if (0U == runs)
+    {
+        fprintf(stderr, "unknown event '%s'\n", only);
+        return 2;
+    }
+
+    /* The same scripts at other frame periods, each with both timebases;
+     * scored once, the timing of these passes is not reported */
+    timing.jitter_pct = BENCH_SWEEP_JITTER_PCT;
+    for (uint32_t p = 0U; p < BENCH_NUM_PERIODS; p++)
+    {
+        for (uint32_t tb = 0U; tb < BENCH_TIMEBASE_COUNT; tb++)
+        {
+            bench_result_t *acc = &sweep[p][tb];
+
+            timing.period_us = bench_sweep_periods_us[p];
+            timing.timebase = (bench_timebase_t)tb;
+            for (uint32_t e = 0U; e < BENCH_NUM_EVENTS; e++)
+            {
+                if ((NULL != only) && (0 != strcmp(only, bench_events[e].name)))
+                {
+                    continue;
+                }
+                for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+                {
+                    bench_result_t r;
+
+                    run_scenario(&bench_events[e], (bench_noise_t)n, repetitions, 1U, &timing, &r);
+                    acc->frames += r.frames;
+                    acc->events += r.events;
+                    acc->hits += r.hits;
+                    acc->false_gestures += r.false_gestures;
+                }
+            }
+        }
+    }
+
+    if (NULL != out_path)
+    {
+        out = fopen(out_path, "w");
+        if (NULL == out)
+        {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n  \"benchmark\": \"touchpad_decode\",\n  \"version\": %u,\n", BENCH_REPORT_VERSION);
+    fprintf(out, "  \"frame_ms\": %u,\n  \"iterations\": %u,\n  \"repetitions\": %u,\n",
+            BENCH_FRAME_MS, iterations, repetitions);
+    fprintf(out, "  \"scenarios\": [\n");
+    for (uint32_t e = 0U; e < BENCH_NUM_EVENTS; e++)
+    {
+        if ((NULL != only) && (0 != strcmp(only, bench_events[e].name)))
+        {
+            continue;
+        }
+        for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+        {
+            printed++;
+            print_result(out, bench_events[e].name, bench_noise_names[n], &results[e][n], iterations,
+                         printed == runs);
+        }
+    }
+    fprintf(out, "  ],\n  \"total\":\n");
+    print_result(out, "all", "all", &total, iterations, false);
+    fprintf(out, "  \"sweep\": {\n    \"ilo_hz\": %u,\n    \"jitter_pct\": %u,\n    \"runs\": [\n",
+            bench_config.ilo_hz, BENCH_SWEEP_JITTER_PCT);
+    for (uint32_t p = 0U; p < BENCH_NUM_PERIODS; p++)
+    {
+        for (uint32_t tb = 0U; tb < BENCH_TIMEBASE_COUNT; tb++)
+        {
+            const bench_result_t *r = &sweep[p][tb];
+
+            fprintf(out,
+                    "      { \"frame_us\": %u, \"timebase\": \"%s\", \"frames\": %llu, \"events\": %u, "
+                    "\"hits\": %u, \"false_gestures\": %u, \"accuracy\": %.4f }%s\n",
+                    bench_sweep_periods_us[p], bench_timebase_names[tb], (unsigned long long)r->frames,
+                    r->events, r->hits, r->false_gestures, accuracy(r),
+                    ((p + 1U == BENCH_NUM_PERIODS) && (tb + 1U == BENCH_TIMEBASE_COUNT)) ? "" : ",");
+        }
+    }
+    fprintf(out, "    ]\n  }\n}\n");
+    if (stdout != out)
+    {
+        fclose(out);
+    }
+
+    if (!quiet)
+    {
+        fprintf(stderr, "%-16s %-9s %8s %9s %9s %6s %6s %6s\n",
+                "event", "noise", "ns/frame", "dev us", "allocs", "hits", "false", "acc");
+        for (uint32_t e = 0U; e < BENCH_NUM_EVENTS; e++)
+        {
+            if ((NULL != only) && (0 != strcmp(only, bench_events[e].name)))
+            {
+                continue;
+            }
+            for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+            {
+                const bench_result_t *r = &results[e][n];
+
+                fprintf(stderr, "%-16s %-9s %8.1f %9.2f %9llu %3u/%-2u %6u %6.3f\n",
+                        bench_events[e].name, bench_noise_names[n], (double)r->host_ns_best / (double)r->frames,
+                        (double)r->device_ns / 1000.0 / (double)r->frames, (unsigned long long)r->allocations,
+                        r->hits, r->events, r->false_gestures, accuracy(r));
+            }
+        }
+        fprintf(stderr, "%-16s %-9s %8.1f %9.2f %9llu %3u/%-2u %6u %6.3f\n", "all", "",
+                (double)total.host_ns_best / (double)total.frames,
+                (double)total.device_ns / 1000.0 / (double)total.frames, (unsigned long long)total.allocations,
+                total.hits, total.events, total.false_gestures, accuracy(&total));
+
+        fprintf(stderr, "\n%-9s %15s %15s\n", "frame", "fixed tick", "wdt clock");
+        for (uint32_t p = 0U; p < BENCH_NUM_PERIODS; p++)
+        {
+            fprintf(stderr, "%6.1f ms", (double)bench_sweep_periods_us[p] / 1000.0);
+            for (uint32_t tb = 0U; tb < BENCH_TIMEBASE_COUNT; tb++)
+            {
+                const bench_result_t *r = &sweep[p][tb];
+
+                fprintf(stderr, " %4u/%-4u %5.3f", r->hits, r->events, accuracy(r));
+            }
+            fprintf(stderr, "\n");
+        }
+    }
+
+    /* The processing chain must not touch the heap */
+    return (0U == total.allocations) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,416 @@
+/******************************************************************************
+ * File Name: filter_bench.c
+ *
+ * Description: Raw count filter benchmark (touchpad_filter_bench). Runs the
+ * demo script with clean, white-noise and impulse-noise raw counts through each
+ * stage of the packed touchpad filters (source/raw_filter.c) and the scalar
+ * reference (raw_filter_ref.c), checks that both give the same raw counts on
+ * every frame, and reports the host time per frame of both and the noise left
+ * after filtering as JSON.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "synth.h"
+#include "raw_filter.h"
+#include "raw_filter_ref.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define BENCH_FRAME_MS              (10U)
+#define BENCH_DEFAULT_ITERATIONS    (20U)
+
+/* Version of the JSON report layout */
+#define BENCH_REPORT_VERSION        (1U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef enum
+{
+    BENCH_NOISE_CLEAN,          /* Synthesizer noise only */
+    BENCH_NOISE_WHITE,          /* White noise close to the noise threshold */
+    BENCH_NOISE_IMPULSE,        /* Single-frame spikes on random sensors */
+    BENCH_NOISE_COUNT
+} bench_noise_t;
+
+typedef struct
+{
+    const char *name;
+    uint32_t stages;
+} bench_stages_t;
+
+typedef struct
+{
+    uint64_t frames;
+    uint64_t packed_ns_best;    /* Best pass of raw_filter_run() */
+    uint64_t ref_ns_best;       /* Best pass of the scalar reference */
+    uint64_t mismatches;        /* Frames where the two differ */
+    double noise_in;            /* RMS raw count error before filtering */
+    double noise_out;           /* RMS error after filtering, against the filtered clean frames */
+} bench_result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static const char *const bench_noise_names[BENCH_NOISE_COUNT] =
+{
+    "clean", "white", "impulse"
+};
+
+static const bench_stages_t bench_stages[] =
+{
+    { "median", RAW_FILTER_MEDIAN },
+    { "iir", RAW_FILTER_IIR },
+    { "spatial", RAW_FILTER_SPATIAL },
+    { "wet", RAW_FILTER_WET_STAGES },
+    { "all", RAW_FILTER_ALL },
+};
+
+#define BENCH_NUM_STAGES            (sizeof(bench_stages) / sizeof(bench_stages[0]))
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static uint32_t bench_rand(uint32_t *state)
+{
+    *state = (*state * 1664525UL) + 1013904223UL;
+    return *state >> 16;
+}
+
+static uint64_t elapsed_ns(const struct timespec *t0, const struct timespec *t1)
+{
+    return ((uint64_t)(t1->tv_sec - t0->tv_sec) * SIM_NS_PER_S) + (uint64_t)t1->tv_nsec - (uint64_t)t0->tv_nsec;
+}
+
+static uint16_t clamp_raw(int32_t raw)
+{
+    if (raw < 0)
+    {
+        return 0U;
+    }
+    return (raw > (int32_t)RAW_FILTER_MAX_RAW) ? (uint16_t)RAW_FILTER_MAX_RAW : (uint16_t)raw;
+}
+
+/* Renders the demo script without noise and with the given noise */
+static uint64_t render(bench_noise_t noise, sim_frame_t **clean, sim_frame_t **noisy)
+{
+    synth_t synth;
+    uint32_t seed = 11U;
+    uint64_t n;
+
+    synth_init_demo(&synth, false);
+    n = synth.length_ms / BENCH_FRAME_MS;
+    *clean = malloc((size_t)n * sizeof(sim_frame_t));
+    *noisy = malloc((size_t)n * sizeof(sim_frame_t));
+    if ((NULL == *clean) || (NULL == *noisy))
+    {
+        return 0U;
+    }
+
+    for (uint64_t i = 0U; i < n; i++)
+    {
+        uint64_t now_ns = i * BENCH_FRAME_MS * SIM_NS_PER_MS;
+
+        synth.noise = 0U;
+        (void)synth_source(&synth, now_ns, &(*clean)[i]);
+        synth.noise = 6U;
+        (void)synth_source(&synth, now_ns, &(*noisy)[i]);
+
+        for (uint32_t s = 0U; s < RAW_FILTER_NUM_SNS; s++)
+        {
+            int32_t raw = (*noisy)[i].tp[s];
+
+            if (BENCH_NOISE_WHITE == noise)
+            {
+                raw += (int32_t)(bench_rand(&seed) % 30U) - 15;
+            }
+            else if ((BENCH_NOISE_IMPULSE == noise) && (0U == (bench_rand(&seed) % 50U)))
+            {
+                raw += ((bench_rand(&seed) & 1U) != 0U) ? 80 : -80;
+            }
+            else
+            {
+                /* Synthesizer noise only */
+            }
+            (*noisy)[i].tp[s] = clamp_raw(raw);
+            (*clean)[i].tp[s] = clamp_raw((*clean)[i].tp[s]);
+        }
+    }
+    return n;
+}
+
+static void pack(uint32_t *packed, const uint16_t *raw)
+{
+    for (uint32_t w = 0U; w < RAW_FILTER_WORDS; w++)
+    {
+        packed[w] = (uint32_t)raw[2U * w] | ((uint32_t)raw[(2U * w) + 1U] << 16U);
+    }
+}
+
+static void run_scenario(uint32_t stages, bench_noise_t noise, uint32_t iterations, bench_result_t *r)
+{
+    sim_frame_t *clean;
+    sim_frame_t *noisy;
+    sim_frame_t *scratch;
+    uint32_t (*packed)[RAW_FILTER_WORDS];
+    raw_filter_state_t state;
+    raw_filter_ref_t ref;
+    raw_filter_ref_t ref_clean;
+    double err_in = 0.0;
+    double err_out = 0.0;
+    uint64_t n = render(noise, &clean, &noisy);
+
+    memset(r, 0, sizeof(*r));
+    packed = malloc((size_t)n * sizeof(*packed));
+    scratch = malloc((size_t)n * sizeof(sim_frame_t));
+    if ((0U == n) || (NULL == packed) || (NULL == scratch))
+    {
+        free(clean);
+        free(noisy);
+        free(packed);
+        free(scratch);
+        return;
+    }
+    r->frames = n;
+
+    /* Correctness and noise: the reference filters the clean and the noisy
+     * frames, the packed filter the noisy ones */
+    memset(&state, 0, sizeof(state));
+    raw_filter_ref_init(&ref);
+    raw_filter_ref_init(&ref_clean);
+    for (uint64_t i = 0U; i < n; i++)
+    {
+        uint16_t expected[RAW_FILTER_NUM_SNS];
+        uint16_t reference[RAW_FILTER_NUM_SNS];
+
+        memcpy(expected, noisy[i].tp, sizeof(expected));
+        memcpy(reference, clean[i].tp, sizeof(reference));
+        for (uint32_t s = 0U; s < RAW_FILTER_NUM_SNS; s++)
+        {
+            double e = (double)expected[s] - (double)reference[s];
+
+            err_in += e * e;
+        }
+
+        pack(packed[i], noisy[i].tp);
+        raw_filter_run(&state, packed[i], stages);
+        raw_filter_ref_run(&ref, expected, stages);
+        raw_filter_ref_run(&ref_clean, reference, stages);
+
+        for (uint32_t s = 0U; s < RAW_FILTER_NUM_SNS; s++)
+        {
+            double e = (double)expected[s] - (double)reference[s];
+
+            err_out += e * e;
+        }
+        for (uint32_t s = 0U; s < RAW_FILTER_NUM_SNS; s++)
+        {
+            if ((uint16_t)(packed[i][s / 2U] >> (16U * (s % 2U))) != expected[s])
+            {
+                r->mismatches++;
+                break;
+            }
+        }
+    }
+    r->noise_in = sqrt(err_in / (double)(n * RAW_FILTER_NUM_SNS));
+    r->noise_out = sqrt(err_out / (double)(n * RAW_FILTER_NUM_SNS));
+
+    /* Timing: the best of the passes over the pre-packed frames */
+    r->packed_ns_best = UINT64_MAX;
+    r->ref_ns_best = UINT64_MAX;
+    for (uint32_t it = 0U; it < iterations; it++)
+    {
+        struct timespec t0;
+        struct timespec t1;
+        uint64_t ns;
+
+        for (uint64_t i = 0U; i < n; i++)
+        {
+            pack(packed[i], noisy[i].tp);
+        }
+        memset(&state, 0, sizeof(state));
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (uint64_t i = 0U; i < n; i++)
+        {
+            raw_filter_run(&state, packed[i], stages);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns = elapsed_ns(&t0, &t1);
+        r->packed_ns_best = (ns < r->packed_ns_best) ? ns : r->packed_ns_best;
+
+        /* The reference filters in place */
+        memcpy(scratch, noisy, (size_t)n * sizeof(sim_frame_t));
+        raw_filter_ref_init(&ref);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (uint64_t i = 0U; i < n; i++)
+        {
+            raw_filter_ref_run(&ref, scratch[i].tp, stages);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ns = elapsed_ns(&t0, &t1);
+        r->ref_ns_best = (ns < r->ref_ns_best) ? ns : r->ref_ns_best;
+    }
+
+    free(scratch);
+    free(packed);
+    free(clean);
+    free(noisy);
+}
+
+static void print_result(FILE *out, const char *stages, const char *noise, const bench_result_t *r, bool last)
+{
+    fprintf(out,
+            "    { \"stages\": \"%s\", \"noise\": \"%s\", \"frames\": %llu, "
+            "\"packed_ns_per_frame\": %.1f, \"reference_ns_per_frame\": %.1f, \"mismatches\": %llu, "
+            "\"noise_rms_in\": %.2f, \"noise_rms_out\": %.2f }%s\n",
+            stages, noise, (unsigned long long)r->frames,
+            (double)r->packed_ns_best / (double)r->frames, (double)r->ref_ns_best / (double)r->frames,
+            (unsigned long long)r->mismatches, r->noise_in, r->noise_out, last ? "" : ",");
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -n N      timed passes per scenario, the best is reported (default %u)\n"
+            "  -o FILE   write the JSON report to FILE instead of standard output\n"
+            "  -q        do not print the summary table on standard error\n",
+            prog, BENCH_DEFAULT_ITERATIONS);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the filter benchmark.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    bench_result_t results[BENCH_NUM_STAGES][BENCH_NOISE_COUNT];
+    uint32_t iterations = BENCH_DEFAULT_ITERATIONS;
+    const char *out_path = NULL;
+    bool quiet = false;
+    FILE *out = stdout;
+    uint64_t mismatches = 0U;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "n:o:qh")))
+    {
+        switch (opt)
+        {
+        case 'n': iterations = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'o': out_path = optarg; break;
+        case 'q': quiet = true; break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+    if ((optind != argc) || (0U == iterations))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for (uint32_t s = 0U; s < BENCH_NUM_STAGES; s++)
+    {
+        for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+        {
+            run_scenario(bench_stages[s].stages, (bench_noise_t)n, iterations, &results[s][n]);
+            mismatches += results[s][n].mismatches;
+        }
+    }
+
+    if (NULL != out_path)
+    {
+        out = fopen(out_path, "w");
+        if (NULL == out)
+        {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n  \"benchmark\": \"touchpad_raw_filter\",\n  \"version\": %u,\n", BENCH_REPORT_VERSION);
+    fprintf(out, "  \"frame_ms\": %u,\n  \"iterations\": %u,\n  \"sensors\": %u,\n  \"packed_words\": %u,\n",
+            BENCH_FRAME_MS, iterations, RAW_FILTER_NUM_SNS, RAW_FILTER_WORDS);
+    fprintf(out, "  \"scenarios\": [\n");
+    for (uint32_t s = 0U; s < BENCH_NUM_STAGES; s++)
+    {
+        for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+        {
+            print_result(out, bench_stages[s].name, bench_noise_names[n], &results[s][n],
+                         ((s + 1U) == BENCH_NUM_STAGES) && ((n + 1U) == BENCH_NOISE_COUNT));
+        }
+    }
+    fprintf(out, "  ]\n}\n");
+    if (stdout != out)
+    {
+        fclose(out);
+    }
+
+    if (!quiet)
+    {
+        fprintf(stderr, "%-8s %-8s %10s %10s %8s %9s %9s\n",
+                "stages", "noise", "packed ns", "scalar ns", "errors", "rms in", "rms out");
+        for (uint32_t s = 0U; s < BENCH_NUM_STAGES; s++)
+        {
+            for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+            {
+                const bench_result_t *r = &results[s][n];
+
+                fprintf(stderr, "%-8s %-8s %10.1f %10.1f %8llu %9.2f %9.2f\n",
+                        bench_stages[s].name, bench_noise_names[n],
+                        (double)r->packed_ns_best / (double)r->frames, (double)r->ref_ns_best / (double)r->frames,
+                        (unsigned long long)r->mismatches, r->noise_in, r->noise_out);
+            }
+        }
+    }
+
+    /* The packed filters must match the reference exactly */
+    return (0U == mismatches) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,188 @@
+/******************************************************************************
+ * File Name: gesture_log_decode.c
+ *
+ * Description: Streaming decoder of the binary gesture log. A record is
+ * accepted only when its checksum matches; otherwise its sync byte is passed
+ * through as text and decoding restarts at the next byte, so a corrupted or
+ * truncated record costs at most that record.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "gesture_log_decode.h"
+#include "gesture_names.h"
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8U));
+}
+
+static bool record_valid(const uint8_t record[GESTURE_LOG_RECORD_SIZE])
+{
+    uint8_t check = 0U;
+
+    for (uint32_t i = 0U; i < GESTURE_LOG_RECORD_SIZE; i++)
+    {
+        check ^= record[i];
+    }
+    return (0U == check);
+}
+
+static void push_byte(gesture_log_decoder_t *dec, uint8_t byte)
+{
+    if (0U == dec->fill)
+    {
+        if (GESTURE_LOG_SYNC == byte)
+        {
+            dec->record[dec->fill++] = byte;
+        }
+        else if (NULL != dec->text)
+        {
+            dec->text(dec->arg, byte);
+        }
+        return;
+    }
+
+    dec->record[dec->fill++] = byte;
+    if (GESTURE_LOG_RECORD_SIZE != dec->fill)
+    {
+        return;
+    }
+
+    dec->fill = 0U;
+    if (record_valid(dec->record))
+    {
+        gesture_log_event_t event;
+
+        event.gesture = (uint32_t)dec->record[1] | ((uint32_t)dec->record[2] << 8U) |
+                        ((uint32_t)dec->record[3] << 16U) | ((uint32_t)dec->record[4] << 24U);
+        event.timestamp = get_u16(&dec->record[5]);
+        event.x = get_u16(&dec->record[7]);
+        event.y = get_u16(&dec->record[9]);
+        dec->events++;
+        if (NULL != dec->event)
+        {
+            dec->event(dec->arg, &event);
+        }
+    }
+    else
+    {
+        uint8_t rest[GESTURE_LOG_RECORD_SIZE - 1U];
+
+        /* Not a record: emit the sync byte and rescan what followed it */
+        dec->errors++;
+        memcpy(rest, &dec->record[1], sizeof(rest));
+        if (NULL != dec->text)
+        {
+            dec->text(dec->arg, dec->record[0]);
+        }
+        for (uint32_t i = 0U; i < sizeof(rest); i++)
+        {
+            push_byte(dec, rest[i]);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Decoder
+ ******************************************************************************/
+void gesture_log_decoder_init(gesture_log_decoder_t *dec, gesture_log_text_fn text, gesture_log_event_fn event,
+                              void *arg)
+{
+    memset(dec, 0, sizeof(*dec));
+    dec->text = text;
+    dec->event = event;
+    dec->arg = arg;
+}
+
+void gesture_log_decoder_push(gesture_log_decoder_t *dec, uint8_t byte)
+{
+    push_byte(dec, byte);
+}
+
+void gesture_log_decoder_flush(gesture_log_decoder_t *dec)
+{
+    /* A record cut off by the end of the stream is passed through as text */
+    if ((NULL != dec->text) && (0U != dec->fill))
+    {
+        for (uint32_t i = 0U; i < dec->fill; i++)
+        {
+            dec->text(dec->arg, dec->record[i]);
+        }
+    }
+    dec->fill = 0U;
+}
+
+int gesture_log_format(char *buf, size_t size, const gesture_log_event_t *event, bool verbose)
+{
+    const char *name = gesture_name(event->gesture);
+    int n;
+
+    if (NULL != name)
+    {
+        n = snprintf(buf, size, "%s ", name);
+    }
+    else
+    {
+        n = snprintf(buf, size, "%lx", (unsigned long)event->gesture);
+    }
+
+    if (verbose && (n >= 0) && ((size_t)n < size))
+    {
+        /* A named gesture already ends with a space */
+        int m = snprintf(&buf[n], size - (size_t)n, (NULL != name) ? "ts=%u" : " ts=%u", event->timestamp);
+
+        if (m >= 0)
+        {
+            n += m;
+        }
+        if ((GESTURE_LOG_NO_POSITION != event->x) && (n >= 0) && ((size_t)n < size))
+        {
+            m = snprintf(&buf[n], size - (size_t)n, " x=%u y=%u", event->x, event->y);
+            if (m >= 0)
+            {
+                n += m;
+            }
+        }
+    }
+    return n;
+}
+
+/* [] END OF FILE */
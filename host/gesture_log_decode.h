@@ -0,0 +1,94 @@
+/******************************************************************************
+ * File Name: gesture_log_decode.h
+ *
+ * Description: Streaming decoder of the binary gesture log sent by the firmware
+ * on the debug UART. Bytes outside a record, such as the boot message, are
+ * passed through unchanged, so the decoder can sit directly on the serial
+ * stream.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef GESTURE_LOG_DECODE_H
+#define GESTURE_LOG_DECODE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "gesture_log.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t gesture;
+    uint16_t timestamp;         /* Low 16 bits of the gesture timestamp */
+    uint16_t x;
+    uint16_t y;
+} gesture_log_event_t;
+
+/* Receives a byte that is not part of a record */
+typedef void (*gesture_log_text_fn)(void *arg, uint8_t byte);
+
+/* Receives a record with a valid checksum */
+typedef void (*gesture_log_event_fn)(void *arg, const gesture_log_event_t *event);
+
+typedef struct
+{
+    uint8_t record[GESTURE_LOG_RECORD_SIZE];
+    uint32_t fill;
+    gesture_log_text_fn text;
+    gesture_log_event_fn event;
+    void *arg;
+    uint32_t events;            /* Records decoded */
+    uint32_t errors;            /* Records rejected by the checksum */
+} gesture_log_decoder_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void gesture_log_decoder_init(gesture_log_decoder_t *dec, gesture_log_text_fn text, gesture_log_event_fn event,
+                              void *arg);
+void gesture_log_decoder_push(gesture_log_decoder_t *dec, uint8_t byte);
+void gesture_log_decoder_flush(gesture_log_decoder_t *dec);
+
+/* Formats an event the way the firmware used to print it, with timestamp and
+ * position appended when verbose. Returns the snprintf() result. */
+int gesture_log_format(char *buf, size_t size, const gesture_log_event_t *event, bool verbose);
+
+#endif /* GESTURE_LOG_DECODE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * File Name: gesture_names.c
+ *
+ * Description: Names of the gestures reported by the application, as printed by
+ * the firmware before the gesture log was made binary.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stddef.h>
+#include "gesture_names.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t gesture;
+    const char *name;
+} gesture_name_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Gestures handled by the application, see the switch in main() */
+static const gesture_name_t gesture_names[] =
+{
+    { 0x00000001UL, "Single Click" },
+    { 0x00000002UL, "Double Click" },
+    { 0x00020010UL, "Scroll right" },
+    { 0x00030010UL, "Scroll left" },
+    { 0x00000010UL, "Scroll up" },
+    { 0x00010010UL, "Scroll Down" },
+    { 0x00000080UL, "flick up" },
+    { 0x01000080UL, "flick down" },
+    { 0x02000080UL, "flick right" },
+    { 0x03000080UL, "flick left" },
+    { 0x00000200UL, "Two Finger Zoom In" },
+    { 0x00800200UL, "Two Finger Zoom OUT" },
+    { 0x00000008UL, "Two Finger Click" },
+};
+
+const char *gesture_name(uint32_t gesture)
+{
+    for (uint32_t i = 0U; i < (sizeof(gesture_names) / sizeof(gesture_names[0])); i++)
+    {
+        if (gesture_names[i].gesture == gesture)
+        {
+            return gesture_names[i].name;
+        }
+    }
+    return NULL;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * File Name: logdec_main.c
+ *
+ * Description: Gesture log decoder (touchpad_logdec). Reads the raw debug UART
+ * stream of the application, for example a serial terminal capture, and prints
+ * it as text: gesture records become the lines the firmware used to print, all
+ * other bytes are copied unchanged.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "gesture_log_decode.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Append timestamp and position to decoded gestures */
+static bool verbose = false;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static void print_text(void *arg, uint8_t byte)
+{
+    fputc(byte, (FILE *)arg);
+}
+
+static void print_event(void *arg, const gesture_log_event_t *event)
+{
+    char line[96];
+
+    (void)gesture_log_format(line, sizeof(line), event, verbose);
+    fprintf((FILE *)arg, "%s\r\n", line);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options] [LOG]\n"
+            "  LOG       raw UART log, standard input if omitted\n"
+            "  -v        print timestamp and position of every gesture\n",
+            prog);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the gesture log decoder.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    gesture_log_decoder_t decoder;
+    FILE *in = stdin;
+    int opt;
+    int c;
+
+    while (-1 != (opt = getopt(argc, argv, "vh")))
+    {
+        switch (opt)
+        {
+        case 'v': verbose = true; break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+    if ((optind + 1) < argc)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (optind < argc)
+    {
+        in = fopen(argv[optind], "rb");
+        if (NULL == in)
+        {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    gesture_log_decoder_init(&decoder, print_text, print_event, stdout);
+    while (EOF != (c = fgetc(in)))
+    {
+        gesture_log_decoder_push(&decoder, (uint8_t)c);
+    }
+    gesture_log_decoder_flush(&decoder);
+
+    fflush(stdout);
+    fprintf(stderr, "gestures            : %u (%u bad records)\n", decoder.events, decoder.errors);
+
+    if (stdin != in)
+    {
+        fclose(in);
+    }
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,488 @@
+/******************************************************************************
+ * File Name: noise_bench.c
+ *
+ * Description: Conducted noise benchmark (touchpad_noise_bench). Runs taps on
+ * the touchpad with charger noise coupled into the sense clock through the
+ * touchpad processing scanned at a single sense clock, with fixed multi-
+ * frequency scanning, and with the noise-triggered hopping of
+ * source/noise_hop.c, and reports the modelled scan time per frame and the
+ * false touch rate of each as JSON.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+#include "synth.h"
+#include "noise_hop.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Touchpad scan period of the active power level */
+#define BENCH_FRAME_MS              (10U)
+
+#define BENCH_LENGTH_MS             (20000U)
+
+/* Taps: idle lead time, start-to-start time and contact time */
+#define BENCH_LEAD_MS               (500U)
+#define BENCH_TAP_PITCH_MS          (1000U)
+#define BENCH_TAP_MS                (150U)
+
+/* Frames after a lift-off that count neither as touched nor as idle */
+#define BENCH_GUARD_FRAMES          (2U)
+
+/* The charger is plugged in for the middle half of the run. The sweep
+ * scenario moves the noise to the first alternate divider halfway. */
+#define BENCH_NOISE_START_MS        (5000U)
+#define BENCH_NOISE_END_MS          (15000U)
+#define BENCH_SWEEP_MS              (10000U)
+
+/* Peak noise on a coupled divider, above the finger threshold plus the
+ * hysteresis */
+#define BENCH_CHARGER_COUNTS        (150)
+
+/* Distance in dividers over which the coupling fades out */
+#define BENCH_COUPLING_WIDTH        (3)
+
+/* Layout version of the JSON report */
+#define BENCH_REPORT_VERSION        (1U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef enum
+{
+    BENCH_MODE_SINGLE,          /* Configured sense clock only */
+    BENCH_MODE_MFS,             /* Every slot at the three MFS clocks, median */
+    BENCH_MODE_ADAPTIVE,        /* Configured sense clock, hopping on noise */
+    BENCH_MODE_COUNT
+} bench_mode_t;
+
+typedef enum
+{
+    BENCH_NOISE_CLEAN,          /* Synthesizer noise only */
+    BENCH_NOISE_CHARGER,        /* Charger noise on the configured divider */
+    BENCH_NOISE_SWEEP,          /* Charger noise moving to the first alternate divider */
+    BENCH_NOISE_BROADBAND,      /* Charger noise on every divider */
+    BENCH_NOISE_COUNT
+} bench_noise_t;
+
+typedef struct
+{
+    uint64_t frames;
+    uint64_t scan_ns;           /* Modelled scan and calibration time */
+    uint64_t max_frame_ns;      /* Longest frame of scan and calibration */
+    uint32_t idle_frames;       /* Frames without a finger */
+    uint32_t false_frames;      /* Idle frames reporting a touch */
+    uint32_t touch_frames;      /* Frames with a finger */
+    uint32_t detected_frames;   /* Frames with a finger reporting a touch */
+    uint32_t moves;             /* Sense clock changes */
+} bench_result_t;
+
+/* Scenario being run, read by the source of the calibration scans */
+typedef struct
+{
+    synth_t synth;
+    bench_noise_t noise;
+    bool mfs;
+    uint32_t seed;
+    uint32_t t_ms;
+} bench_state_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static const char *const bench_mode_names[BENCH_MODE_COUNT] =
+{
+    "single", "mfs", "adaptive"
+};
+
+static const char *const bench_noise_names[BENCH_NOISE_COUNT] =
+{
+    "clean", "charger", "sweep", "broadband"
+};
+
+static const uint32_t mfs_offset[NOISE_HOP_CHANNELS] = { 0U, NOISE_HOP_OFFSET_F1, NOISE_HOP_OFFSET_F2 };
+
+static synth_stroke_t taps[BENCH_LENGTH_MS / BENCH_TAP_PITCH_MS];
+static uint32_t num_taps = 0U;
+
+/* Configured touchpad divider */
+static uint32_t home_clk = 0U;
+
+/* Stage profile the hop calibrations are recorded in */
+static stage_profile_buffer_t profile_buffer;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static uint32_t bench_rand(uint32_t *state)
+{
+    *state = (*state * 1664525UL) + 1013904223UL;
+    return *state >> 16;
+}
+
+/* Places the taps at random positions away from the edges */
+static void build_taps(void)
+{
+    uint32_t seed = 5U;
+
+    num_taps = 0U;
+    for (uint32_t t = BENCH_LEAD_MS; (t + BENCH_TAP_MS) < BENCH_LENGTH_MS; t += BENCH_TAP_PITCH_MS)
+    {
+        int16_t x = (int16_t)(20U + (bench_rand(&seed) % 121U));
+        int16_t y = (int16_t)(15U + (bench_rand(&seed) % 71U));
+
+        taps[num_taps++] = (synth_stroke_t){ t, BENCH_TAP_MS, 1U, x, y, x, y, 0, 0 };
+    }
+}
+
+/* Frames since the last lift-off, UINT32_MAX while a finger is down */
+static uint32_t frames_since_lift(uint32_t t_ms)
+{
+    uint32_t since = UINT32_MAX - 1U;
+
+    for (uint32_t i = 0U; i < num_taps; i++)
+    {
+        uint32_t end = taps[i].start_ms + taps[i].duration_ms;
+
+        if ((t_ms >= taps[i].start_ms) && (t_ms < end))
+        {
+            return UINT32_MAX;
+        }
+        if (t_ms >= end)
+        {
+            since = (t_ms - end) / BENCH_FRAME_MS;
+        }
+    }
+    return since;
+}
+
+/* Divider the charger couples into, 0 - every divider, UINT32_MAX - none */
+static uint32_t noise_divider(bench_noise_t noise, uint32_t t_ms)
+{
+    if ((BENCH_NOISE_CLEAN == noise) || (t_ms < BENCH_NOISE_START_MS) || (t_ms >= BENCH_NOISE_END_MS))
+    {
+        return UINT32_MAX;
+    }
+    switch (noise)
+    {
+    case BENCH_NOISE_SWEEP:
+        return (t_ms < BENCH_SWEEP_MS) ? home_clk : (home_clk + NOISE_HOP_OFFSET_F1);
+    case BENCH_NOISE_BROADBAND:
+        return 0U;
+    default:
+        return home_clk;
+    }
+}
+
+/* Charger noise of one conversion at a sense clock divider */
+static int32_t charger_noise(uint32_t divider, uint32_t clk, uint32_t *seed)
+{
+    int32_t peak = BENCH_CHARGER_COUNTS;
+    int32_t distance;
+
+    if (UINT32_MAX == divider)
+    {
+        return 0;
+    }
+    if (0U != divider)
+    {
+        distance = abs((int32_t)clk - (int32_t)divider);
+        if (distance >= BENCH_COUPLING_WIDTH)
+        {
+            return 0;
+        }
+        peak = (peak * (BENCH_COUPLING_WIDTH - distance)) / BENCH_COUPLING_WIDTH;
+    }
+    return (int32_t)(bench_rand(seed) % (uint32_t)((2 * peak) + 1)) - peak;
+}
+
+static int32_t median_of_3(int32_t a, int32_t b, int32_t c)
+{
+    int32_t low = (a < b) ? a : b;
+    int32_t high = (a < b) ? b : a;
+
+    if (c < high)
+    {
+        high = c;
+    }
+    return (low > high) ? low : high;
+}
+
+/* sim_source_fn: the touchpad at the current bench time, scanned at the
+ * current dividers of the widget */
+static bool bench_source(void *arg, uint64_t now_ns, sim_frame_t *frame)
+{
+    bench_state_t *state = (bench_state_t *)arg;
+    const cy_stc_capsense_widget_context_t *wdc =
+        cy_capsense_context.ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrWdContext;
+    uint32_t divider = noise_divider(state->noise, state->t_ms);
+
+    (void)now_ns;
+    (void)synth_source(&state->synth, (uint64_t)state->t_ms * SIM_NS_PER_MS, frame);
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+    {
+        uint32_t clk = (i < CY_CAPSENSE_TOUCHPAD0_NUM_COLS) ? wdc->snsClk : wdc->rowSnsClk;
+        int32_t n;
+
+        if (state->mfs)
+        {
+            n = median_of_3(charger_noise(divider, clk + mfs_offset[0], &state->seed),
+                            charger_noise(divider, clk + mfs_offset[1], &state->seed),
+                            charger_noise(divider, clk + mfs_offset[2], &state->seed));
+        }
+        else
+        {
+            n = charger_noise(divider, clk, &state->seed);
+        }
+        frame->tp[i] = (uint16_t)((int32_t)frame->tp[i] + n);
+    }
+    return true;
+}
+
+/* Runs the scenario in one mode, in the order of the main loop */
+static void run(bench_mode_t mode, bench_noise_t noise, bench_result_t *result)
+{
+    const cy_stc_capsense_widget_config_t *wd = &cy_capsense_context.ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID];
+    bench_state_t state;
+    sim_frame_t frame;
+
+    memset(result, 0, sizeof(*result));
+    memset(&state, 0, sizeof(state));
+    state.synth.strokes = taps;
+    state.synth.num_strokes = num_taps;
+    state.synth.length_ms = BENCH_LENGTH_MS;
+    state.synth.noise = 6U;
+    state.synth.seed = 1U;
+    state.noise = noise;
+    state.mfs = (BENCH_MODE_MFS == mode);
+    state.seed = 17U;
+
+    sim_reset(NULL);
+    sim_set_source(bench_source, &state);
+    (void)Cy_CapSense_Init(&cy_capsense_context);
+    home_clk = wd->ptrWdContext->snsClk;
+    (void)bench_source(&state, 0U, &frame);
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+    {
+        wd->ptrSnsContext[i].raw = frame.tp[i];
+    }
+    Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+    noise_hop_init(&cy_capsense_context);
+    stage_profile_init(&profile_buffer);
+
+    for (state.t_ms = 0U; state.t_ms < BENCH_LENGTH_MS; state.t_ms += BENCH_FRAME_MS)
+    {
+        uint64_t frame_ns = 0U;
+        uint32_t since_lift;
+        bool touched;
+
+        if (BENCH_MODE_ADAPTIVE == mode)
+        {
+            uint64_t active = sim_get_stats()->active_ns;
+
+            (void)noise_hop_apply();
+            frame_ns = sim_get_stats()->active_ns - active;
+        }
+
+        (void)bench_source(&state, 0U, &frame);
+        for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+        {
+            wd->ptrSnsContext[i].raw = frame.tp[i];
+        }
+        frame_ns += sim_capsense_scan_ns(&cy_capsense_context, wd->firstSlotId, wd->numSlots) *
+                    (state.mfs ? NOISE_HOP_CHANNELS : 1U);
+
+        if (BENCH_MODE_ADAPTIVE == mode)
+        {
+            (void)noise_hop_check();
+        }
+        (void)Cy_CapSense_ProcessWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+        touched = (0U != Cy_CapSense_GetTouchInfo(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context)->numPosition);
+
+        result->frames++;
+        result->scan_ns += frame_ns;
+        if (frame_ns > result->max_frame_ns)
+        {
+            result->max_frame_ns = frame_ns;
+        }
+        since_lift = frames_since_lift(state.t_ms);
+        if (UINT32_MAX == since_lift)
+        {
+            result->touch_frames++;
+            result->detected_frames += touched ? 1U : 0U;
+        }
+        else if (since_lift >= BENCH_GUARD_FRAMES)
+        {
+            result->idle_frames++;
+            result->false_frames += touched ? 1U : 0U;
+        }
+        else
+        {
+            /* Lift-off in progress */
+        }
+    }
+    if (BENCH_MODE_ADAPTIVE == mode)
+    {
+        result->moves = noise_hop_get_stats()->hops + noise_hop_get_stats()->returns;
+    }
+}
+
+static double ratio(uint32_t num, uint32_t den)
+{
+    return (0U != den) ? ((double)num / (double)den) : 0.0;
+}
+
+static void print_result(FILE *out, const char *mode, const char *noise, const bench_result_t *r, bool last)
+{
+    fprintf(out,
+            "    { \"mode\": \"%s\", \"noise\": \"%s\", \"frames\": %llu, "
+            "\"scan_us_per_frame\": %.1f, \"max_frame_us\": %.1f, \"idle_frames\": %u, \"false_frames\": %u, "
+            "\"false_touch_rate\": %.4f, \"touch_frames\": %u, \"detected_frames\": %u, "
+            "\"detection_rate\": %.4f, \"moves\": %u }%s\n",
+            mode, noise, (unsigned long long)r->frames,
+            (double)r->scan_ns / 1000.0 / (double)r->frames, (double)r->max_frame_ns / 1000.0,
+            r->idle_frames, r->false_frames, ratio(r->false_frames, r->idle_frames),
+            r->touch_frames, r->detected_frames, ratio(r->detected_frames, r->touch_frames), r->moves,
+            last ? "" : ",");
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -o FILE   write the JSON report to FILE (default: standard output)\n"
+            "  -q        do not print the summary table on standard error\n",
+            prog);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the noise benchmark.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    bench_result_t results[BENCH_NOISE_COUNT][BENCH_MODE_COUNT];
+    const char *out_path = NULL;
+    bool quiet = false;
+    FILE *out = stdout;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "o:qh")))
+    {
+        switch (opt)
+        {
+        case 'o': out_path = optarg; break;
+        case 'q': quiet = true; break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+    if (optind != argc)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    build_taps();
+    for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+    {
+        for (uint32_t m = 0U; m < BENCH_MODE_COUNT; m++)
+        {
+            run((bench_mode_t)m, (bench_noise_t)n, &results[n][m]);
+        }
+    }
+
+    if (NULL != out_path)
+    {
+        out = fopen(out_path, "w");
+        if (NULL == out)
+        {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n  \"benchmark\": \"touchpad_noise\",\n  \"version\": %u,\n", BENCH_REPORT_VERSION);
+    fprintf(out, "  \"frame_ms\": %u,\n  \"length_ms\": %u,\n  \"noise_ms\": [%u, %u],\n",
+            BENCH_FRAME_MS, BENCH_LENGTH_MS, BENCH_NOISE_START_MS, BENCH_NOISE_END_MS);
+    fprintf(out, "  \"scenarios\": [\n");
+    for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+    {
+        for (uint32_t m = 0U; m < BENCH_MODE_COUNT; m++)
+        {
+            print_result(out, bench_mode_names[m], bench_noise_names[n], &results[n][m],
+                         ((n + 1U) == BENCH_NOISE_COUNT) && ((m + 1U) == BENCH_MODE_COUNT));
+        }
+    }
+    fprintf(out, "  ]\n}\n");
+    if (stdout != out)
+    {
+        fclose(out);
+    }
+
+    if (!quiet)
+    {
+        fprintf(stderr, "%-10s %-9s %9s %9s %7s %7s %6s\n",
+                "noise", "mode", "scan us", "max us", "false", "detect", "moves");
+        for (uint32_t n = 0U; n < BENCH_NOISE_COUNT; n++)
+        {
+            for (uint32_t m = 0U; m < BENCH_MODE_COUNT; m++)
+            {
+                const bench_result_t *r = &results[n][m];
+
+                fprintf(stderr, "%-10s %-9s %9.1f %9.1f %7.4f %7.4f %6u\n",
+                        bench_noise_names[n], bench_mode_names[m], (double)r->scan_ns / 1000.0 / (double)r->frames,
+                        (double)r->max_frame_ns / 1000.0, ratio(r->false_frames, r->idle_frames),
+                        ratio(r->detected_frames, r->touch_frames), r->moves);
+            }
+        }
+    }
+
+    /* Without noise, the adaptive mode must stay on the configured clock */
+    return (0U == results[BENCH_NOISE_CLEAN][BENCH_MODE_ADAPTIVE].moves) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,724 @@
+/******************************************************************************
+ * File Name: policy_main.c
+ *
+ * Description: Power policy comparison tool (touchpad_policy). Runs the power
+ * state machine of source/power_policy.c against the activity in a raw-count
+ * trace or the built-in demo script, once for every policy given, and estimates
+ * average current and response latency of each from a simple per-wake cost
+ * model. The time LED1 is lit, toggled by the clicks in the activity, sleeps
+ * in CPU Sleep rather than Deep Sleep with LED_CONTROL_SLEEP_WHILE_LIT set.
+ * Needs neither hardware nor the full device simulator, so a trace of many
+ * hours compares a handful of policies in a fraction of a second.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+#include "synth.h"
+#include "trace.h"
+#include "power_policy.h"
+#include "power_levels.h"
+#include "led_control.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define POLICY_MAX                  (8U)
+#define POLICY_NAME_MAX             (24U)
+
+/* Activity of one millisecond of the trace */
+#define ACTIVITY_PROXIMITY          (0x1U)
+#define ACTIVITY_TOUCH              (0x2U)
+#define ACTIVITY_LIT                (0x4U)
+#define ACTIVITY_TWO_FINGERS        (0x8U)
+
+/* Gesture timestamp tick of the CAPSENSE gesture timeouts */
+#define GESTURE_TICK_MS             (10U)
+
+/* Default cost model. Wake costs are the active time per wake-up of the full
+ * simulator (touchpad_sim) for each scanned widget; the currents are
+ * datasheet-level estimates of the PSoC 4100S Max at 48 MHz. */
+#define DEFAULT_ACTIVE_UA           (3000.0)
+#define DEFAULT_SLEEP_UA            (2.5)
+#define DEFAULT_CPU_SLEEP_UA        (1300.0)
+#define DEFAULT_PROX_WAKE_US        (3200U)
+#define DEFAULT_TOUCH_WAKE_US       (3400U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    char name[POLICY_NAME_MAX];
+    power_level_config_t levels[POWER_POLICY_MAX_LEVELS];
+    uint32_t num_levels;
+    uint32_t initial_level;
+} policy_t;
+
+/* One period of continuous proximity or touch activity */
+typedef struct
+{
+    uint32_t start_ms;
+    uint32_t end_ms;
+} span_t;
+
+typedef struct
+{
+    span_t *spans;
+    uint32_t count;
+    uint32_t next;              /* First span not yet resolved */
+    uint32_t hits;
+    uint32_t missed;
+    uint64_t total_ms;
+    uint32_t max_ms;
+} latency_t;
+
+typedef struct
+{
+    double active_ua;
+    double sleep_ua;
+    double cpu_sleep_ua;        /* CPU Sleep, with the PWM clocked */
+    bool sleep_while_lit;       /* LED_CONTROL_SLEEP_WHILE_LIT */
+    uint32_t prox_wake_us;
+    uint32_t touch_wake_us;
+    uint32_t debounce;
+} cost_model_t;
+
+typedef struct
+{
+    uint64_t active_us;
+    uint64_t lit_sleep_us;      /* Sleep time spent in CPU Sleep for LED1 */
+    uint32_t wakes;
+    uint32_t transitions;
+    uint64_t level_us[POWER_POLICY_MAX_LEVELS];
+    latency_t ready;            /* Hand arrival to touchpad scanning */
+    latency_t touch;            /* Finger down to first touchpad frame seeing it */
+} result_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static uint8_t *activity;
+static uint32_t activity_ms;
+
+/* Strongest column and row of the touch, (row << 4) | column */
+static uint8_t *peak;
+
+/*******************************************************************************
+ * Activity
+ ******************************************************************************/
+/* Index of the strongest of count sensors and the number of separate runs of
+ * sensors above the finger threshold, one per finger */
+static uint32_t find_peak(const uint16_t *raw, const uint16_t *base, uint32_t count, int32_t threshold,
+                          uint32_t *fingers)
+{
+    int32_t best = 0;
+    uint32_t index = 0U;
+    bool touched = false;
+
+    *fingers = 0U;
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        int32_t diff = (int32_t)raw[i] - (int32_t)base[i];
+
+        if (diff > best)
+        {
+            best = diff;
+            index = i;
+        }
+        if ((diff >= threshold) && !touched)
+        {
+            (*fingers)++;
+        }
+        touched = (diff >= threshold);
+    }
+    return index;
+}
+
+/* Samples the source once per millisecond and classifies every sample
+ * against the first one with the proximity and finger thresholds of the
+ * CAPSENSE configuration */
+static bool load_activity(sim_source_fn source, void *arg, uint32_t max_ms)
+{
+    const cy_stc_capsense_widget_context_t *wdc = cy_capsense_context.ptrWdContext;
+    sim_frame_t base;
+    sim_frame_t frame;
+    int32_t finger_th = (int32_t)wdc[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].fingerTh;
+    uint32_t size = 0U;
+
+    if (!source(arg, 0U, &base))
+    {
+        return false;
+    }
+
+    for (uint32_t t = 0U; ((0U == max_ms) || (t < max_ms)) && source(arg, t * SIM_NS_PER_MS, &frame); t++)
+    {
+        uint8_t flags = 0U;
+        uint32_t fingers;
+        uint32_t row_fingers;
+        uint32_t column;
+        uint32_t row;
+
+        if (t >= size)
+        {
+            size = (0U == size) ? 65536U : (size * 2U);
+            activity = realloc(activity, size);
+            peak = realloc(peak, size);
+            if ((NULL == activity) || (NULL == peak))
+            {
+                return false;
+            }
+        }
+
+        if (((int32_t)frame.prox - (int32_t)base.prox) >= (int32_t)wdc[CY_CAPSENSE_PROXIMITY0_WDGT_ID].proxTh)
+        {
+            flags |= ACTIVITY_PROXIMITY;
+        }
+        column = find_peak(frame.tp, base.tp, CY_CAPSENSE_TOUCHPAD0_NUM_COLS, finger_th, &fingers);
+        row = find_peak(&frame.tp[CY_CAPSENSE_TOUCHPAD0_NUM_COLS], &base.tp[CY_CAPSENSE_TOUCHPAD0_NUM_COLS],
+                        CY_CAPSENSE_TOUCHPAD0_NUM_ROWS, finger_th, &row_fingers);
+        if (0U != (fingers | row_fingers))
+        {
+            flags |= ACTIVITY_TOUCH;
+        }
+        if ((fingers > 1U) || (row_fingers > 1U))
+        {
+            flags |= ACTIVITY_TWO_FINGERS;
+        }
+        activity[t] = flags;
+        peak[t] = (uint8_t)((row << 4U) | column);
+        activity_ms = t + 1U;
+    }
+    return (0U != activity_ms);
+}
+
+static uint32_t find_spans(uint8_t mask, span_t **spans)
+{
+    uint32_t count = 0U;
+    uint32_t size = 0U;
+    bool active = false;
+
+    *spans = NULL;
+    for (uint32_t t = 0U; t <= activity_ms; t++)
+    {
+        bool now = (t < activity_ms) && (0U != (activity[t] & mask));
+
+        if (now && !active)
+        {
+            if (count == size)
+            {
+                size = (0U == size) ? 64U : (size * 2U);
+                *spans = realloc(*spans, size * sizeof(span_t));
+                if (NULL == *spans)
+                {
+                    return 0U;
+                }
+            }
+            (*spans)[count].start_ms = t;
+        }
+        else if (!now && active)
+        {
+            (*spans)[count].end_ms = t;
+            count++;
+        }
+        else
+        {
+            /* No edge */
+        }
+        active = now;
+    }
+    return count;
+}
+
+static bool is_click(const span_t *span, uint32_t min_ms, uint32_t max_ms)
+{
+    uint32_t duration = span->end_ms - span->start_ms;
+    uint32_t first = peak[span->start_ms];
+    uint32_t last = peak[span->end_ms - 1U];
+    bool click = (duration >= min_ms) && (duration <= max_ms) &&
+                 (abs((int32_t)(first & 0xFU) - (int32_t)(last & 0xFU)) <= 1) &&
+                 (abs((int32_t)(first >> 4U) - (int32_t)(last >> 4U)) <= 1);
+
+    for (uint32_t t = span->start_ms; click && (t < span->end_ms); t++)
+    {
+        click = (0U == (activity[t] & ACTIVITY_TWO_FINGERS));
+    }
+    return click;
+}
+
+/* Marks the time LED1 is lit: LED1 starts off and every one-finger click
+ * toggles it on liftoff. A click is a touch as short as the click timeouts
+ * whose strongest column and row move by at most one sensor, the jitter of a
+ * finger between two sensors; one that moves further is a flick.
+ * Brightness changes down to zero are not modelled. */
+static uint32_t mark_lit(const span_t *touch_spans, uint32_t num_touch)
+{
+    const cy_stc_capsense_gesture_config_t *cfg =
+        cy_capsense_context.ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrGestureConfig;
+    uint32_t click_min_ms = cfg->clickTimeoutMin * GESTURE_TICK_MS;
+    uint32_t click_max_ms = cfg->clickTimeoutMax * GESTURE_TICK_MS;
+    uint32_t clicks = 0U;
+    uint32_t from_ms = 0U;
+    bool lit = false;
+
+    for (uint32_t i = 0U; i <= num_touch; i++)
+    {
+        uint32_t to_ms = (i < num_touch) ? touch_spans[i].end_ms : activity_ms;
+
+        if ((i < num_touch) && !is_click(&touch_spans[i], click_min_ms, click_max_ms))
+        {
+            continue;
+        }
+        for (uint32_t t = from_ms; lit && (t < to_ms); t++)
+        {
+            activity[t] |= ACTIVITY_LIT;
+        }
+        lit = !lit;
+        from_ms = to_ms;
+        clicks += (i < num_touch) ? 1U : 0U;
+    }
+    return clicks;
+}
+
+/*******************************************************************************
+ * Latency
+ ******************************************************************************/
+static void latency_hit(latency_t *lat, uint32_t latency_ms)
+{
+    lat->hits++;
+    lat->total_ms += latency_ms;
+    if (latency_ms > lat->max_ms)
+    {
+        lat->max_ms = latency_ms;
+    }
+}
+
+/* Resolves every span that started at or before sample_ms: spans still in
+ * progress count as responded to at now_ms, spans already over as missed */
+static void latency_resolve(latency_t *lat, uint32_t sample_ms, uint32_t now_ms)
+{
+    while ((lat->next < lat->count) && (lat->spans[lat->next].start_ms <= sample_ms))
+    {
+        const span_t *span = &lat->spans[lat->next];
+
+        if (sample_ms < span->end_ms)
+        {
+            latency_hit(lat, now_ms - span->start_ms);
+        }
+        else
+        {
+            lat->missed++;
+        }
+        lat->next++;
+    }
+}
+
+static void print_latency(const latency_t *lat)
+{
+    if (0U != lat->hits)
+    {
+        printf(" %7.1f %6u", (double)lat->total_ms / (double)lat->hits, lat->max_ms);
+    }
+    else
+    {
+        printf(" %7s %6s", "-", "-");
+    }
+}
+
+/*******************************************************************************
+ * Policy run
+ ******************************************************************************/
+/* Wakes the device the way main.c does: the widget of the level is scanned
+ * and processed in the same wake-up, its activity is reported to the state
+ * machine, and the interval of the resulting level applies to the following
+ * sleep */
+static void run_policy(const policy_t *policy, const cost_model_t *cost, span_t *prox_spans, uint32_t num_prox,
+                       span_t *touch_spans, uint32_t num_touch, result_t *result)
+{
+    uint64_t end_us = (uint64_t)activity_ms * 1000U;
+    uint64_t now_us = 0U;
+    uint32_t prox_run = 0U;
+
+    memset(result, 0, sizeof(*result));
+    result->ready.spans = prox_spans;
+    result->ready.count = num_prox;
+    result->touch.spans = touch_spans;
+    result->touch.count = num_touch;
+
+    (void)power_policy_init(policy->levels, policy->num_levels, policy->initial_level, NULL);
+
+    while (now_us < end_us)
+    {
+        uint32_t now_ms = (uint32_t)(now_us / 1000U);
+        uint32_t events = POWER_POLICY_EVENT_NONE;
+        const power_level_config_t *level = power_policy_get_config();
+        uint64_t wake_start_us = result->active_us;
+
+        result->wakes++;
+
+        /* Scan the widget of the level and process the frame */
+        if (CY_CAPSENSE_PROXIMITY0_WDGT_ID == level->scan_widget)
+        {
+            result->active_us += cost->prox_wake_us;
+            prox_run = (0U != (activity[now_ms] & ACTIVITY_PROXIMITY)) ? (prox_run + 1U) : 0U;
+            if (prox_run >= cost->debounce)
+            {
+                events |= POWER_POLICY_EVENT_PROXIMITY;
+            }
+        }
+        else
+        {
+            result->active_us += cost->touch_wake_us;
+            prox_run = 0U;
+            if (0U != (activity[now_ms] & ACTIVITY_TOUCH))
+            {
+                events |= POWER_POLICY_EVENT_TOUCH;
+            }
+            latency_resolve(&result->ready, now_ms, now_ms);
+            latency_resolve(&result->touch, now_ms, now_ms);
+        }
+
+        /* Change level */
+        power_policy_update(level->interval_us, events);
+        level = power_policy_get_config();
+        result->level_us[power_policy_get_level()] += level->interval_us;
+
+        /* The rest of the interval sleeps; while LED1 is lit only the CPU */
+        if (cost->sleep_while_lit && (0U != (activity[now_ms] & ACTIVITY_LIT)))
+        {
+            uint64_t wake_us = result->active_us - wake_start_us;
+
+            result->lit_sleep_us += (wake_us < level->interval_us) ? (level->interval_us - wake_us) : 0U;
+        }
+        now_us += level->interval_us;
+    }
+
+    /* Activity the run never responded to */
+    result->ready.missed += result->ready.count - result->ready.next;
+    result->touch.missed += result->touch.count - result->touch.next;
+    result->transitions = power_policy_get_transitions();
+}
+
+/*******************************************************************************
+ * Policies
+ ******************************************************************************/
+static void add_preset(policy_t *policy, const char *name, const power_level_config_t *levels,
+                       uint32_t num_levels, uint32_t initial_level)
+{
+    snprintf(policy->name, sizeof(policy->name), "%s", name);
+    memcpy(policy->levels, levels, num_levels * sizeof(power_level_config_t));
+    policy->num_levels = num_levels;
+    policy->initial_level = initial_level;
+}
+
+/* Built-in policies: the firmware default, the original two-state loop and
+ * two variants trading latency against current */
+static uint32_t load_presets(policy_t *policies)
+{
+    static const power_level_config_t legacy[] =
+    {
+        {  10000U, CY_CAPSENSE_TOUCHPAD0_WDGT_ID,  1000U, 1U, 0U },
+        { 100000U, CY_CAPSENSE_PROXIMITY0_WDGT_ID,    0U, 1U, 0U },
+    };
+    static const power_level_config_t responsive[] =
+    {
+        {  10000U, CY_CAPSENSE_TOUCHPAD0_WDGT_ID,   300U, 1U, 0U },
+        {  20000U, CY_CAPSENSE_TOUCHPAD0_WDGT_ID,  1700U, 2U, 0U },
+        {  50000U, CY_CAPSENSE_PROXIMITY0_WDGT_ID,    0U, 2U, 0U },
+    };
+    static const power_level_config_t saver[] =
+    {
+        {  10000U, CY_CAPSENSE_TOUCHPAD0_WDGT_ID,   300U, 1U, 0U },
+        {  20000U, CY_CAPSENSE_TOUCHPAD0_WDGT_ID,   200U, 2U, 0U },
+        { 200000U, CY_CAPSENSE_PROXIMITY0_WDGT_ID, 10000U, 3U, 0U },
+        { 800000U, CY_CAPSENSE_PROXIMITY0_WDGT_ID,    0U, 3U, 0U },
+    };
+
+    add_preset(&policies[0], "firmware", power_levels, POWER_LEVEL_COUNT, POWER_LEVEL_PROX_IDLE);
+    add_preset(&policies[1], "legacy", legacy, 2U, 1U);
+    add_preset(&policies[2], "responsive", responsive, 3U, 2U);
+    add_preset(&policies[3], "saver", saver, 4U, 2U);
+    return 4U;
+}
+
+/* Parses INTERVAL_US:t|p:DWELL_MS[,...]. Every level idles into the next one,
+ * the last one into itself; the run starts in the first proximity level. */
+static bool parse_policy(const char *spec, policy_t *policy)
+{
+    const char *p = spec;
+
+    memset(policy, 0, sizeof(*policy));
+    snprintf(policy->name, sizeof(policy->name), "custom");
+    policy->initial_level = POWER_POLICY_MAX_LEVELS;
+
+    while ('\0' != *p)
+    {
+        power_level_config_t *level = &policy->levels[policy->num_levels];
+        char *end;
+
+        if (policy->num_levels >= POWER_POLICY_MAX_LEVELS)
+        {
+            return false;
+        }
+        level->interval_us = (uint32_t)strtoul(p, &end, 0);
+        if ((end == p) || (':' != end[0]) || (('t' != end[1]) && ('p' != end[1])) || (':' != end[2]))
+        {
+            return false;
+        }
+        level->scan_widget = ('t' == end[1]) ? CY_CAPSENSE_TOUCHPAD0_WDGT_ID : CY_CAPSENSE_PROXIMITY0_WDGT_ID;
+        if ((CY_CAPSENSE_PROXIMITY0_WDGT_ID == level->scan_widget) && (POWER_POLICY_MAX_LEVELS == policy->initial_level))
+        {
+            policy->initial_level = policy->num_levels;
+        }
+        p = end + 3;
+        level->dwell_ms = (uint32_t)strtoul(p, &end, 0);
+        if ((end == p) || ((',' != *end) && ('\0' != *end)))
+        {
+            return false;
+        }
+        level->idle_level = (uint8_t)(policy->num_levels + 1U);
+        level->wet_interval_us = 0U;
+        policy->num_levels++;
+        p = (',' == *end) ? (end + 1) : end;
+    }
+
+    if (0U == policy->num_levels)
+    {
+        return false;
+    }
+    policy->levels[policy->num_levels - 1U].idle_level = (uint8_t)(policy->num_levels - 1U);
+    if (POWER_POLICY_MAX_LEVELS == policy->initial_level)
+    {
+        policy->initial_level = policy->num_levels - 1U;
+    }
+    return power_policy_init(policy->levels, policy->num_levels, policy->initial_level, NULL);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -t FILE    activity from a raw-count trace (CSV: t_ms,prox,c0..c15,r0..r9)\n"
+            "             instead of the built-in demo script\n"
+            "  -s SEC     use only the first SEC seconds\n"
+            "  -p POLICY  compare POLICY, repeatable (default: all presets). A preset name\n"
+            "             (firmware, legacy, responsive, saver) or a level list\n"
+            "             INTERVAL_US:t|p:DWELL_MS,... scanning the touchpad (t) or the\n"
+            "             proximity sensor (p); level 0 is entered on any activity and\n"
+            "             every level idles into the next\n"
+            "  -a UA      active current (default %.0f uA)\n"
+            "  -z UA      Deep Sleep current (default %.1f uA)\n"
+            "  -c UA      CPU Sleep current, taken while LED1 is lit (default %.0f uA)\n"
+            "  -L 0|1     LED_CONTROL_SLEEP_WHILE_LIT to model; 0 deep-sleeps with LED1\n"
+            "             lit (default %u)\n"
+            "  -P US      active time of a proximity wake-up (default %u us)\n"
+            "  -T US      active time of a touchpad wake-up (default %u us)\n"
+            "  -v         show the time spent in every level\n",
+            prog, DEFAULT_ACTIVE_UA, DEFAULT_SLEEP_UA, DEFAULT_CPU_SLEEP_UA, LED_CONTROL_SLEEP_WHILE_LIT,
+            DEFAULT_PROX_WAKE_US, DEFAULT_TOUCH_WAKE_US);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the policy comparison tool.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    policy_t presets[POLICY_MAX];
+    policy_t policies[POLICY_MAX];
+    uint32_t num_presets = load_presets(presets);
+    uint32_t num_policies = 0U;
+    cost_model_t cost =
+    {
+        DEFAULT_ACTIVE_UA, DEFAULT_SLEEP_UA, DEFAULT_CPU_SLEEP_UA, (0U != LED_CONTROL_SLEEP_WHILE_LIT),
+        DEFAULT_PROX_WAKE_US, DEFAULT_TOUCH_WAKE_US,
+        cy_capsense_context.ptrWdContext[CY_CAPSENSE_PROXIMITY0_WDGT_ID].onDebounce
+    };
+    const char *trace_path = NULL;
+    uint32_t max_ms = 0U;
+    bool verbose = false;
+    span_t *prox_spans;
+    span_t *touch_spans;
+    uint32_t num_prox;
+    uint32_t num_touch;
+    uint32_t num_clicks;
+    uint64_t lit_ms = 0U;
+    bool loaded;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "t:s:p:a:z:c:L:P:T:vh")))
+    {
+        switch (opt)
+        {
+        case 't': trace_path = optarg; break;
+        case 's': max_ms = (uint32_t)(strtod(optarg, NULL) * 1000.0); break;
+        case 'p':
+        {
+            uint32_t i;
+
+            if (num_policies >= POLICY_MAX)
+            {
+                fprintf(stderr, "at most %u policies\n", POLICY_MAX);
+                return 2;
+            }
+            for (i = 0U; (i < num_presets) && (0 != strcmp(optarg, presets[i].name)); i++)
+            {
+            }
+            if (i < num_presets)
+            {
+                policies[num_policies] = presets[i];
+            }
+            else if (parse_policy(optarg, &policies[num_policies]))
+            {
+                snprintf(policies[num_policies].name, POLICY_NAME_MAX, "custom%u", num_policies);
+            }
+            else
+            {
+                fprintf(stderr, "invalid policy: %s\n", optarg);
+                return 2;
+            }
+            num_policies++;
+            break;
+        }
+        case 'a': cost.active_ua = strtod(optarg, NULL); break;
+        case 'z': cost.sleep_ua = strtod(optarg, NULL); break;
+        case 'c': cost.cpu_sleep_ua = strtod(optarg, NULL); break;
+        case 'L': cost.sleep_while_lit = (0UL != strtoul(optarg, NULL, 0)); break;
+        case 'P': cost.prox_wake_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'T': cost.touch_wake_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'v': verbose = true; break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+    if (0U == num_policies)
+    {
+        memcpy(policies, presets, sizeof(policies));
+        num_policies = num_presets;
+    }
+
+    if (NULL != trace_path)
+    {
+        trace_t trace;
+
+        if (!trace_open(&trace, trace_path))
+        {
+            return 1;
+        }
+        loaded = load_activity(trace_source, &trace, max_ms);
+        trace_close(&trace);
+    }
+    else
+    {
+        synth_t synth;
+
+        synth_init_demo(&synth, false);
+        loaded = load_activity(synth_source, &synth, max_ms);
+    }
+    if (!loaded)
+    {
+        fprintf(stderr, "no activity data\n");
+        return 1;
+    }
+
+    num_prox = find_spans(ACTIVITY_PROXIMITY | ACTIVITY_TOUCH, &prox_spans);
+    num_touch = find_spans(ACTIVITY_TOUCH, &touch_spans);
+    num_clicks = mark_lit(touch_spans, num_touch);
+    for (uint32_t t = 0U; t < activity_ms; t++)
+    {
+        lit_ms += (0U != (activity[t] & ACTIVITY_LIT)) ? 1U : 0U;
+    }
+
+    printf("%.3f s, %u hand approaches, %u touches, proximity debounce %u\n",
+           (double)activity_ms / 1000.0, num_prox, num_touch, cost.debounce);
+    printf("LED1 lit %.3f s after %u clicks, %s while lit\n\n", (double)lit_ms / 1000.0, num_clicks,
+           cost.sleep_while_lit ? "CPU Sleep" : "Deep Sleep");
+    printf("%-12s %6s %8s %8s %7s %6s | %-21s | %-21s\n", "", "", "", "", "", "",
+           "hand to touchpad ms", "finger to frame ms");
+    printf("%-12s %6s %8s %8s %7s %6s | %7s %6s %6s | %7s %6s %6s\n", "policy", "levels", "avg uA", "lit uA",
+           "wakes/s", "trans", "mean", "max", "missed", "mean", "max", "missed");
+
+    for (uint32_t i = 0U; i < num_policies; i++)
+    {
+        const policy_t *policy = &policies[i];
+        result_t result;
+        uint64_t total_us = 0U;
+        double lit_ua;
+
+        run_policy(policy, &cost, prox_spans, num_prox, touch_spans, num_touch, &result);
+        for (uint32_t l = 0U; l < policy->num_levels; l++)
+        {
+            total_us += result.level_us[l];
+        }
+
+        lit_ua = ((double)result.lit_sleep_us * (cost.cpu_sleep_ua - cost.sleep_ua)) / (double)total_us;
+        printf("%-12s %6u %8.2f %8.2f %7.2f %6u |", policy->name, policy->num_levels,
+               ((((double)result.active_us * cost.active_ua) +
+                 ((double)(total_us - result.active_us) * cost.sleep_ua)) / (double)total_us) + lit_ua,
+               lit_ua, (double)result.wakes * 1e6 / (double)total_us, result.transitions);
+        print_latency(&result.ready);
+        printf(" %6u |", result.ready.missed);
+        print_latency(&result.touch);
+        printf(" %6u\n", result.touch.missed);
+
+        if (verbose)
+        {
+            for (uint32_t l = 0U; l < policy->num_levels; l++)
+            {
+                printf("    level %u: %6u us %-9s dwell %6u ms -> %u  %5.1f%% of the time\n", l,
+                       policy->levels[l].interval_us,
+                       (CY_CAPSENSE_TOUCHPAD0_WDGT_ID == policy->levels[l].scan_widget) ? "touchpad" : "proximity",
+                       policy->levels[l].dwell_ms, policy->levels[l].idle_level,
+                       100.0 * (double)result.level_us[l] / (double)total_us);
+            }
+        }
+    }
+
+    free(prox_spans);
+    free(touch_spans);
+    free(activity);
+    free(peak);
+    return 0;
+}
+
+/* [] END OF FILE */
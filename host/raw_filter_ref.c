@@ -0,0 +1,138 @@
+/******************************************************************************
+ * File Name: raw_filter_ref.c
+ *
+ * Description: Scalar reference of the packed touchpad raw count filters
+ * (source/raw_filter.c).
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <string.h>
+#include "raw_filter_ref.h"
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static uint16_t median_of_3(uint16_t a, uint16_t b, uint16_t c)
+{
+    uint16_t low = (a < b) ? a : b;
+    uint16_t high = (a < b) ? b : a;
+
+    if (c < high)
+    {
+        high = c;
+    }
+    return (low > high) ? low : high;
+}
+
+/* [1 2 1] / 4 over count sensors, rounded, the edge sensors repeated */
+static void smooth(uint16_t *raw, uint32_t count)
+{
+    uint16_t in[RAW_FILTER_NUM_SNS];
+
+    memcpy(in, raw, count * sizeof(uint16_t));
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        uint32_t left = in[(i > 0U) ? (i - 1U) : 0U];
+        uint32_t right = in[((i + 1U) < count) ? (i + 1U) : i];
+
+        raw[i] = (uint16_t)((left + (2U * in[i]) + right + 2U) / 4U);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_filter_ref_init
+ ********************************************************************************
+ * Summary:
+ *  Starts with no filter state.
+ *
+ *******************************************************************************/
+void raw_filter_ref_init(raw_filter_ref_t *ref)
+{
+    memset(ref, 0, sizeof(*ref));
+}
+
+/*******************************************************************************
+ * Function Name: raw_filter_ref_run
+ ********************************************************************************
+ * Summary:
+ *  Filters the touchpad raw counts in widget order, as raw_filter_run() does
+ *  on the packed frame.
+ *
+ *******************************************************************************/
+void raw_filter_ref_run(raw_filter_ref_t *ref, uint16_t *raw, uint32_t stages)
+{
+    uint32_t seed = stages & ~ref->seeded;
+
+    ref->seeded = stages;
+
+    if (0U != (stages & RAW_FILTER_MEDIAN))
+    {
+        if (0U != (seed & RAW_FILTER_MEDIAN))
+        {
+            memcpy(ref->newest, raw, sizeof(ref->newest));
+            memcpy(ref->oldest, raw, sizeof(ref->oldest));
+        }
+        for (uint32_t i = 0U; i < RAW_FILTER_NUM_SNS; i++)
+        {
+            uint16_t in = raw[i];
+
+            raw[i] = median_of_3(in, ref->newest[i], ref->oldest[i]);
+            ref->oldest[i] = ref->newest[i];
+            ref->newest[i] = in;
+        }
+    }
+
+    if (0U != (stages & RAW_FILTER_IIR))
+    {
+        for (uint32_t i = 0U; i < RAW_FILTER_NUM_SNS; i++)
+        {
+            if (0U != (seed & RAW_FILTER_IIR))
+            {
+                ref->iir[i] = (uint16_t)(raw[i] << RAW_FILTER_IIR_SHIFT);
+            }
+            ref->iir[i] = (uint16_t)(ref->iir[i] - (ref->iir[i] >> RAW_FILTER_IIR_SHIFT) + raw[i]);
+            raw[i] = (uint16_t)((ref->iir[i] + (1U << (RAW_FILTER_IIR_SHIFT - 1U))) >> RAW_FILTER_IIR_SHIFT);
+        }
+    }
+
+    if (0U != (stages & RAW_FILTER_SPATIAL))
+    {
+        smooth(&raw[0], RAW_FILTER_NUM_COLS);
+        smooth(&raw[RAW_FILTER_NUM_COLS], RAW_FILTER_NUM_ROWS);
+    }
+}
+
+/* [] END OF FILE */
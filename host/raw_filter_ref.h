@@ -0,0 +1,68 @@
+/******************************************************************************
+ * File Name: raw_filter_ref.h
+ *
+ * Description: Scalar reference of the packed touchpad raw count filters
+ * (source/raw_filter.c). One raw count at a time, written for clarity; the
+ * packed filters must give the same result for every sensor.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef RAW_FILTER_REF_H
+#define RAW_FILTER_REF_H
+
+#include <stdint.h>
+#include "raw_filter.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t iir[RAW_FILTER_NUM_SNS];           /* Q(RAW_FILTER_IIR_SHIFT) */
+    uint16_t newest[RAW_FILTER_NUM_SNS];        /* Unfiltered previous frame */
+    uint16_t oldest[RAW_FILTER_NUM_SNS];        /* Unfiltered frame before that */
+    uint32_t seeded;
+} raw_filter_ref_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void raw_filter_ref_init(raw_filter_ref_t *ref);
+void raw_filter_ref_run(raw_filter_ref_t *ref, uint16_t *raw, uint32_t stages);
+
+#endif /* RAW_FILTER_REF_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,272 @@
+/******************************************************************************
+ * File Name: replay_main.c
+ *
+ * Description: Capture replay driver (touchpad_replay). Pushes recorded raw
+ * counts through the same CAPSENSE processing path as the application,
+ * Cy_CapSense_ProcessWidget() followed by Cy_CapSense_DecodeWidgetGestures(),
+ * with the gesture timestamp and device time taken from the capture, and prints
+ * every gesture the way the firmware reports it. Runs entirely on the recorded
+ * timeline, so a capture of many hours replays in seconds and always yields the
+ * same result.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "capture_io.h"
+#include "gesture_names.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define REPLAY_MAX_GESTURE_KINDS    (32U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t gesture;
+    uint32_t count;
+} gesture_count_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static gesture_count_t gesture_counts[REPLAY_MAX_GESTURE_KINDS];
+static uint32_t gesture_kinds;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static void count_gesture(uint32_t gesture)
+{
+    for (uint32_t i = 0U; i < gesture_kinds; i++)
+    {
+        if (gesture_counts[i].gesture == gesture)
+        {
+            gesture_counts[i].count++;
+            return;
+        }
+    }
+    if (gesture_kinds < REPLAY_MAX_GESTURE_KINDS)
+    {
+        gesture_counts[gesture_kinds].gesture = gesture;
+        gesture_counts[gesture_kinds].count = 1U;
+        gesture_kinds++;
+    }
+}
+
+static void print_time(FILE *out, uint32_t time_ms)
+{
+    fprintf(out, "%02u:%02u:%02u.%03u", time_ms / 3600000U, (time_ms / 60000U) % 60U,
+            (time_ms / 1000U) % 60U, time_ms % 1000U);
+}
+
+static void load_raw_counts(const capture_frame_t *frame)
+{
+    const cy_stc_capsense_widget_config_t *wd = cy_capsense_context.ptrWdConfig;
+
+    if (0U != (frame->flags & CAPTURE_FLAG_PROXIMITY))
+    {
+        wd[CY_CAPSENSE_PROXIMITY0_WDGT_ID].ptrSnsContext[0].raw = frame->prox_raw;
+    }
+    if (0U != (frame->flags & CAPTURE_FLAG_TOUCHPAD))
+    {
+        for (uint32_t i = 0U; i < CAPTURE_TOUCHPAD_NUM_SNS; i++)
+        {
+            wd[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrSnsContext[i].raw = frame->touchpad_raw[i];
+        }
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options] CAPTURE\n"
+            "  CAPTURE   raw-count capture, '-' reads standard input\n"
+            "  -v        print the touch position of every touchpad frame\n"
+            "  -q        print the summary only\n",
+            prog);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the replay driver.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    capture_reader_t reader;
+    const capture_frame_t *frame;
+    bool verbose = false;
+    bool quiet = false;
+    uint16_t initialized = 0U;
+    uint32_t gest = 0U;
+    uint32_t lgest = 0U;
+    uint32_t first_ms = 0U;
+    uint32_t last_ms = 0U;
+    uint64_t tp_frames = 0U;
+    uint64_t gestures = 0U;
+    struct timespec t0;
+    struct timespec t1;
+    double host_s;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "vqh")))
+    {
+        switch (opt)
+        {
+        case 'v': verbose = true; break;
+        case 'q': quiet = true; break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+    if ((optind + 1) != argc)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (!capture_reader_open(&reader, argv[optind]))
+    {
+        return 1;
+    }
+
+    sim_reset(NULL);
+    (void)Cy_CapSense_Init(&cy_capsense_context);
+    cy_capsense_context.ptrCommonContext->timestampInterval = reader.header.timestamp_interval;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    while (NULL != (frame = capture_reader_next(&reader)))
+    {
+        load_raw_counts(frame);
+
+        /* Start every widget from a settled baseline, as after
+         * Cy_CapSense_Enable(), on the first frame that scanned it */
+        if (0U != (frame->flags & (uint16_t)~initialized))
+        {
+            if (0U != (frame->flags & (uint16_t)~initialized & CAPTURE_FLAG_PROXIMITY))
+            {
+                Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_PROXIMITY0_WDGT_ID, &cy_capsense_context);
+            }
+            if (0U != (frame->flags & (uint16_t)~initialized & CAPTURE_FLAG_TOUCHPAD))
+            {
+                Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+            }
+            initialized |= frame->flags;
+        }
+        if (0U == reader.frames - 1U)
+        {
+            first_ms = frame->time_ms;
+        }
+        last_ms = frame->time_ms;
+
+        Cy_CapSense_SetGestureTimestamp(frame->timestamp, &cy_capsense_context);
+
+        if (0U != (frame->flags & CAPTURE_FLAG_PROXIMITY))
+        {
+            (void)Cy_CapSense_ProcessWidget(CY_CAPSENSE_PROXIMITY0_WDGT_ID, &cy_capsense_context);
+        }
+        if (0U == (frame->flags & CAPTURE_FLAG_TOUCHPAD))
+        {
+            continue;
+        }
+
+        (void)Cy_CapSense_ProcessWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+        gest = Cy_CapSense_DecodeWidgetGestures(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+        tp_frames++;
+
+        if (verbose)
+        {
+            const cy_stc_capsense_touch_t *touch =
+                Cy_CapSense_GetTouchInfo(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+
+            print_time(stdout, frame->time_ms);
+            printf(" ts=%u fingers=%u", frame->timestamp, touch->numPosition);
+            for (uint32_t i = 0U; i < touch->numPosition; i++)
+            {
+                printf(" (%u,%u,%u)", touch->ptrPosition[i].x, touch->ptrPosition[i].y, touch->ptrPosition[i].z);
+            }
+            printf("\n");
+        }
+
+        /* Report changes of the decoded gesture, as the application does */
+        if ((gest != lgest) && (0U != gest))
+        {
+            const char *name = gesture_name(gest);
+
+            gestures++;
+            count_gesture(gest);
+            if (!quiet)
+            {
+                print_time(stdout, frame->time_ms);
+                printf(" ts=%u %08x %s\n", frame->timestamp, gest, (NULL != name) ? name : "");
+            }
+        }
+        lgest = gest;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    host_s = (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9);
+
+    fflush(stdout);
+    fprintf(stderr, "frames              : %llu (%llu touchpad)\n",
+            (unsigned long long)reader.frames, (unsigned long long)tp_frames);
+    fprintf(stderr, "capture time        : ");
+    print_time(stderr, last_ms - first_ms);
+    fprintf(stderr, "\ngestures            : %llu\n", (unsigned long long)gestures);
+    for (uint32_t i = 0U; i < gesture_kinds; i++)
+    {
+        const char *name = gesture_name(gesture_counts[i].gesture);
+
+        fprintf(stderr, "  %08x %-20s: %u\n", gesture_counts[i].gesture, (NULL != name) ? name : "",
+                gesture_counts[i].count);
+    }
+    fprintf(stderr, "host time           : %.3f s (%.0f frames/s)\n", host_s,
+            (host_s > 0.0) ? ((double)reader.frames / host_s) : 0.0);
+
+    capture_reader_close(&reader);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,512 @@
+/******************************************************************************
+ * File Name: sim_main.c
+ *
+ * Description: Command line front end of the host simulator (touchpad_sim).
+ * Runs the unmodified application in main.c against the simulated device, fed
+ * either by the built-in synthetic gesture script or by a raw-count trace in
+ * CSV form, echoes the debug UART output and reports where the device spent its
+ * time.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "synth.h"
+#include "trace.h"
+#include "capture_io.h"
+#include "cal_store.h"
+#include "boot_profile.h"
+#include "low_power.h"
+#include "noise_hop.h"
+#include "scan_pipeline.h"
+#include "prox_baseline.h"
+#include "liquid_detect.h"
+#include "touch_roi.h"
+#include "raw_filter.h"
+#include "led_control.h"
+#include "telemetry.h"
+#include "gesture_log_decode.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Secondary EZI2C buffer of the application, the telemetry region */
+extern cy_stc_scb_ezi2c_context_t ezi2c_context;
+
+static const char *const stage_names[STAGE_PROFILE_COUNT] =
+{
+    "wdt wake", "ilo compensation", "proximity scan", "touchpad scan", "proximity process",
+    "touchpad process", "gesture decode", "active loop", "tuner", "raw filter", "sleep callback",
+    "wake callback", "scan wait", "active per wake", "clock calibration", "capsense start",
+    "first gesture"
+};
+
+/* Append timestamp and position to echoed gestures */
+static bool verbose = false;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+int app_main(void);
+
+/*******************************************************************************
+ * Calibration flash image
+ ******************************************************************************/
+/* Loads the calibration record rows of a previous run, so that the firmware
+ * boots as after a power cycle. A missing file leaves the rows erased. */
+static bool flash_load(const char *path)
+{
+    uint8_t rows[sizeof(cal_store_area)];
+    FILE *f = fopen(path, "rb");
+
+    if (NULL == f)
+    {
+        return true;
+    }
+    if (sizeof(rows) != fread(rows, 1, sizeof(rows), f))
+    {
+        fprintf(stderr, "%s: not a calibration flash image\n", path);
+        fclose(f);
+        return false;
+    }
+    fclose(f);
+    sim_flash_write((const void *)cal_store_area, rows, sizeof(rows));
+    return true;
+}
+
+static bool flash_save(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    bool ok = (NULL != f) && (sizeof(cal_store_area) == fwrite((const void *)cal_store_area, 1, sizeof(cal_store_area), f));
+
+    if ((NULL == f) || (0 != fclose(f)) || !ok)
+    {
+        perror(path);
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Capture recording
+ ******************************************************************************/
+/* A windowed touchpad frame is scanned as several slot ranges. It is recorded
+ * once its last range completes, with the sensors outside the window at their
+ * baseline as the firmware processes them. Returns false for an earlier range. */
+static bool touchpad_frame_done(uint32_t start_slot, uint32_t num_slots, capture_frame_t *frame)
+{
+    const cy_stc_capsense_widget_config_t *wd = &cy_capsense_context.ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID];
+    uint32_t slots = scan_pipeline_get_inflight_slots();
+    uint32_t end = start_slot + num_slots - wd->firstSlotId;
+
+    if ((0U == slots) || (SCAN_PIPELINE_ALL_SLOTS == slots))
+    {
+        /* Calibration or a full frame */
+        return true;
+    }
+    if ((end < SCAN_PIPELINE_MAX_SLOTS) && (0U != (slots >> end)))
+    {
+        return false;
+    }
+
+    for (uint32_t slot = 0U; slot < wd->numSlots; slot++)
+    {
+        if (0U != (slots & (1UL << slot)))
+        {
+            continue;
+        }
+        for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+        {
+            const cy_stc_capsense_scan_slot_t *entry =
+                &cy_capsense_scanSlots[((wd->firstSlotId + slot) * CY_CAPSENSE_TOTAL_CH_NUMBER) + ch];
+
+            if ((CY_CAPSENSE_TOUCHPAD0_WDGT_ID == entry->wdId) && (entry->snsId < CAPTURE_TOUCHPAD_NUM_SNS))
+            {
+                frame->touchpad_raw[entry->snsId] = wd->ptrSnsContext[entry->snsId].bsln;
+            }
+        }
+    }
+    return true;
+}
+
+static void record_scan(void *arg, uint32_t start_slot, uint32_t num_slots)
+{
+    capture_writer_t *writer = (capture_writer_t *)arg;
+    const cy_stc_capsense_widget_config_t *wd = cy_capsense_context.ptrWdConfig;
+    capture_frame_t frame;
+    uint16_t flags = 0U;
+
+    if ((start_slot <= wd[CY_CAPSENSE_PROXIMITY0_WDGT_ID].firstSlotId) &&
+        ((start_slot + num_slots) > wd[CY_CAPSENSE_PROXIMITY0_WDGT_ID].firstSlotId))
+    {
+        flags |= CAPTURE_FLAG_PROXIMITY;
+    }
+    if ((start_slot < (wd[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].firstSlotId + wd[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].numSlots)) &&
+        ((start_slot + num_slots) > wd[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].firstSlotId))
+    {
+        flags |= CAPTURE_FLAG_TOUCHPAD;
+    }
+
+    capture_fill_frame(&frame, (uint32_t)(sim_now_ns() / SIM_NS_PER_MS), flags, &cy_capsense_context);
+    if ((0U != (flags & CAPTURE_FLAG_TOUCHPAD)) && !touchpad_frame_done(start_slot, num_slots, &frame))
+    {
+        return;
+    }
+    (void)capture_writer_write(writer, &frame);
+}
+
+/*******************************************************************************
+ * UART echo, gesture records are decoded back to the text the firmware
+ * used to print
+ ******************************************************************************/
+static void uart_text(void *arg, uint8_t byte)
+{
+    FILE *out = (FILE *)arg;
+
+    if ('\r' != byte)
+    {
+        fputc(byte, out);
+    }
+}
+
+static void uart_event(void *arg, const gesture_log_event_t *event)
+{
+    char line[96];
+
+    (void)gesture_log_format(line, sizeof(line), event, verbose);
+    fprintf((FILE *)arg, "%s\n", line);
+}
+
+static void uart_echo(void *arg, uint8_t byte)
+{
+    gesture_log_decoder_push((gesture_log_decoder_t *)arg, byte);
+}
+
+/*******************************************************************************
+ * Stage profile, read from the I2C buffer the way a host on the bus sees it
+ ******************************************************************************/
+/* Upper bound of the bin holding the given fraction of all samples, limited
+ * to the largest sample */
+static uint32_t hist_percentile(const stage_profile_hist_t *hist, uint32_t num_bins, double fraction)
+{
+    uint64_t target = (uint64_t)((double)hist->count * fraction + 0.5);
+    uint64_t seen = 0U;
+
+    for (uint32_t b = 0U; b < num_bins; b++)
+    {
+        seen += hist->bins[b];
+        if ((seen >= target) && (0U != seen))
+        {
+            uint32_t bound = (0U == b) ? 0U : (uint32_t)((1ULL << b) - 1U);
+
+            return (bound < hist->max) ? bound : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+static void print_stage_profile(FILE *out)
+{
+    const telemetry_region_t *region = (const telemetry_region_t *)ezi2c_context.buf2;
+    const stage_profile_buffer_t *buf;
+    double cycles_per_us;
+
+    if ((NULL == region) || (ezi2c_context.buf2Size < sizeof(*region)))
+    {
+        return;
+    }
+    buf = &region->profile;
+    if (STAGE_PROFILE_VERSION != buf->version)
+    {
+        return;
+    }
+    cycles_per_us = (double)buf->cpu_hz / 1e6;
+
+    fprintf(out, "stage profile       :    count     min us   p50 us <=   p90 us <=     max us\n");
+    for (uint32_t i = 0U; (i < buf->num_stages) && (i < STAGE_PROFILE_COUNT); i++)
+    {
+        const stage_profile_hist_t *hist = &buf->stage[i];
+
+        if (0U == hist->count)
+        {
+            continue;
+        }
+        fprintf(out, "  %-18s: %8u %10.1f %11.1f %11.1f %10.1f\n", stage_names[i], hist->count,
+                (double)hist->min / cycles_per_us,
+                (double)hist_percentile(hist, buf->num_bins, 0.5) / cycles_per_us,
+                (double)hist_percentile(hist, buf->num_bins, 0.9) / cycles_per_us,
+                (double)hist->max / cycles_per_us);
+        if (verbose)
+        {
+            fprintf(out, "   ");
+            for (uint32_t b = 0U; b < buf->num_bins; b++)
+            {
+                if (0U != hist->bins[b])
+                {
+                    fprintf(out, " <2^%u:%u", b, hist->bins[b]);
+                }
+            }
+            fprintf(out, "\n");
+        }
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -t FILE   replay a raw-count trace (CSV: t_ms,prox,c0..c15,r0..r9)\n"
+            "  -l        loop the built-in demo script (default: play once)\n"
+            "  -n WAKES  stop after WAKES deep sleep exits\n"
+            "  -s SEC    stop after SEC seconds of device time\n"
+            "  -i HZ     actual ILO frequency (default 40000)\n"
+            "  -I SEC    a tuner starts polling the primary EZI2C address at SEC\n"
+            "  -w FILE   record every completed scan to a raw-count capture\n"
+            "  -f FILE   keep the calibration flash rows in FILE: loaded before the\n"
+            "            run if it exists, written after it\n"
+            "  -v        show timestamp and position of logged gestures and the\n"
+            "            stage profile histograms\n"
+            "  -q        do not echo the debug UART\n",
+            prog);
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the simulator.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    sim_config_t config = { 0 };
+    const char *trace_path = NULL;
+    const char *capture_path = NULL;
+    const char *flash_path = NULL;
+    bool loop = false;
+    bool quiet = false;
+    synth_t synth;
+    trace_t trace = { 0 };
+    capture_writer_t writer = { 0 };
+    gesture_log_decoder_t decoder;
+    struct timespec t0;
+    struct timespec t1;
+    int opt;
+    int rc;
+
+    while (-1 != (opt = getopt(argc, argv, "t:ln:s:i:I:w:f:vqh")))
+    {
+        switch (opt)
+        {
+        case 't': trace_path = optarg; break;
+        case 'l': loop = true; break;
+        case 'n': config.max_wakes = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 's': config.max_time_ns = (uint64_t)(strtod(optarg, NULL) * (double)SIM_NS_PER_S); break;
+        case 'i': config.ilo_hz = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'I':
+            /* 0 in the configuration means never; connecting at reset is 1 ns */
+            config.tuner_connect_ns = (uint64_t)(strtod(optarg, NULL) * (double)SIM_NS_PER_S) + 1U;
+            break;
+        case 'w': capture_path = optarg; break;
+        case 'f': flash_path = optarg; break;
+        case 'v': verbose = true; break;
+        case 'q': quiet = true; break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+
+    sim_reset(&config);
+    if ((NULL != flash_path) && !flash_load(flash_path))
+    {
+        return 1;
+    }
+
+    if (NULL != trace_path)
+    {
+        if (!trace_open(&trace, trace_path))
+        {
+            return 1;
+        }
+        sim_set_source(trace_source, &trace);
+    }
+    else
+    {
+        synth_init_demo(&synth, loop);
+        sim_set_source(synth_source, &synth);
+    }
+
+    if (NULL != capture_path)
+    {
+        capture_header_t header;
+
+        capture_init_header(&header, &cy_capsense_context);
+        if (!capture_writer_open(&writer, capture_path, &header))
+        {
+            return 1;
+        }
+        sim_set_scan_hook(record_scan, &writer);
+    }
+
+    if (!quiet)
+    {
+        gesture_log_decoder_init(&decoder, uart_text, uart_event, stdout);
+        sim_set_uart_sink(uart_echo, &decoder);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    rc = sim_run(app_main);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    if (!quiet)
+    {
+        gesture_log_decoder_flush(&decoder);
+    }
+    fflush(stdout);
+    if ((NULL != flash_path) && !flash_save(flash_path))
+    {
+        rc = 1;
+    }
+    sim_print_stats(stderr, (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9));
+    fprintf(stderr, "sleep gate          : %.3f ms saved, %u waits\n",
+            (double)low_power_get_saved_us() / 1000.0, low_power_get_wait_count());
+    fprintf(stderr, "scan pipeline       : %u overruns\n", scan_pipeline_get_overruns());
+    {
+        static const char *const periph_names[LOW_POWER_PERIPH_COUNT] = { "uart", "pwm", "ezi2c", "msc" };
+
+        for (uint32_t i = 0U; i < LOW_POWER_PERIPH_COUNT; i++)
+        {
+            const low_power_periph_stats_t *pm = low_power_get_periph_stats((low_power_periph_t)i);
+
+            fprintf(stderr, "  pm %-15s: %u prepared, %u skipped, %u refused, %.1f us max wake\n",
+                    periph_names[i], pm->prepared, pm->skipped, pm->refused,
+                    (double)pm->max_exit_cycles / (SIM_CPU_HZ / 1e6));
+        }
+    }
+    {
+        const prox_baseline_stats_t *prox = prox_baseline_get_stats();
+
+        fprintf(stderr, "proximity frames    : %u (%u skipped, %u baseline reinits, %.1f us avg, %.1f us max)\n",
+                prox->frames, prox->skipped, prox->reinits,
+                (0U != prox->frames) ? ((double)prox->total_cycles / (double)prox->frames / (SIM_CPU_HZ / 1e6)) : 0.0,
+                (double)prox->max_cycles / (SIM_CPU_HZ / 1e6));
+    }
+
+    {
+        const liquid_detect_stats_t *liquid = liquid_detect_get_stats();
+
+        fprintf(stderr, "liquid              : %u wet periods (%u from proximity), %u wet frames, %u filtered counts\n",
+                liquid->wet_entries, liquid->prox_wet_entries, liquid->wet_frames, liquid->filtered);
+    }
+
+    {
+        const raw_filter_stats_t *filter = raw_filter_get_stats();
+
+        fprintf(stderr, "raw filter          : %u frames, %u restarts\n", filter->frames, filter->seeds);
+    }
+
+    {
+        static const char *const reject_names[] = { "", "empty", "version", "crc", "config", "validation",
+                                                    "disabled" };
+        const cal_store_stats_t *cal = cal_store_get_stats();
+
+        fprintf(stderr, "capsense start      : %s%s%s, %.3f ms (key %08x, %u sensors off)\n",
+                cal->restored ? "restored" : "calibrated", cal->restored ? "" : ", record ",
+                reject_names[cal->reject], (double)cal->start_cycles / (SIM_CPU_HZ / 1e3), cal->config_key,
+                cal->failed_sensors);
+    }
+
+    {
+        static const char *const phase_names[BOOT_PROFILE_COUNT] = { "bsp", "low power", "telemetry", "capsense",
+                                                                     "modules", "wdt", "first scan", "uart",
+                                                                     "ezi2c", "pwm" };
+        const boot_profile_record_t *boot = boot_profile_get();
+
+        fprintf(stderr, "boot                : %.3f ms to the first scan (boot %u)\n",
+                (double)boot->ready_cycles / (SIM_CPU_HZ / 1e3), boot->boots);
+        for (uint32_t i = 0U; i < BOOT_PROFILE_COUNT; i++)
+        {
+            if (0U != (boot->done & (1UL << i)))
+            {
+                fprintf(stderr, "  boot %-13s: %9.1f us\n", phase_names[i],
+                        (double)boot->cycles[i] / (SIM_CPU_HZ / 1e6));
+            }
+        }
+    }
+
+    {
+        const noise_hop_stats_t *hop = noise_hop_get_stats();
+
+        fprintf(stderr, "noise hop           : %u noisy of %u frames, %u hops, %u returns, %u holds, %.1f us max\n",
+                hop->noisy_frames, hop->frames, hop->hops, hop->returns, hop->holds,
+                (double)hop->max_cycles / (SIM_CPU_HZ / 1e6));
+    }
+
+    {
+        const touch_roi_stats_t *roi = touch_roi_get_stats();
+        uint32_t frames = roi->roi_frames + roi->full_frames;
+
+        fprintf(stderr, "touch roi           : %u window frames, %u full (%u sweeps), %u fallbacks, %.1f slots/frame\n",
+                roi->roi_frames, roi->full_frames, roi->sweeps, roi->fallbacks,
+                (0U != frames) ? ((double)roi->slots / (double)frames) : 0.0);
+    }
+
+    {
+        const led_control_stats_t *led = led_control_get_stats();
+
+        fprintf(stderr, "led control         : %u tracked frames, %u fades, %u direct writes, level %u (compare %u)\n",
+                led->tracked, led->fades, led->writes, led_control_get_level(), sim_pwm_compare0());
+    }
+
+    print_stage_profile(stderr);
+
+    if (NULL != trace.file)
+    {
+        trace_close(&trace);
+    }
+    if (NULL != writer.file)
+    {
+        capture_writer_close(&writer);
+    }
+    return rc;
+}
+
+/* [] END OF FILE */
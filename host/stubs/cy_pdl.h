@@ -0,0 +1,395 @@
+/******************************************************************************
+ * File Name: cy_pdl.h
+ *
+ * Description: Host-side stand-in for the PSoC 4 Peripheral Driver Library.
+ * Declares the subset of the PDL used by the application so that main.c can be
+ * compiled and run on a Linux host against the simulated hardware in sim_pdl.c.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Common
+ ******************************************************************************/
+typedef char char_t;
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS                 ((cy_rslt_t)0x00000000U)
+
+void sim_assert_failed(const char *file, int line);
+
+#define CY_ASSERT(x)                    do { if (!(x)) { sim_assert_failed(__FILE__, __LINE__); } } while (0)
+
+#define CY_UNUSED_PARAMETER(x)          ((void)(x))
+
+#define CY_SECTION(name)                __attribute__((section(name)))
+#define CY_ALIGN(align)                 __attribute__((aligned(align)))
+#define CY_NOINIT                       __attribute__((section(".noinit")))
+
+/* Interrupt sources used by the application */
+typedef enum
+{
+    srss_interrupt_wdt_IRQn     = 9,
+    scb_0_interrupt_IRQn        = 10,
+    scb_1_interrupt_IRQn        = 11,
+    tcpwm_interrupts_1_IRQn     = 18,
+    msc_0_interrupt_IRQn        = 21,
+    msc_1_interrupt_IRQn        = 22,
+    SIM_IRQ_COUNT               = 32
+} IRQn_Type;
+
+void __enable_irq(void);
+void __disable_irq(void);
+void __WFI(void);
+void __NOP(void);
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+
+/*******************************************************************************
+ * Peripheral instances. The simulator keeps the peripheral state internally,
+ * the instance structures only identify the block.
+ ******************************************************************************/
+typedef struct { uint32_t idx; } CySCB_Type;
+typedef struct { uint32_t idx; } TCPWM_Type;
+typedef struct { uint32_t idx; } MSC_Type;
+typedef struct { uint32_t idx; } GPIO_PRT_Type;
+
+extern CySCB_Type sim_scb[2];
+extern TCPWM_Type sim_tcpwm[1];
+extern MSC_Type sim_msc[2];
+extern GPIO_PRT_Type sim_gpio[8];
+
+#define SCB0                            (&sim_scb[0])
+#define SCB1                            (&sim_scb[1])
+#define TCPWM                           (&sim_tcpwm[0])
+#define MSC0                            (&sim_msc[0])
+#define MSC1                            (&sim_msc[1])
+
+/* Sensor frame registers per slot loaded by the CS_DMA chain */
+#define CY_MSC_6_SNS_REGS               (6u)
+
+/*******************************************************************************
+ * SysLib
+ ******************************************************************************/
+void Cy_SysLib_Delay(uint32_t milliseconds);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+
+/*******************************************************************************
+ * SysInt
+ ******************************************************************************/
+typedef void (* cy_israddress)(void);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS   = 0x0U,
+    CY_SYSINT_BAD_PARAM = 0x1U
+} cy_en_sysint_status_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t* config, cy_israddress userIsr);
+
+/*******************************************************************************
+ * SysPm
+ ******************************************************************************/
+typedef enum
+{
+    CY_SYSPM_SUCCESS         = 0x0U,
+    CY_SYSPM_BAD_PARAM       = 0x1U,
+    CY_SYSPM_TIMEOUT         = 0x2U,
+    CY_SYSPM_INVALID_STATE   = 0x3U,
+    CY_SYSPM_FAIL            = 0x4U
+} cy_en_syspm_status_t;
+
+typedef enum
+{
+    CY_SYSPM_CHECK_READY        = 0x01U,
+    CY_SYSPM_CHECK_FAIL         = 0x02U,
+    CY_SYSPM_BEFORE_TRANSITION  = 0x04U,
+    CY_SYSPM_AFTER_TRANSITION   = 0x08U
+} cy_en_syspm_callback_mode_t;
+
+typedef enum
+{
+    CY_SYSPM_SLEEP      = 0U,
+    CY_SYSPM_DEEPSLEEP  = 1U
+} cy_en_syspm_callback_type_t;
+
+#define CY_SYSPM_SKIP_CHECK_READY           (0x01U)
+#define CY_SYSPM_SKIP_CHECK_FAIL            (0x02U)
+#define CY_SYSPM_SKIP_BEFORE_TRANSITION     (0x04U)
+#define CY_SYSPM_SKIP_AFTER_TRANSITION      (0x08U)
+
+typedef struct
+{
+    void *base;
+    void *context;
+} cy_stc_syspm_callback_params_t;
+
+typedef cy_en_syspm_status_t (*Cy_SysPmCallback)
+    (cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+typedef struct cy_stc_syspm_callback
+{
+    Cy_SysPmCallback callback;
+    cy_en_syspm_callback_type_t type;
+    uint32_t skipMode;
+    cy_stc_syspm_callback_params_t *callbackParams;
+    struct cy_stc_syspm_callback *prevItm;
+    struct cy_stc_syspm_callback *nextItm;
+    uint8_t order;
+} cy_stc_syspm_callback_t;
+
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler);
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void);
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void);
+
+/*******************************************************************************
+ * SysClk
+ ******************************************************************************/
+typedef enum
+{
+    CY_SYSCLK_SUCCESS       = 0x0U,
+    CY_SYSCLK_BAD_PARAM     = 0x1U,
+    CY_SYSCLK_TIMEOUT       = 0x2U,
+    CY_SYSCLK_INVALID_STATE = 0x3U,
+    CY_SYSCLK_STARTED       = 0x4U
+} cy_en_sysclk_status_t;
+
+void Cy_SysClk_IloEnable(void);
+void Cy_SysClk_WcoDisable(void);
+void Cy_SysClk_IloStartMeasurement(void);
+void Cy_SysClk_IloStopMeasurement(void);
+cy_en_sysclk_status_t Cy_SysClk_IloCompensate(uint32_t desiredDelay, uint32_t *compensatedCycles);
+uint32_t Cy_SysClk_ClkSysGetFrequency(void);
+
+/*******************************************************************************
+ * WDT
+ ******************************************************************************/
+void Cy_WDT_Init(void);
+void Cy_WDT_Enable(void);
+void Cy_WDT_Disable(void);
+void Cy_WDT_SetMatch(uint32_t match);
+uint32_t Cy_WDT_GetMatch(void);
+uint32_t Cy_WDT_GetCount(void);
+void Cy_WDT_ClearInterrupt(void);
+void Cy_WDT_MaskInterrupt(void);
+void Cy_WDT_UnmaskInterrupt(void);
+
+/*******************************************************************************
+ * SysTick
+ ******************************************************************************/
+typedef enum
+{
+    CY_SYSTICK_CLOCK_SOURCE_CLK_LF  = 0U,
+    CY_SYSTICK_CLOCK_SOURCE_CLK_CPU = 4U
+} cy_en_systick_clock_source_t;
+
+#define CY_SYSTICK_RELOAD_MAX           (0x00FFFFFFUL)
+
+void Cy_SysTick_SetClockSource(cy_en_systick_clock_source_t clockSource);
+void Cy_SysTick_SetReload(uint32_t value);
+void Cy_SysTick_Clear(void);
+void Cy_SysTick_Enable(void);
+void Cy_SysTick_Disable(void);
+uint32_t Cy_SysTick_GetValue(void);
+
+/*******************************************************************************
+ * Flash
+ ******************************************************************************/
+#define CY_FLASH_SIZEOF_ROW             (128U)
+
+typedef enum
+{
+    CY_FLASH_DRV_SUCCESS                    = 0x00U,
+    CY_FLASH_DRV_INVALID_INPUT_PARAMETERS   = 0x03U
+} cy_en_flashdrv_status_t;
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t* data);
+
+/*******************************************************************************
+ * GPIO
+ ******************************************************************************/
+void Cy_GPIO_Write(GPIO_PRT_Type* base, uint32_t pinNum, uint32_t value);
+uint32_t Cy_GPIO_ReadOut(GPIO_PRT_Type* base, uint32_t pinNum);
+void Cy_GPIO_Inv(GPIO_PRT_Type* base, uint32_t pinNum);
+
+/*******************************************************************************
+ * TCPWM (PWM mode)
+ ******************************************************************************/
+typedef enum
+{
+    CY_TCPWM_SUCCESS   = 0x0U,
+    CY_TCPWM_BAD_PARAM = 0x1U
+} cy_en_tcpwm_status_t;
+
+#define CY_TCPWM_PWM_PRESCALER_DIVBY_1      (0U)
+#define CY_TCPWM_PWM_PRESCALER_DIVBY_64     (6U)
+
+/* Interrupt sources */
+#define CY_TCPWM_INT_NONE                   (0U)
+#define CY_TCPWM_INT_ON_TC                  (1U)
+#define CY_TCPWM_INT_ON_CC                  (2U)
+
+typedef struct
+{
+    uint32_t pwmMode;
+    uint32_t clockPrescaler;
+    uint32_t period0;
+    uint32_t period1;
+    bool enablePeriodSwap;
+    uint32_t compare0;
+    uint32_t compare1;
+    bool enableCompareSwap;
+    uint32_t interruptSources;
+} cy_stc_tcpwm_pwm_config_t;
+
+cy_en_tcpwm_status_t Cy_TCPWM_PWM_Init(TCPWM_Type *base, uint32_t cntNum, cy_stc_tcpwm_pwm_config_t const *config);
+void Cy_TCPWM_PWM_Enable(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_PWM_Disable(TCPWM_Type *base, uint32_t cntNum);
+void Cy_TCPWM_TriggerStart(TCPWM_Type *base, uint32_t counters);
+void Cy_TCPWM_PWM_SetCompare0(TCPWM_Type *base, uint32_t cntNum, uint32_t compare0);
+uint32_t Cy_TCPWM_PWM_GetCompare0(TCPWM_Type const *base, uint32_t cntNum);
+void Cy_TCPWM_PWM_SetCompare1(TCPWM_Type *base, uint32_t cntNum, uint32_t compare1);
+uint32_t Cy_TCPWM_PWM_GetCompare1(TCPWM_Type const *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_PWM_GetPeriod0(TCPWM_Type const *base, uint32_t cntNum);
+void Cy_TCPWM_TriggerCaptureOrSwap(TCPWM_Type *base, uint32_t counters);
+void Cy_TCPWM_SetInterruptMask(TCPWM_Type *base, uint32_t cntNum, uint32_t source);
+uint32_t Cy_TCPWM_GetInterruptMask(TCPWM_Type const *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_GetInterruptStatusMasked(TCPWM_Type const *base, uint32_t cntNum);
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source);
+
+/*******************************************************************************
+ * SCB UART
+ ******************************************************************************/
+typedef enum
+{
+    CY_SCB_UART_SUCCESS   = 0x0U,
+    CY_SCB_UART_BAD_PARAM = 0x1U
+} cy_en_scb_uart_status_t;
+
+typedef struct
+{
+    uint32_t baudRate;
+} cy_stc_scb_uart_config_t;
+
+typedef struct
+{
+    uint32_t txStatus;
+} cy_stc_scb_uart_context_t;
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, cy_stc_scb_uart_config_t const *config,
+                                         cy_stc_scb_uart_context_t *context);
+void Cy_SCB_UART_Enable(CySCB_Type *base);
+void Cy_SCB_UART_Disable(CySCB_Type *base, cy_stc_scb_uart_context_t *context);
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data);
+void Cy_SCB_UART_PutString(CySCB_Type *base, char_t const string[]);
+uint32_t Cy_SCB_UART_GetNumInTxFifo(CySCB_Type const *base);
+bool Cy_SCB_UART_IsTxComplete(CySCB_Type const *base);
+
+/* SCB TX FIFO interrupt (modelled for the debug UART) */
+#define CY_SCB_TX_INTR_LEVEL            (0x00000001UL)
+#define CY_SCB_TX_INTR_UART_DONE        (0x00000200UL)
+
+void Cy_SCB_SetTxFifoLevel(CySCB_Type *base, uint32_t level);
+void Cy_SCB_SetTxInterruptMask(CySCB_Type *base, uint32_t interruptMask);
+uint32_t Cy_SCB_GetTxInterruptMask(CySCB_Type const *base);
+uint32_t Cy_SCB_GetTxInterruptStatusMasked(CySCB_Type const *base);
+void Cy_SCB_ClearTxInterrupt(CySCB_Type *base, uint32_t interruptMask);
+
+/*******************************************************************************
+ * SCB EZI2C
+ ******************************************************************************/
+/* Cy_SCB_EZI2C_GetActivity() flags */
+#define CY_SCB_EZI2C_STATUS_READ1   (0x01UL)
+#define CY_SCB_EZI2C_STATUS_WRITE1  (0x02UL)
+#define CY_SCB_EZI2C_STATUS_READ2   (0x04UL)
+#define CY_SCB_EZI2C_STATUS_WRITE2  (0x08UL)
+#define CY_SCB_EZI2C_STATUS_BUSY    (0x10UL)
+
+typedef enum
+{
+    CY_SCB_EZI2C_SUCCESS   = 0x0U,
+    CY_SCB_EZI2C_BAD_PARAM = 0x1U
+} cy_en_scb_ezi2c_status_t;
+
+typedef struct
+{
+    uint32_t numberOfAddresses;
+    uint8_t slaveAddress1;
+    uint8_t slaveAddress2;
+} cy_stc_scb_ezi2c_config_t;
+
+typedef struct
+{
+    uint8_t *buf1;
+    uint32_t buf1Size;
+    uint32_t buf1rwBondary;
+    uint8_t *buf2;
+    uint32_t buf2Size;
+    uint32_t buf2rwBondary;
+} cy_stc_scb_ezi2c_context_t;
+
+cy_en_scb_ezi2c_status_t Cy_SCB_EZI2C_Init(CySCB_Type *base, cy_stc_scb_ezi2c_config_t const *config,
+                                           cy_stc_scb_ezi2c_context_t *context);
+void Cy_SCB_EZI2C_Enable(CySCB_Type *base);
+void Cy_SCB_EZI2C_Disable(CySCB_Type *base, cy_stc_scb_ezi2c_context_t *context);
+void Cy_SCB_EZI2C_SetBuffer1(CySCB_Type const *base, uint8_t *buffer, uint32_t size, uint32_t rwBoundary,
+                             cy_stc_scb_ezi2c_context_t *context);
+void Cy_SCB_EZI2C_SetBuffer2(CySCB_Type const *base, uint8_t *buffer, uint32_t size, uint32_t rwBoundary,
+                             cy_stc_scb_ezi2c_context_t *context);
+void Cy_SCB_EZI2C_Interrupt(CySCB_Type *base, cy_stc_scb_ezi2c_context_t *context);
+uint32_t Cy_SCB_EZI2C_GetActivity(CySCB_Type const *base, cy_stc_scb_ezi2c_context_t *context);
+cy_en_syspm_status_t Cy_SCB_EZI2C_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams,
+                                                    cy_en_syspm_callback_mode_t mode);
+
+#endif /* CY_PDL_H */
+
+/* [] END OF FILE */
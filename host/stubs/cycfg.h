@@ -0,0 +1,70 @@
+/******************************************************************************
+ * File Name: cycfg.h
+ *
+ * Description: Host-side stand-in for the Device Configurator output
+ * (design.modus) used by the application.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CYCFG_H
+#define CYCFG_H
+
+#include "cy_pdl.h"
+
+/* EZI2C (scb[0]) */
+#define CYBSP_EZI2C_HW                  SCB0
+#define CYBSP_EZI2C_IRQ                 scb_0_interrupt_IRQn
+extern const cy_stc_scb_ezi2c_config_t CYBSP_EZI2C_config;
+
+/* Debug UART (scb[1]) */
+#define scb_1_HW                        SCB1
+#define scb_1_IRQ                       scb_1_interrupt_IRQn
+extern const cy_stc_scb_uart_config_t scb_1_config;
+
+/* LED PWM (tcpwm[0].cnt[1]) */
+#define pwm2_HW                         TCPWM
+#define pwm2_NUM                        (1UL)
+#define pwm2_MASK                       (1UL << 1)
+#define pwm2_IRQ                        tcpwm_interrupts_1_IRQn
+extern const cy_stc_tcpwm_pwm_config_t pwm2_config;
+
+/* MSC blocks */
+#define CYBSP_MSC0_HW                   MSC0
+#define CYBSP_MSC1_HW                   MSC1
+
+#endif /* CYCFG_H */
+
+/* [] END OF FILE */
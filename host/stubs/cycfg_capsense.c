@@ -0,0 +1,189 @@
+/******************************************************************************
+ * File Name: cycfg_capsense.c
+ *
+ * Description: Host-side stand-in for the CAPSENSE configuration generated from
+ * design.cycapsense: widget, sensor and scan slot tables of the Touchpad0 and
+ * Proximity0 widgets.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "cycfg_capsense.h"
+
+static const cy_stc_capsense_common_config_t cy_capsense_commonConfig =
+{
+    .numWd = CY_CAPSENSE_WIDGET_COUNT,
+    .numSns = CY_CAPSENSE_SENSOR_COUNT,
+    .numSlots = CY_CAPSENSE_SLOT_COUNT,
+    .numChannels = CY_CAPSENSE_TOTAL_CH_NUMBER,
+};
+
+static const cy_stc_capsense_gesture_config_t cy_capsense_gestureConfig_Touchpad0 =
+{
+    .clickTimeoutMax = 20u,
+    .clickTimeoutMin = 2u,
+    .clickDistanceMax = 60u,
+    .secondClickIntervalMax = 20u,
+    .secondClickIntervalMin = 2u,
+    .secondClickDistanceMax = 100u,
+    .scrollDebounce = 3u,
+    .scrollDistanceMin = 3u,
+    .zoomDebounce = 3u,
+    .zoomDistanceMin = 4u,
+    .flickTimeoutMax = 50u,
+    .flickDistanceMin = 10u,
+};
+
+static cy_stc_capsense_gesture_context_t cy_capsense_gestureContext_Touchpad0;
+
+cy_stc_capsense_tuner_t cy_capsense_tuner =
+{
+    .commonContext =
+    {
+        .configId = 0x5A3Cu,
+        .timestampInterval = 1u,
+    },
+    .widgetContext =
+    {
+        [CY_CAPSENSE_TOUCHPAD0_WDGT_ID] =
+        {
+            .resolution = 160u,
+            .maxRawCount = 11520u,
+            .maxRawCountRow = 11520u,
+            .fingerTh = 58u,
+            .proxTh = 200u,
+            .lowBslnRst = 30u,
+            .snsClk = 96u,
+            .rowSnsClk = 96u,
+            .noiseTh = 28u,
+            .nNoiseTh = 26u,
+            .hysteresis = 5u,
+            .onDebounce = 3u,
+            .cdacRef = 19u,
+            .rowCdacRef = 19u,
+            .cicRate = 1u,
+            .cdacCompDivider = 32u,
+            .numSubConversions = 120u,
+            .bslnCoeff = 1u,
+            .wdTouch = { .ptrPosition = &cy_capsense_tuner.position_Touchpad0[0], .numPosition = 0u },
+        },
+        [CY_CAPSENSE_PROXIMITY0_WDGT_ID] =
+        {
+            .resolution = 100u,
+            .maxRawCount = 65535u,
+            .maxRawCountRow = 65535u,
+            .fingerTh = 13u,
+            .proxTh = 168u,
+            .lowBslnRst = 30u,
+            .snsClk = 60u,
+            .rowSnsClk = 60u,
+            .noiseTh = 7u,
+            .nNoiseTh = 7u,
+            .hysteresis = 2u,
+            .onDebounce = 3u,
+            .cdacRef = 109u,
+            .rowCdacRef = 109u,
+            .cicRate = 64u,
+            .cdacCompDivider = 12u,
+            .numSubConversions = 2300u,
+            .bslnCoeff = 32u,
+        },
+    },
+};
+
+const cy_stc_capsense_widget_config_t cy_capsense_widgetConfig[CY_CAPSENSE_WIDGET_COUNT] =
+{
+    [CY_CAPSENSE_TOUCHPAD0_WDGT_ID] =
+    {
+        .ptrWdContext = &cy_capsense_tuner.widgetContext[CY_CAPSENSE_TOUCHPAD0_WDGT_ID],
+        .ptrSnsContext = &cy_capsense_tuner.sensorContext[0u],
+        .ptrGestureConfig = &cy_capsense_gestureConfig_Touchpad0,
+        .ptrGestureContext = &cy_capsense_gestureContext_Touchpad0,
+        .xResolution = 160u,
+        .yResolution = 100u,
+        .numSns = CY_CAPSENSE_TOUCHPAD0_NUM_SNS,
+        .numCols = CY_CAPSENSE_TOUCHPAD0_NUM_COLS,
+        .numRows = CY_CAPSENSE_TOUCHPAD0_NUM_ROWS,
+        .firstSlotId = 0u,
+        .numSlots = 13u,
+    },
+    [CY_CAPSENSE_PROXIMITY0_WDGT_ID] =
+    {
+        .ptrWdContext = &cy_capsense_tuner.widgetContext[CY_CAPSENSE_PROXIMITY0_WDGT_ID],
+        .ptrSnsContext = &cy_capsense_tuner.sensorContext[CY_CAPSENSE_TOUCHPAD0_NUM_SNS],
+        .xResolution = 100u,
+        .yResolution = 100u,
+        .numSns = 1u,
+        .numCols = 1u,
+        .numRows = 0u,
+        .firstSlotId = 13u,
+        .numSlots = 1u,
+    },
+};
+
+/* Scan order: entry [slot * CY_CAPSENSE_TOTAL_CH_NUMBER + channel] */
+const cy_stc_capsense_scan_slot_t cy_capsense_scanSlots[CY_CAPSENSE_SLOT_COUNT * CY_CAPSENSE_TOTAL_CH_NUMBER] =
+{
+    { 0u,  8u }, { 0u,  0u },
+    { 0u,  9u }, { 0u,  1u },
+    { 0u, 10u }, { 0u,  2u },
+    { 0u, 11u }, { 0u,  3u },
+    { 0u, 12u }, { 0u,  4u },
+    { 0u, 13u }, { 0u,  5u },
+    { 0u, 14u }, { 0u,  6u },
+    { 0u, 15u }, { 0u,  7u },
+    { 0u, 16u }, { 0u, 21u },
+    { 0u, 17u }, { 0u, 22u },
+    { 0u, 18u }, { 0u, 23u },
+    { 0u, 19u }, { 0u, 24u },
+    { 0u, 20u }, { 0u, 25u },
+    { 1u,  0u }, { CY_CAPSENSE_SLOT_SHIELD_ONLY, CY_CAPSENSE_SLOT_SHIELD_ONLY },
+};
+
+/* Sensor frames of the CS_DMA chain: entry [(channel * CY_CAPSENSE_SLOT_COUNT
+ * + slot) * CY_MSC_6_SNS_REGS] */
+static uint32_t cy_capsense_sensorFrameContext[CY_CAPSENSE_TOTAL_CH_NUMBER * CY_CAPSENSE_SLOT_COUNT * CY_MSC_6_SNS_REGS];
+
+cy_stc_capsense_context_t cy_capsense_context =
+{
+    .ptrCommonConfig = &cy_capsense_commonConfig,
+    .ptrCommonContext = &cy_capsense_tuner.commonContext,
+    .ptrWdConfig = cy_capsense_widgetConfig,
+    .ptrWdContext = cy_capsense_tuner.widgetContext,
+    .ptrScanSlots = cy_capsense_scanSlots,
+    .ptrSensorFrameContext = cy_capsense_sensorFrameContext,
+};
+
+/* [] END OF FILE */
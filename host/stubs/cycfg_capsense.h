@@ -0,0 +1,327 @@
+/******************************************************************************
+ * File Name: cycfg_capsense.h
+ *
+ * Description: Host-side stand-in for the CAPSENSE Configurator output
+ * (design.cycapsense) and for the subset of the CAPSENSE middleware API used by
+ * the application. The middleware behaviour is modelled in sim_capsense.c.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CYCFG_CAPSENSE_H
+#define CYCFG_CAPSENSE_H
+
+#include "cy_pdl.h"
+
+/*******************************************************************************
+ * Middleware constants
+ ******************************************************************************/
+typedef uint32_t cy_capsense_status_t;
+
+#define CY_CAPSENSE_MW_VERSION                  (400u)
+
+#define CY_CAPSENSE_STATUS_SUCCESS              (0x00u)
+#define CY_CAPSENSE_STATUS_BAD_PARAM            (0x01u)
+#define CY_CAPSENSE_STATUS_BAD_DATA             (0x02u)
+#define CY_CAPSENSE_STATUS_TIMEOUT              (0x04u)
+#define CY_CAPSENSE_STATUS_INVALID_STATE        (0x08u)
+#define CY_CAPSENSE_STATUS_BAD_CONFIG           (0x10u)
+#define CY_CAPSENSE_STATUS_HW_BUSY              (0x40u)
+
+#define CY_CAPSENSE_NOT_BUSY                    (0x00u)
+#define CY_CAPSENSE_BUSY                        (0x80u)
+
+#define CY_CAPSENSE_SNS_TOUCH_STATUS_MASK       (0x01u)
+#define CY_CAPSENSE_SNS_PROX_STATUS_MASK        (0x02u)
+#define CY_CAPSENSE_WD_ACTIVE_MASK              (0x01u)
+
+#define CY_CAPSENSE_SLOT_EMPTY                  (0xFFFFu)
+#define CY_CAPSENSE_SLOT_SHIELD_ONLY            (0xFFFDu)
+
+/* Gesture bitfield layout */
+#define CY_CAPSENSE_GESTURE_NO_GESTURE                  (0x00u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_SINGLE_CLICK_MASK  (0x0001u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_DOUBLE_CLICK_MASK  (0x0002u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_CLICK_DRAG_MASK    (0x0004u)
+#define CY_CAPSENSE_GESTURE_TWO_FNGR_SINGLE_CLICK_MASK  (0x0008u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_SCROLL_MASK        (0x0010u)
+#define CY_CAPSENSE_GESTURE_TWO_FNGR_SCROLL_MASK        (0x0020u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_EDGE_SWIPE_MASK    (0x0040u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_FLICK_MASK         (0x0080u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_ROTATE_MASK        (0x0100u)
+#define CY_CAPSENSE_GESTURE_TWO_FNGR_ZOOM_MASK          (0x0200u)
+#define CY_CAPSENSE_GESTURE_ONE_FNGR_LONG_PRESS_MASK    (0x0400u)
+#define CY_CAPSENSE_GESTURE_ALL_GESTURES_MASK           (0x07FFu)
+
+#define CY_CAPSENSE_GESTURE_DIRECTION_OFFSET            (16u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL (16u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_TWO_SCROLL (18u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_EDGE   (20u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_ROTATE (22u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_TWO_ZOOM   (23u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_FLICK  (24u)
+
+#define CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_SCROLL   (0x3u << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL)
+#define CY_CAPSENSE_GESTURE_DIRECTION_MASK_TWO_SCROLL   (0x3u << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_TWO_SCROLL)
+#define CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_EDGE     (0x3u << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_EDGE)
+#define CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_ROTATE   (0x1u << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_ROTATE)
+#define CY_CAPSENSE_GESTURE_DIRECTION_MASK_TWO_ZOOM     (0x1u << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_TWO_ZOOM)
+#define CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_FLICK    (0x7u << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_FLICK)
+
+#define CY_CAPSENSE_GESTURE_DIRECTION_UP                (0x00u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_DOWN              (0x01u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_RIGHT             (0x02u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_LEFT              (0x03u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_IN                (0x00u)
+#define CY_CAPSENSE_GESTURE_DIRECTION_OUT               (0x01u)
+
+/*******************************************************************************
+ * Middleware data structures
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t z;
+    uint16_t id;
+} cy_stc_capsense_position_t;
+
+typedef struct
+{
+    cy_stc_capsense_position_t *ptrPosition;
+    uint8_t numPosition;
+} cy_stc_capsense_touch_t;
+
+typedef struct
+{
+    uint16_t raw;
+    uint16_t bsln;
+    uint16_t diff;
+    uint8_t status;
+    uint8_t negBslnRstCnt;
+    uint8_t bslnExt;
+    uint8_t cdacComp;
+} cy_stc_capsense_sensor_context_t;
+
+typedef struct
+{
+    uint16_t fingerCap;
+    uint16_t sigPFC;
+    uint16_t resolution;
+    uint16_t maxRawCount;
+    uint16_t maxRawCountRow;
+    uint16_t fingerTh;
+    uint16_t proxTh;
+    uint16_t lowBslnRst;
+    uint16_t snsClk;
+    uint16_t rowSnsClk;
+    uint16_t gestureDetected;
+    uint16_t gestureDirection;
+    int16_t xDelta;
+    int16_t yDelta;
+    uint16_t noiseTh;
+    uint16_t nNoiseTh;
+    uint16_t hysteresis;
+    uint8_t onDebounce;
+    uint8_t snsClkSource;
+    uint8_t cdacRef;
+    uint8_t rowCdacRef;
+    uint8_t cicRate;
+    uint8_t cdacCompDivider;
+    uint16_t numSubConversions;
+    uint8_t bslnCoeff;
+    uint8_t status;
+    cy_stc_capsense_touch_t wdTouch;
+} cy_stc_capsense_widget_context_t;
+
+typedef struct
+{
+    uint16_t clickTimeoutMax;
+    uint16_t clickTimeoutMin;
+    uint16_t clickDistanceMax;
+    uint16_t secondClickIntervalMax;
+    uint16_t secondClickIntervalMin;
+    uint16_t secondClickDistanceMax;
+    uint16_t scrollDebounce;
+    uint16_t scrollDistanceMin;
+    uint16_t zoomDebounce;
+    uint16_t zoomDistanceMin;
+    uint16_t flickTimeoutMax;
+    uint16_t flickDistanceMin;
+} cy_stc_capsense_gesture_config_t;
+
+typedef struct
+{
+    uint32_t timestamp;
+    uint32_t touchStartTime1;
+    uint32_t lastClickTime;
+    uint16_t touchStartX1;
+    uint16_t touchStartY1;
+    uint16_t lastClickX;
+    uint16_t lastClickY;
+    uint16_t lastX1;
+    uint16_t lastY1;
+    uint16_t lastDistance;
+    uint8_t numPosition;
+    uint8_t maxFingers;
+    uint8_t scrollCount;
+    uint8_t scrollDirection;
+    uint8_t zoomCount;
+    uint8_t zoomDirection;
+    uint8_t clickPending;
+    uint8_t detected;
+} cy_stc_capsense_gesture_context_t;
+
+typedef struct
+{
+    cy_stc_capsense_widget_context_t *ptrWdContext;
+    cy_stc_capsense_sensor_context_t *ptrSnsContext;
+    const cy_stc_capsense_gesture_config_t *ptrGestureConfig;
+    cy_stc_capsense_gesture_context_t *ptrGestureContext;
+    uint16_t xResolution;
+    uint16_t yResolution;
+    uint16_t numSns;
+    uint8_t numCols;
+    uint8_t numRows;
+    uint8_t senseMethod;
+    uint8_t wdType;
+    uint16_t firstSlotId;
+    uint16_t numSlots;
+} cy_stc_capsense_widget_config_t;
+
+typedef struct
+{
+    uint16_t wdId;
+    uint16_t snsId;
+} cy_stc_capsense_scan_slot_t;
+
+typedef struct
+{
+    uint16_t configId;
+    uint16_t tunerCmd;
+    uint16_t scanCounter;
+    uint8_t tunerSt;
+    uint8_t initDone;
+    uint32_t status;
+    uint32_t timestampInterval;
+    uint32_t timestamp;
+    uint16_t numFinishedSlots;
+} cy_stc_capsense_common_context_t;
+
+typedef struct
+{
+    uint16_t numWd;
+    uint16_t numSns;
+    uint16_t numSlots;
+    uint8_t numChannels;
+} cy_stc_capsense_common_config_t;
+
+typedef struct
+{
+    const cy_stc_capsense_common_config_t *ptrCommonConfig;
+    cy_stc_capsense_common_context_t *ptrCommonContext;
+    const cy_stc_capsense_widget_config_t *ptrWdConfig;
+    cy_stc_capsense_widget_context_t *ptrWdContext;
+    const cy_stc_capsense_scan_slot_t *ptrScanSlots;
+    uint32_t *ptrSensorFrameContext;
+} cy_stc_capsense_context_t;
+
+/*******************************************************************************
+ * Generated configuration (design.cycapsense)
+ ******************************************************************************/
+#define CY_CAPSENSE_WIDGET_COUNT                (2u)
+#define CY_CAPSENSE_SENSOR_COUNT                (27u)
+#define CY_CAPSENSE_SLOT_COUNT                  (14u)
+#define CY_CAPSENSE_TOTAL_CH_NUMBER             (2u)
+#define CY_CAPSENSE_MAX_CENTROIDS               (2u)
+
+#define CY_CAPSENSE_TOUCHPAD0_WDGT_ID           (0u)
+#define CY_CAPSENSE_TOUCHPAD0_COL0_ID           (0u)
+#define CY_CAPSENSE_TOUCHPAD0_ROW0_ID           (16u)
+#define CY_CAPSENSE_TOUCHPAD0_NUM_COLS          (16u)
+#define CY_CAPSENSE_TOUCHPAD0_NUM_ROWS          (10u)
+#define CY_CAPSENSE_TOUCHPAD0_NUM_SNS           (26u)
+
+#define CY_CAPSENSE_PROXIMITY0_WDGT_ID          (1u)
+#define CY_CAPSENSE_PROXIMITY0_SNS0_ID          (0u)
+
+#define CY_MSC0_HW                              (MSC0)
+#define CY_MSC1_HW                              (MSC1)
+#define CY_MSC0_IRQ                             (msc_0_interrupt_IRQn)
+#define CY_MSC1_IRQ                             (msc_1_interrupt_IRQn)
+
+typedef struct
+{
+    cy_stc_capsense_common_context_t commonContext;
+    cy_stc_capsense_widget_context_t widgetContext[CY_CAPSENSE_WIDGET_COUNT];
+    cy_stc_capsense_sensor_context_t sensorContext[CY_CAPSENSE_SENSOR_COUNT];
+    cy_stc_capsense_position_t position_Touchpad0[CY_CAPSENSE_MAX_CENTROIDS];
+} cy_stc_capsense_tuner_t;
+
+extern cy_stc_capsense_tuner_t cy_capsense_tuner;
+extern cy_stc_capsense_context_t cy_capsense_context;
+extern const cy_stc_capsense_widget_config_t cy_capsense_widgetConfig[CY_CAPSENSE_WIDGET_COUNT];
+extern const cy_stc_capsense_scan_slot_t cy_capsense_scanSlots[CY_CAPSENSE_SLOT_COUNT * CY_CAPSENSE_TOTAL_CH_NUMBER];
+
+/*******************************************************************************
+ * Middleware API
+ ******************************************************************************/
+cy_capsense_status_t Cy_CapSense_Init(cy_stc_capsense_context_t *context);
+cy_capsense_status_t Cy_CapSense_Enable(cy_stc_capsense_context_t *context);
+cy_capsense_status_t Cy_CapSense_Initialize(cy_stc_capsense_context_t *context);
+void Cy_CapSense_InterruptHandler(MSC_Type *base, cy_stc_capsense_context_t *context);
+cy_capsense_status_t Cy_CapSense_ScanSlots(uint32_t startSlotId, uint32_t numberSlots,
+                                           cy_stc_capsense_context_t *context);
+cy_capsense_status_t Cy_CapSense_ScanAllSlots(cy_stc_capsense_context_t *context);
+cy_capsense_status_t Cy_CapSense_CalibrateWidget(uint32_t widgetId, cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t *context);
+cy_capsense_status_t Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t *context);
+cy_capsense_status_t Cy_CapSense_ProcessAllWidgets(cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_IsSensorActive(uint32_t widgetId, uint32_t sensorId, const cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_IsProximitySensorActive(uint32_t widgetId, uint32_t sensorId,
+                                             const cy_stc_capsense_context_t *context);
+cy_stc_capsense_touch_t *Cy_CapSense_GetTouchInfo(uint32_t widgetId, const cy_stc_capsense_context_t *context);
+void Cy_CapSense_InitializeWidgetBaseline(uint32_t widgetId, cy_stc_capsense_context_t *context);
+void Cy_CapSense_InitializeAllBaselines(cy_stc_capsense_context_t *context);
+void Cy_CapSense_SetGestureTimestamp(uint32_t value, cy_stc_capsense_context_t *context);
+void Cy_CapSense_IncrementGestureTimestamp(cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_DecodeWidgetGestures(uint32_t widgetId, const cy_stc_capsense_context_t *context);
+uint32_t Cy_CapSense_RunTuner(cy_stc_capsense_context_t *context);
+void Cy_CapSense_GenerateAllSensorConfig(uint32_t chId, uint32_t *ptrSensorCfg, cy_stc_capsense_context_t *context);
+
+#endif /* CYCFG_CAPSENSE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * File Name: sim.h
+ *
+ * Description: Control interface of the host-side hardware simulator. The
+ * simulator runs the application against a virtual clock: every modelled
+ * peripheral (WDT, ILO, UART, MSC scan engine) advances that clock instead of
+ * real time, so a run is deterministic and many hours of device time finish in
+ * seconds.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define SIM_NS_PER_US               (1000ULL)
+#define SIM_NS_PER_MS               (1000000ULL)
+#define SIM_NS_PER_S                (1000000000ULL)
+
+/* CPU and MSC modulator clock of the modelled device */
+#define SIM_CPU_HZ                  (48000000UL)
+
+/* Clock of the LED PWM counter before its prescaler */
+#define SIM_PWM_CLK_HZ              (48000000UL)
+
+/* Nominal raw counts of an untouched sensor */
+#define SIM_TP_IDLE_RAW             (9800U)
+#define SIM_PROX_IDLE_RAW           (2000U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* Raw counts of all sensors at one point in time. Touchpad sensors are stored
+ * in widget order: 16 columns followed by 10 rows. */
+typedef struct
+{
+    uint16_t tp[CY_CAPSENSE_TOUCHPAD0_NUM_SNS];
+    uint16_t prox;
+} sim_frame_t;
+
+/* Returns the sensor state at virtual time now_ns. Returns false once the
+ * source is exhausted; the simulator then stops at the next deep sleep entry. */
+typedef bool (*sim_source_fn)(void *arg, uint64_t now_ns, sim_frame_t *frame);
+
+/* Receives every byte transmitted by the debug UART */
+typedef void (*sim_uart_sink_fn)(void *arg, uint8_t byte);
+
+/* Runs at a scheduled virtual time in place of an interrupt, as a DMA
+ * transfer or other bus master activity would */
+typedef void (*sim_call_fn)(uint32_t arg);
+
+/* Called when the scan of a slot range has completed and its raw counts have
+ * been latched into the sensor contexts, before the application sees them */
+typedef void (*sim_scan_hook_fn)(void *arg, uint32_t start_slot, uint32_t num_slots);
+
+typedef struct
+{
+    uint32_t ilo_hz;            /* Actual ILO frequency, nominal is 40 kHz */
+    uint32_t ilo_measure_us;    /* Duration of one ILO compensation measurement */
+    uint32_t max_wakes;         /* Stop after this many WDT wakes, 0 - no limit */
+    uint64_t max_time_ns;       /* Stop after this much virtual time, 0 - no limit */
+    uint64_t tuner_connect_ns;  /* A tuner polls the primary EZI2C address from
+                                 * this virtual time on, 0 - never */
+} sim_config_t;
+
+typedef struct
+{
+    uint64_t now_ns;            /* Virtual time since reset */
+    uint64_t active_ns;         /* CPU active */
+    uint64_t cpu_sleep_ns;      /* CPU Sleep (WFI), peripherals running */
+    uint64_t deep_sleep_ns;     /* System Deep Sleep */
+    uint64_t ilo_wait_ns;       /* Active time spent in ILO compensation */
+    uint64_t uart_wait_ns;      /* Active time blocked on the UART: full FIFO, TX drain */
+    uint64_t delay_ns;          /* Active time spent in Cy_SysLib_Delay */
+    uint32_t wakes;             /* Deep Sleep exits */
+    uint32_t sleep_fails;       /* Deep Sleep entries rejected by a callback */
+    uint32_t scans;             /* Completed MSC scans */
+    uint32_t scan_busy;         /* Scan requests rejected as busy */
+    uint32_t raw_races;         /* Widgets processed while a scan was writing
+                                 * their raw counts */
+    /* Frames processed per widget, and the time from the end of their scan
+     * to their processing: total and longest */
+    uint32_t frames[CY_CAPSENSE_WIDGET_COUNT];
+    uint64_t frame_age_ns[CY_CAPSENSE_WIDGET_COUNT];
+    uint64_t max_frame_age_ns[CY_CAPSENSE_WIDGET_COUNT];
+    uint32_t uart_chars;        /* Bytes transmitted */
+    uint32_t uart_dropped;      /* Bytes written while the UART was disabled */
+    uint32_t uart_restarts;     /* UART disable/enable transitions */
+    uint32_t pm_calls;          /* Power mode callback invocations */
+    uint32_t pwm_restarts;      /* PWM disable/enable transitions */
+    uint32_t pwm_swaps;         /* Compare buffer swaps on terminal count */
+    uint32_t pwm_tc_irqs;       /* Terminal count interrupts raised */
+    uint32_t flash_rows;        /* Flash rows erased and programmed */
+    uint64_t pwm_stalled_ns;    /* Deep Sleep with a non-zero compare: the LED
+                                 * output is frozen or off instead of lit */
+} sim_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+/* Simulator setup */
+void sim_reset(const sim_config_t *config);
+void sim_set_source(sim_source_fn fn, void *arg);
+void sim_set_uart_sink(sim_uart_sink_fn fn, void *arg);
+void sim_set_scan_hook(sim_scan_hook_fn fn, void *arg);
+int sim_run(int (*app)(void));
+void sim_stop(void);
+const sim_stats_t *sim_get_stats(void);
+void sim_print_stats(FILE *out, double host_seconds);
+
+/* Virtual time */
+uint64_t sim_now_ns(void);
+void sim_cpu_ns(uint64_t ns);
+
+/* Peripheral state */
+uint32_t sim_pwm_compare0(void);
+uint32_t sim_gpio_out(GPIO_PRT_Type const *port, uint32_t pin);
+
+/* Writes read-only flash contents of the application, as the flash
+ * controller would; used to load a flash image before the run */
+void sim_flash_write(const void *dst, const void *src, size_t size);
+
+/* Interfaces between the PDL and middleware models */
+bool sim_read_frame(sim_frame_t *frame);
+void sim_schedule_irq(IRQn_Type irq, uint64_t at_ns, bool runs_in_deep_sleep);
+void sim_schedule_call(sim_call_fn fn, uint32_t arg, uint64_t at_ns, bool runs_in_deep_sleep);
+void sim_scan_busy(void);
+void sim_raw_race(void);
+void sim_frame_processed(uint32_t widget_id, uint64_t age_ns);
+void sim_scan_complete(uint32_t start_slot, uint32_t num_slots);
+void sim_capsense_reset(void);
+uint64_t sim_capsense_scan_ns(const cy_stc_capsense_context_t *context, uint32_t start_slot, uint32_t num_slots);
+
+#endif /* SIM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,876 @@
+/******************************************************************************
+ * File Name: sim_capsense.c
+ *
+ * Description: Host-side behavioural model of the CAPSENSE middleware: slot
+ * scanning on the two MSC channels, baseline/difference processing, touchpad
+ * centroid and two-finger detection, and a gesture decoder driven by the
+ * gesture timestamp. The model follows the configuration in cycfg_capsense.c;
+ * it is not bit-exact with the middleware but exercises the same API contract.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Modelled scan engine timing */
+#define SIM_MSC_SLOT_OVERHEAD_NS    (15ULL * SIM_NS_PER_US)
+
+/* Modelled CPU costs of the middleware functions */
+#define SIM_SCAN_START_NS           (8ULL * SIM_NS_PER_US)
+#define SIM_ISR_NS                  (5ULL * SIM_NS_PER_US)
+#define SIM_PROCESS_SNS_NS          (6ULL * SIM_NS_PER_US)
+#define SIM_CENTROID_NS             (40ULL * SIM_NS_PER_US)
+#define SIM_DECODE_NS               (30ULL * SIM_NS_PER_US)
+#define SIM_BSLN_INIT_SNS_NS        (1ULL * SIM_NS_PER_US)
+#define SIM_FRAME_SLOT_NS           (2ULL * SIM_NS_PER_US)
+#define SIM_TUNER_NS                (4ULL * SIM_NS_PER_US)
+#define SIM_CALIBRATION_PASSES      (8U)
+
+/* Raw counts per compensation CDAC code away from the calibrated code */
+#define SIM_CDAC_COMP_COUNTS        (40)
+
+/* Sensor frame register holding the compensation CDAC code */
+#define SIM_FRAME_CDAC_REG          (3U)
+
+/* Two touchpad peaks closer than this many sensors are one finger */
+#define SIM_PEAK_MIN_SEPARATION     (3)
+
+#define SIM_CENTROID_Q              (256)
+
+/*******************************************************************************
+ * Model state
+ ******************************************************************************/
+static cy_stc_capsense_tuner_t tuner_default;
+static bool tuner_saved;
+
+static struct
+{
+    uint32_t pending_channels;
+    uint32_t start_slot;
+    uint32_t num_slots;
+    uint32_t next_slot;         /* First slot whose raw counts are not written yet */
+    cy_stc_capsense_context_t *context;
+    uint64_t latched_ns[CY_CAPSENSE_WIDGET_COUNT];  /* Last raw count written */
+    uint8_t debounce[CY_CAPSENSE_SENSOR_COUNT];
+    bool cdac_modelled;     /* Raw counts follow the CDAC codes: set once the
+                             * middleware is enabled */
+} msc;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static bool slot_entry_is_sensor(const cy_stc_capsense_scan_slot_t *entry)
+{
+    return (entry->wdId < CY_CAPSENSE_WIDGET_COUNT);
+}
+
+static uint64_t slot_duration_ns(const cy_stc_capsense_context_t *context, uint32_t slot)
+{
+    uint64_t longest = 0U;
+
+    for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+    {
+        const cy_stc_capsense_scan_slot_t *entry = &context->ptrScanSlots[(slot * CY_CAPSENSE_TOTAL_CH_NUMBER) + ch];
+
+        if (slot_entry_is_sensor(entry))
+        {
+            const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[entry->wdId];
+            const cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+            uint32_t clk = (entry->snsId >= wd->numCols) ? wdc->rowSnsClk : wdc->snsClk;
+            uint64_t ns = ((uint64_t)wdc->numSubConversions * clk * SIM_NS_PER_S) / SIM_CPU_HZ;
+
+            if (ns > longest)
+            {
+                longest = ns;
+            }
+        }
+    }
+    return longest + SIM_MSC_SLOT_OVERHEAD_NS;
+}
+
+static uint16_t frame_raw(const sim_frame_t *frame, const cy_stc_capsense_scan_slot_t *entry)
+{
+    return (CY_CAPSENSE_TOUCHPAD0_WDGT_ID == entry->wdId) ? frame->tp[entry->snsId] : frame->prox;
+}
+
+/* Compensation CDAC code that calibration finds for a sensor */
+static uint8_t calibrated_cdac_comp(uint32_t index)
+{
+    return (uint8_t)(32U + ((index * 5U) % 48U));
+}
+
+/* The scan uses the CDAC code of the sensor frame, not the one in the sensor
+ * context: a code written to the context takes effect once the frames are
+ * generated again */
+static uint16_t cdac_raw(uint16_t raw, uint32_t frame_cdac, uint32_t index)
+{
+    int32_t value = (int32_t)raw;
+
+    if (msc.cdac_modelled)
+    {
+        value += ((int32_t)frame_cdac - (int32_t)calibrated_cdac_comp(index)) * SIM_CDAC_COMP_COUNTS;
+    }
+    return (uint16_t)((value < 0) ? 0 : ((value > 0xFFFF) ? 0xFFFF : value));
+}
+
+static void write_frames(const cy_stc_capsense_context_t *context, uint32_t ch, uint32_t *regs)
+{
+    for (uint32_t slot = 0U; slot < CY_CAPSENSE_SLOT_COUNT; slot++)
+    {
+        const cy_stc_capsense_scan_slot_t *entry = &context->ptrScanSlots[(slot * CY_CAPSENSE_TOTAL_CH_NUMBER) + ch];
+
+        memset(regs, 0, CY_MSC_6_SNS_REGS * sizeof(uint32_t));
+        if (slot_entry_is_sensor(entry))
+        {
+            regs[SIM_FRAME_CDAC_REG] = context->ptrWdConfig[entry->wdId].ptrSnsContext[entry->snsId].cdacComp;
+        }
+        regs += CY_MSC_6_SNS_REGS;
+    }
+}
+
+/* Frame generation inside the middleware calls; its time is part of theirs */
+static void generate_frames(cy_stc_capsense_context_t *context)
+{
+    for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+    {
+        write_frames(context, ch, &context->ptrSensorFrameContext[ch * CY_CAPSENSE_SLOT_COUNT * CY_MSC_6_SNS_REGS]);
+    }
+}
+
+static void calibrate_widget(cy_stc_capsense_context_t *context, uint32_t widgetId)
+{
+    const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[widgetId];
+    uint32_t first = (uint32_t)(wd->ptrSnsContext - context->ptrWdConfig[0].ptrSnsContext);
+
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        wd->ptrSnsContext[i].cdacComp = calibrated_cdac_comp(first + i);
+    }
+    generate_frames(context);
+}
+
+static void latch_slots(cy_stc_capsense_context_t *context, uint32_t start, uint32_t count)
+{
+    sim_frame_t frame;
+
+    (void)sim_read_frame(&frame);
+    for (uint32_t slot = start; slot < (start + count); slot++)
+    {
+        for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+        {
+            const cy_stc_capsense_scan_slot_t *entry = &context->ptrScanSlots[(slot * CY_CAPSENSE_TOTAL_CH_NUMBER) + ch];
+
+            if (slot_entry_is_sensor(entry))
+            {
+                const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[entry->wdId];
+                cy_stc_capsense_sensor_context_t *sns = &wd->ptrSnsContext[entry->snsId];
+
+                uint32_t frame_cdac = context->ptrSensorFrameContext[(((ch * CY_CAPSENSE_SLOT_COUNT) + slot) * CY_MSC_6_SNS_REGS) +
+                                                                     SIM_FRAME_CDAC_REG];
+
+                sns->raw = cdac_raw(frame_raw(&frame, entry), frame_cdac,
+                                    (uint32_t)(sns - context->ptrWdConfig[0].ptrSnsContext));
+                msc.latched_ns[entry->wdId] = sim_now_ns();
+            }
+        }
+    }
+}
+
+/* The scan engine writes the raw counts of each slot as soon as the slot is
+ * converted, as the DMA does in CS_DMA mode, not at the end of the scan */
+static void slot_done(uint32_t slot)
+{
+    cy_stc_capsense_context_t *context = msc.context;
+
+    latch_slots(context, slot, 1U);
+    msc.next_slot = slot + 1U;
+    if (msc.next_slot < (msc.start_slot + msc.num_slots))
+    {
+        sim_schedule_call(slot_done, msc.next_slot, sim_now_ns() + slot_duration_ns(context, msc.next_slot), false);
+    }
+}
+
+/* True while a scan that writes raw counts of the widget is in flight */
+static bool scan_writes_widget(const cy_stc_capsense_context_t *context, uint32_t widgetId)
+{
+    if (0U == msc.pending_channels)
+    {
+        return false;
+    }
+    for (uint32_t slot = msc.next_slot; slot < (msc.start_slot + msc.num_slots); slot++)
+    {
+        for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+        {
+            if (widgetId == context->ptrScanSlots[(slot * CY_CAPSENSE_TOTAL_CH_NUMBER) + ch].wdId)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static uint32_t sns_index(const cy_stc_capsense_context_t *context, uint32_t widgetId, uint32_t sensorId)
+{
+    return (uint32_t)(context->ptrWdConfig[widgetId].ptrSnsContext - context->ptrWdConfig[0].ptrSnsContext) + sensorId;
+}
+
+static void update_baseline(cy_stc_capsense_sensor_context_t *sns, const cy_stc_capsense_widget_context_t *wdc)
+{
+    int32_t acc = ((int32_t)sns->bsln << 8) | sns->bslnExt;
+    int32_t target = (int32_t)sns->raw << 8;
+
+    acc += ((target - acc) * (int32_t)wdc->bslnCoeff) / 256;
+    sns->bsln = (uint16_t)(acc >> 8);
+    sns->bslnExt = (uint8_t)(acc & 0xFF);
+}
+
+static void process_sensor(cy_stc_capsense_sensor_context_t *sns, const cy_stc_capsense_widget_context_t *wdc,
+                           uint8_t *debounce, uint16_t threshold, uint8_t mask)
+{
+    if (sns->raw >= sns->bsln)
+    {
+        sns->diff = (uint16_t)(sns->raw - sns->bsln);
+        sns->negBslnRstCnt = 0U;
+        if ((sns->diff < wdc->noiseTh) && (0U == (sns->status & mask)))
+        {
+            update_baseline(sns, wdc);
+        }
+    }
+    else
+    {
+        sns->diff = 0U;
+        if ((uint32_t)(sns->bsln - sns->raw) > wdc->nNoiseTh)
+        {
+            sns->negBslnRstCnt++;
+            if (sns->negBslnRstCnt >= wdc->lowBslnRst)
+            {
+                sns->bsln = sns->raw;
+                sns->bslnExt = 0U;
+                sns->negBslnRstCnt = 0U;
+            }
+        }
+        else
+        {
+            update_baseline(sns, wdc);
+        }
+    }
+
+    if (0U != (sns->status & mask))
+    {
+        if ((uint32_t)sns->diff + wdc->hysteresis < threshold)
+        {
+            sns->status &= (uint8_t)~mask;
+        }
+        *debounce = 0U;
+    }
+    else if ((uint32_t)sns->diff >= ((uint32_t)threshold + wdc->hysteresis))
+    {
+        (*debounce)++;
+        if (*debounce >= wdc->onDebounce)
+        {
+            sns->status |= mask;
+            *debounce = 0U;
+        }
+    }
+    else
+    {
+        *debounce = 0U;
+    }
+}
+
+/* Finds up to two separated local maxima at or above the threshold */
+static uint32_t find_peaks(const cy_stc_capsense_sensor_context_t *sns, uint32_t count, uint16_t threshold,
+                           uint32_t peaks[2])
+{
+    uint32_t found = 0U;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        uint16_t d = sns[i].diff;
+        bool left_ok = (0U == i) || (sns[i - 1U].diff <= d);
+        bool right_ok = ((i + 1U) == count) || (sns[i + 1U].diff < d);
+
+        if ((d >= threshold) && left_ok && right_ok)
+        {
+            if ((found > 0U) && ((int32_t)(i - peaks[found - 1U]) < SIM_PEAK_MIN_SEPARATION))
+            {
+                if (d > sns[peaks[found - 1U]].diff)
+                {
+                    peaks[found - 1U] = i;
+                }
+            }
+            else if (found < 2U)
+            {
+                peaks[found++] = i;
+            }
+            else if (d > sns[peaks[1]].diff)
+            {
+                peaks[1] = i;
+            }
+        }
+    }
+    return found;
+}
+
+static uint16_t centroid(const cy_stc_capsense_sensor_context_t *sns, uint32_t count, uint32_t peak,
+                         uint16_t resolution)
+{
+    int32_t left = (peak > 0U) ? (int32_t)sns[peak - 1U].diff : 0;
+    int32_t center = (int32_t)sns[peak].diff;
+    int32_t right = ((peak + 1U) < count) ? (int32_t)sns[peak + 1U].diff : 0;
+    int32_t pos = ((int32_t)peak * SIM_CENTROID_Q) + (((right - left) * SIM_CENTROID_Q) / (left + center + right));
+    int32_t scaled = (pos * (int32_t)resolution) / ((int32_t)(count - 1U) * SIM_CENTROID_Q);
+
+    if (scaled < 0)
+    {
+        scaled = 0;
+    }
+    if (scaled > (int32_t)resolution)
+    {
+        scaled = (int32_t)resolution;
+    }
+    return (uint16_t)scaled;
+}
+
+static void process_touchpad(const cy_stc_capsense_widget_config_t *wd)
+{
+    cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+    const cy_stc_capsense_sensor_context_t *cols = &wd->ptrSnsContext[0];
+    const cy_stc_capsense_sensor_context_t *rows = &wd->ptrSnsContext[wd->numCols];
+    cy_stc_capsense_position_t *pos = wdc->wdTouch.ptrPosition;
+    uint32_t col_peaks[2];
+    uint32_t row_peaks[2];
+    uint32_t ncol;
+    uint32_t nrow;
+    bool col_active = false;
+    bool row_active = false;
+
+    for (uint32_t i = 0U; i < wd->numCols; i++)
+    {
+        col_active |= (0U != (cols[i].status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK));
+    }
+    for (uint32_t i = 0U; i < wd->numRows; i++)
+    {
+        row_active |= (0U != (rows[i].status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK));
+    }
+
+    wdc->wdTouch.numPosition = 0U;
+    wdc->status = 0U;
+    if (!col_active || !row_active)
+    {
+        return;
+    }
+
+    ncol = find_peaks(cols, wd->numCols, wdc->fingerTh, col_peaks);
+    nrow = find_peaks(rows, wd->numRows, wdc->fingerTh, row_peaks);
+    if ((0U == ncol) || (0U == nrow))
+    {
+        return;
+    }
+    if (ncol < 2U)
+    {
+        col_peaks[1] = col_peaks[0];
+    }
+    if (nrow < 2U)
+    {
+        row_peaks[1] = row_peaks[0];
+    }
+
+    wdc->wdTouch.numPosition = (uint8_t)(((ncol > nrow) ? ncol : nrow));
+    for (uint32_t i = 0U; i < wdc->wdTouch.numPosition; i++)
+    {
+        pos[i].x = centroid(cols, wd->numCols, col_peaks[i], wd->xResolution);
+        pos[i].y = centroid(rows, wd->numRows, row_peaks[i], wd->yResolution);
+        pos[i].z = (uint16_t)(((uint32_t)cols[col_peaks[i]].diff + rows[row_peaks[i]].diff) / 2U);
+        pos[i].id = (uint16_t)i;
+    }
+    wdc->status = CY_CAPSENSE_WD_ACTIVE_MASK;
+}
+
+static uint32_t direction_of(int32_t dx, int32_t dy, uint32_t *distance)
+{
+    if (abs(dx) > abs(dy))
+    {
+        *distance = (uint32_t)abs(dx);
+        return (dx >= 0) ? CY_CAPSENSE_GESTURE_DIRECTION_RIGHT : CY_CAPSENSE_GESTURE_DIRECTION_LEFT;
+    }
+    *distance = (uint32_t)abs(dy);
+    return (dy >= 0) ? CY_CAPSENSE_GESTURE_DIRECTION_DOWN : CY_CAPSENSE_GESTURE_DIRECTION_UP;
+}
+
+/*******************************************************************************
+ * Scan timing
+ ******************************************************************************/
+uint64_t sim_capsense_scan_ns(const cy_stc_capsense_context_t *context, uint32_t start_slot, uint32_t num_slots)
+{
+    uint64_t ns = 0U;
+
+    for (uint32_t slot = start_slot; slot < (start_slot + num_slots); slot++)
+    {
+        ns += slot_duration_ns(context, slot);
+    }
+    return ns;
+}
+
+/*******************************************************************************
+ * Model reset
+ ******************************************************************************/
+void sim_capsense_reset(void)
+{
+    if (!tuner_saved)
+    {
+        tuner_default = cy_capsense_tuner;
+        tuner_saved = true;
+    }
+    cy_capsense_tuner = tuner_default;
+    memset(&msc, 0, sizeof(msc));
+    memset(cy_capsense_widgetConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrGestureContext, 0,
+           sizeof(cy_stc_capsense_gesture_context_t));
+}
+
+/*******************************************************************************
+ * Middleware API
+ ******************************************************************************/
+cy_capsense_status_t Cy_CapSense_Init(cy_stc_capsense_context_t *context)
+{
+    context->ptrCommonContext->initDone = 0U;
+    memset(&msc, 0, sizeof(msc));
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_Enable(cy_stc_capsense_context_t *context)
+{
+    uint64_t frame_ns = 0U;
+
+    /* CDAC auto-calibration: repeated scans of every slot */
+    for (uint32_t slot = 0U; slot < CY_CAPSENSE_SLOT_COUNT; slot++)
+    {
+        frame_ns += slot_duration_ns(context, slot);
+    }
+    sim_cpu_ns(frame_ns * SIM_CALIBRATION_PASSES);
+    for (uint32_t wd = 0U; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        calibrate_widget(context, wd);
+    }
+    msc.cdac_modelled = true;
+
+    latch_slots(context, 0U, CY_CAPSENSE_SLOT_COUNT);
+    sim_scan_complete(0U, CY_CAPSENSE_SLOT_COUNT);
+    Cy_CapSense_InitializeAllBaselines(context);
+    context->ptrCommonContext->initDone = 1U;
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_Initialize(cy_stc_capsense_context_t *context)
+{
+    /* Cy_CapSense_Enable() without the calibration and the first scan: the
+     * sensor frames are generated from the CDAC codes left in the widget and
+     * sensor contexts */
+    generate_frames(context);
+    msc.cdac_modelled = true;
+    context->ptrCommonContext->initDone = 1U;
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+void Cy_CapSense_InterruptHandler(MSC_Type *base, cy_stc_capsense_context_t *context)
+{
+    sim_cpu_ns(SIM_ISR_NS);
+    if (0U == (msc.pending_channels & (1UL << base->idx)))
+    {
+        return;
+    }
+
+    msc.pending_channels &= ~(1UL << base->idx);
+    if (0U == msc.pending_channels)
+    {
+        /* The slots were written as they completed */
+        if (msc.next_slot < (msc.start_slot + msc.num_slots))
+        {
+            latch_slots(context, msc.next_slot, (msc.start_slot + msc.num_slots) - msc.next_slot);
+            msc.next_slot = msc.start_slot + msc.num_slots;
+        }
+        context->ptrCommonContext->numFinishedSlots = (uint16_t)(msc.start_slot + msc.num_slots);
+        context->ptrCommonContext->scanCounter++;
+        sim_scan_complete(msc.start_slot, msc.num_slots);
+    }
+}
+
+cy_capsense_status_t Cy_CapSense_ScanSlots(uint32_t startSlotId, uint32_t numberSlots,
+                                           cy_stc_capsense_context_t *context)
+{
+    uint64_t duration = 0U;
+    uint32_t channels = 0U;
+
+    if ((0U == numberSlots) || ((startSlotId + numberSlots) > CY_CAPSENSE_SLOT_COUNT))
+    {
+        return CY_CAPSENSE_STATUS_BAD_PARAM;
+    }
+    if (0U != msc.pending_channels)
+    {
+        sim_scan_busy();
+        return CY_CAPSENSE_STATUS_HW_BUSY;
+    }
+
+    for (uint32_t slot = startSlotId; slot < (startSlotId + numberSlots); slot++)
+    {
+        duration += slot_duration_ns(context, slot);
+        for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+        {
+            if (CY_CAPSENSE_SLOT_EMPTY != context->ptrScanSlots[(slot * CY_CAPSENSE_TOTAL_CH_NUMBER) + ch].wdId)
+            {
+                channels |= (1UL << ch);
+            }
+        }
+    }
+
+    msc.start_slot = startSlotId;
+    msc.num_slots = numberSlots;
+    msc.next_slot = startSlotId;
+    msc.context = context;
+    msc.pending_channels = channels;
+    context->ptrCommonContext->numFinishedSlots = (uint16_t)startSlotId;
+    sim_cpu_ns(SIM_SCAN_START_NS);
+
+    sim_schedule_call(slot_done, startSlotId, sim_now_ns() + slot_duration_ns(context, startSlotId), false);
+
+    for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+    {
+        if (0U != (channels & (1UL << ch)))
+        {
+            sim_schedule_irq((0U == ch) ? CY_MSC0_IRQ : CY_MSC1_IRQ, sim_now_ns() + duration, false);
+        }
+    }
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_ScanAllSlots(cy_stc_capsense_context_t *context)
+{
+    return Cy_CapSense_ScanSlots(0U, CY_CAPSENSE_SLOT_COUNT, context);
+}
+
+cy_capsense_status_t Cy_CapSense_CalibrateWidget(uint32_t widgetId, cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_config_t *wd;
+    cy_stc_capsense_widget_context_t *wdc;
+
+    if (widgetId >= CY_CAPSENSE_WIDGET_COUNT)
+    {
+        return CY_CAPSENSE_STATUS_BAD_PARAM;
+    }
+    if (0U != msc.pending_channels)
+    {
+        return CY_CAPSENSE_STATUS_HW_BUSY;
+    }
+
+    /* CDAC calibration for the current sense clock: blocking scans of the
+     * widget, the last one is left in the raw counts */
+    wd = &context->ptrWdConfig[widgetId];
+    wdc = wd->ptrWdContext;
+    wdc->maxRawCount = (uint16_t)(wdc->numSubConversions * wdc->snsClk);
+    wdc->maxRawCountRow = (uint16_t)(wdc->numSubConversions * wdc->rowSnsClk);
+    sim_cpu_ns(sim_capsense_scan_ns(context, wd->firstSlotId, wd->numSlots) * SIM_CALIBRATION_PASSES);
+    calibrate_widget(context, widgetId);
+    latch_slots(context, wd->firstSlotId, wd->numSlots);
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+uint32_t Cy_CapSense_IsBusy(const cy_stc_capsense_context_t *context)
+{
+    (void)context;
+    return (0U != msc.pending_channels) ? CY_CAPSENSE_BUSY : CY_CAPSENSE_NOT_BUSY;
+}
+
+cy_capsense_status_t Cy_CapSense_ProcessWidget(uint32_t widgetId, cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_config_t *wd;
+    cy_stc_capsense_widget_context_t *wdc;
+    uint32_t first;
+
+    if (widgetId >= CY_CAPSENSE_WIDGET_COUNT)
+    {
+        return CY_CAPSENSE_STATUS_BAD_PARAM;
+    }
+
+    wd = &context->ptrWdConfig[widgetId];
+    wdc = wd->ptrWdContext;
+    first = sns_index(context, widgetId, 0U);
+
+    /* The raw counts being processed may be overwritten at any time */
+    if (scan_writes_widget(context, widgetId))
+    {
+        sim_raw_race();
+    }
+    sim_frame_processed(widgetId, sim_now_ns() - msc.latched_ns[widgetId]);
+
+    if (CY_CAPSENSE_PROXIMITY0_WDGT_ID == widgetId)
+    {
+        process_sensor(&wd->ptrSnsContext[0], wdc, &msc.debounce[first], wdc->proxTh,
+                       CY_CAPSENSE_SNS_PROX_STATUS_MASK);
+        wdc->status = (0U != wd->ptrSnsContext[0].status) ? CY_CAPSENSE_WD_ACTIVE_MASK : 0U;
+    }
+    else
+    {
+        for (uint32_t i = 0U; i < wd->numSns; i++)
+        {
+            process_sensor(&wd->ptrSnsContext[i], wdc, &msc.debounce[first + i], wdc->fingerTh,
+                           CY_CAPSENSE_SNS_TOUCH_STATUS_MASK);
+        }
+        process_touchpad(wd);
+        sim_cpu_ns(SIM_CENTROID_NS);
+    }
+    sim_cpu_ns(SIM_PROCESS_SNS_NS * wd->numSns);
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+cy_capsense_status_t Cy_CapSense_ProcessAllWidgets(cy_stc_capsense_context_t *context)
+{
+    for (uint32_t wd = 0U; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        (void)Cy_CapSense_ProcessWidget(wd, context);
+    }
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+uint32_t Cy_CapSense_IsWidgetActive(uint32_t widgetId, const cy_stc_capsense_context_t *context)
+{
+    return context->ptrWdContext[widgetId].status & CY_CAPSENSE_WD_ACTIVE_MASK;
+}
+
+uint32_t Cy_CapSense_IsSensorActive(uint32_t widgetId, uint32_t sensorId, const cy_stc_capsense_context_t *context)
+{
+    return context->ptrWdConfig[widgetId].ptrSnsContext[sensorId].status & CY_CAPSENSE_SNS_TOUCH_STATUS_MASK;
+}
+
+uint32_t Cy_CapSense_IsProximitySensorActive(uint32_t widgetId, uint32_t sensorId,
+                                             const cy_stc_capsense_context_t *context)
+{
+    return context->ptrWdConfig[widgetId].ptrSnsContext[sensorId].status & CY_CAPSENSE_SNS_PROX_STATUS_MASK;
+}
+
+cy_stc_capsense_touch_t *Cy_CapSense_GetTouchInfo(uint32_t widgetId, const cy_stc_capsense_context_t *context)
+{
+    return &context->ptrWdContext[widgetId].wdTouch;
+}
+
+void Cy_CapSense_InitializeWidgetBaseline(uint32_t widgetId, cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[widgetId];
+
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        wd->ptrSnsContext[i].bsln = wd->ptrSnsContext[i].raw;
+        wd->ptrSnsContext[i].bslnExt = 0U;
+        wd->ptrSnsContext[i].negBslnRstCnt = 0U;
+    }
+    sim_cpu_ns(SIM_BSLN_INIT_SNS_NS * wd->numSns);
+}
+
+void Cy_CapSense_InitializeAllBaselines(cy_stc_capsense_context_t *context)
+{
+    for (uint32_t wd = 0U; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        Cy_CapSense_InitializeWidgetBaseline(wd, context);
+    }
+}
+
+void Cy_CapSense_SetGestureTimestamp(uint32_t value, cy_stc_capsense_context_t *context)
+{
+    context->ptrCommonContext->timestamp = value;
+}
+
+void Cy_CapSense_IncrementGestureTimestamp(cy_stc_capsense_context_t *context)
+{
+    context->ptrCommonContext->timestamp += context->ptrCommonContext->timestampInterval;
+}
+
+uint32_t Cy_CapSense_DecodeWidgetGestures(uint32_t widgetId, const cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[widgetId];
+    const cy_stc_capsense_gesture_config_t *cfg = wd->ptrGestureConfig;
+    cy_stc_capsense_gesture_context_t *g = wd->ptrGestureContext;
+    const cy_stc_capsense_touch_t *touch = &wd->ptrWdContext->wdTouch;
+    const cy_stc_capsense_position_t *pos = touch->ptrPosition;
+    uint32_t t = context->ptrCommonContext->timestamp;
+    uint32_t n = touch->numPosition;
+    uint32_t gesture = CY_CAPSENSE_GESTURE_NO_GESTURE;
+    uint32_t dir;
+    uint32_t distance;
+
+    if ((NULL == cfg) || (NULL == g))
+    {
+        return CY_CAPSENSE_GESTURE_NO_GESTURE;
+    }
+    sim_cpu_ns(SIM_DECODE_NS);
+
+    if ((n > 0U) && (0U == g->numPosition))
+    {
+        /* Touchdown */
+        g->touchStartTime1 = t;
+        g->touchStartX1 = pos[0].x;
+        g->touchStartY1 = pos[0].y;
+        g->lastX1 = pos[0].x;
+        g->lastY1 = pos[0].y;
+        g->maxFingers = (uint8_t)n;
+        g->scrollCount = 0U;
+        g->zoomCount = 0U;
+        g->detected = 0U;
+        g->lastDistance = (uint16_t)(abs((int32_t)pos[0].x - pos[n - 1U].x) + abs((int32_t)pos[0].y - pos[n - 1U].y));
+    }
+
+    if (n > 0U)
+    {
+        if (n > g->maxFingers)
+        {
+            g->maxFingers = (uint8_t)n;
+        }
+
+        if ((1U == n) && (1U == g->maxFingers))
+        {
+            dir = direction_of((int32_t)pos[0].x - g->lastX1, (int32_t)pos[0].y - g->lastY1, &distance);
+            if (distance >= cfg->scrollDistanceMin)
+            {
+                g->scrollCount = ((g->scrollCount > 0U) && (dir == g->scrollDirection)) ? (uint8_t)(g->scrollCount + 1U) : 1U;
+                g->scrollDirection = (uint8_t)dir;
+                if (g->scrollCount >= cfg->scrollDebounce)
+                {
+                    gesture = CY_CAPSENSE_GESTURE_ONE_FNGR_SCROLL_MASK | (dir << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL);
+                    g->detected = 1U;
+                }
+            }
+            else
+            {
+                g->scrollCount = 0U;
+            }
+            g->lastX1 = pos[0].x;
+            g->lastY1 = pos[0].y;
+        }
+        else if (2U == n)
+        {
+            uint32_t span = (uint32_t)(abs((int32_t)pos[0].x - pos[1].x) + abs((int32_t)pos[0].y - pos[1].y));
+            int32_t change = (int32_t)span - (int32_t)g->lastDistance;
+
+            if ((uint32_t)abs(change) >= cfg->zoomDistanceMin)
+            {
+                dir = (change > 0) ? CY_CAPSENSE_GESTURE_DIRECTION_IN : CY_CAPSENSE_GESTURE_DIRECTION_OUT;
+                g->zoomCount = ((g->zoomCount > 0U) && (dir == g->zoomDirection)) ? (uint8_t)(g->zoomCount + 1U) : 1U;
+                g->zoomDirection = (uint8_t)dir;
+                if (g->zoomCount >= cfg->zoomDebounce)
+                {
+                    gesture = CY_CAPSENSE_GESTURE_TWO_FNGR_ZOOM_MASK | (dir << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_TWO_ZOOM);
+                    g->detected = 1U;
+                }
+            }
+            g->lastDistance = (uint16_t)span;
+        }
+        else
+        {
+            /* Finger count changed mid-touch */
+        }
+    }
+    else if (g->numPosition > 0U)
+    {
+        /* Liftoff */
+        uint32_t duration = t - g->touchStartTime1;
+
+        dir = direction_of((int32_t)g->lastX1 - g->touchStartX1, (int32_t)g->lastY1 - g->touchStartY1, &distance);
+        if (g->maxFingers >= 2U)
+        {
+            if ((0U == g->detected) && (duration >= cfg->clickTimeoutMin) && (duration <= cfg->clickTimeoutMax))
+            {
+                gesture = CY_CAPSENSE_GESTURE_TWO_FNGR_SINGLE_CLICK_MASK;
+            }
+        }
+        else if ((duration <= cfg->flickTimeoutMax) && (distance >= cfg->flickDistanceMin))
+        {
+            gesture = CY_CAPSENSE_GESTURE_ONE_FNGR_FLICK_MASK | (dir << CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_FLICK);
+        }
+        else if ((0U == g->detected) && (distance <= cfg->clickDistanceMax) &&
+                 (duration >= cfg->clickTimeoutMin) && (duration <= cfg->clickTimeoutMax))
+        {
+            uint32_t interval = g->touchStartTime1 - g->lastClickTime;
+            uint32_t spread = (uint32_t)(abs((int32_t)g->touchStartX1 - g->lastClickX) +
+                                         abs((int32_t)g->touchStartY1 - g->lastClickY));
+
+            if ((0U != g->clickPending) && (interval >= cfg->secondClickIntervalMin) &&
+                (interval <= cfg->secondClickIntervalMax) && (spread <= cfg->secondClickDistanceMax))
+            {
+                gesture = CY_CAPSENSE_GESTURE_ONE_FNGR_DOUBLE_CLICK_MASK;
+                g->clickPending = 0U;
+            }
+            else
+            {
+                gesture = CY_CAPSENSE_GESTURE_ONE_FNGR_SINGLE_CLICK_MASK;
+                g->clickPending = 1U;
+                g->lastClickTime = t;
+                g->lastClickX = g->lastX1;
+                g->lastClickY = g->lastY1;
+            }
+        }
+        else
+        {
+            /* Long or slow touch without a gesture */
+        }
+    }
+    else
+    {
+        /* No touch */
+    }
+
+    g->numPosition = (uint8_t)n;
+    wd->ptrWdContext->gestureDetected = (uint16_t)(gesture & CY_CAPSENSE_GESTURE_ALL_GESTURES_MASK);
+    wd->ptrWdContext->gestureDirection = (uint16_t)(gesture >> CY_CAPSENSE_GESTURE_DIRECTION_OFFSET);
+    return gesture;
+}
+
+uint32_t Cy_CapSense_RunTuner(cy_stc_capsense_context_t *context)
+{
+    (void)context;
+    sim_cpu_ns(SIM_TUNER_NS);
+    return CY_CAPSENSE_STATUS_SUCCESS;
+}
+
+void Cy_CapSense_GenerateAllSensorConfig(uint32_t chId, uint32_t *ptrSensorCfg, cy_stc_capsense_context_t *context)
+{
+    write_frames(context, chId, ptrSensorCfg);
+    sim_cpu_ns(SIM_FRAME_SLOT_NS * CY_CAPSENSE_SLOT_COUNT);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,1481 @@
+/******************************************************************************
+ * File Name: sim_pdl.c
+ *
+ * Description: Host-side models of the PSoC 4 peripherals used by the
+ * application: interrupt controller, SysPm, ILO/WDT, debug UART, TCPWM, GPIO
+ * and EZI2C. All timing is expressed on the virtual clock of the simulator.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "sim.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define SIM_MAX_CALLBACKS           (16U)
+#define SIM_MAX_EVENTS              (8U)
+#define SIM_NO_EVENT                (UINT64_MAX)
+
+#define SIM_WDT_COUNTER_MASK        (0xFFFFU)
+#define SIM_WDT_DEFAULT_MATCH       (4096U)
+#define SIM_UART_FIFO_DEPTH         (8U)
+
+/* Modelled CPU costs */
+#define SIM_DEEP_SLEEP_WAKEUP_NS    (35ULL * SIM_NS_PER_US)
+#define SIM_ILO_POLL_NS             (2ULL * SIM_NS_PER_US)
+#define SIM_UART_PUT_NS             (1ULL * SIM_NS_PER_US)
+#define SIM_UART_POLL_NS            (1ULL * SIM_NS_PER_US)
+#define SIM_FLASH_ROW_WRITE_NS      (20ULL * SIM_NS_PER_MS)
+
+/* Defaults of the simulator configuration */
+#define SIM_DEFAULT_ILO_HZ          (40000UL)
+#define SIM_DEFAULT_ILO_MEASURE_US  (1000UL)
+
+typedef enum
+{
+    SIM_CPU_ACTIVE,
+    SIM_CPU_SLEEP,
+    SIM_CPU_DEEP_SLEEP
+} sim_cpu_state_t;
+
+typedef struct
+{
+    bool used;
+    bool runs_in_deep_sleep;
+    IRQn_Type irq;
+    sim_call_fn fn;             /* Called instead of raising irq when set */
+    uint32_t arg;
+    uint64_t at_ns;
+} sim_event_t;
+
+/*******************************************************************************
+ * Peripheral instances
+ ******************************************************************************/
+CySCB_Type sim_scb[2] = { { 0U }, { 1U } };
+TCPWM_Type sim_tcpwm[1] = { { 0U } };
+MSC_Type sim_msc[2] = { { 0U }, { 1U } };
+GPIO_PRT_Type sim_gpio[8] = { { 0U }, { 1U }, { 2U }, { 3U }, { 4U }, { 5U }, { 6U }, { 7U } };
+
+/*******************************************************************************
+ * Simulator state
+ ******************************************************************************/
+static sim_config_t sim_cfg;
+static sim_stats_t sim_stats;
+static jmp_buf sim_exit;
+static bool sim_running;
+static bool sim_stop_requested;
+static bool sim_source_done;
+static int sim_exit_code;
+
+static sim_source_fn source_fn;
+static void *source_arg;
+static sim_frame_t source_frame;
+
+static sim_uart_sink_fn uart_sink_fn;
+static void *uart_sink_arg;
+static sim_scan_hook_fn scan_hook_fn;
+static void *scan_hook_arg;
+
+/* NVIC */
+static cy_israddress irq_handler[SIM_IRQ_COUNT];
+static bool irq_enabled[SIM_IRQ_COUNT];
+static bool irq_pending[SIM_IRQ_COUNT];
+static bool primask;
+static uint32_t isr_depth;
+static sim_event_t events[SIM_MAX_EVENTS];
+
+/* SysPm */
+static cy_stc_syspm_callback_t *pm_callbacks[SIM_MAX_CALLBACKS];
+static uint32_t pm_callback_count;
+
+/* ILO and WDT */
+static struct
+{
+    bool ilo_enabled;
+    bool measuring;
+    uint64_t measure_done_ns;
+    bool enabled;
+    bool masked;
+    uint64_t t0_ns;
+    uint32_t match;
+} wdt;
+
+/* Debug UART */
+static struct
+{
+    bool enabled;
+    uint64_t char_ns;
+    uint64_t line_free_ns;
+    uint32_t tx_level;
+    uint32_t tx_mask;
+} uart;
+
+/* TCPWM counter used as the LED PWM. The counter is clocked in Active and
+ * Sleep only; its time base leaves out Deep Sleep. */
+static struct
+{
+    bool enabled;
+    bool running;
+    bool was_disabled;
+    bool swap_pending;
+    uint32_t prescaler;
+    uint32_t period0;
+    uint32_t compare0;
+    uint32_t compare1;
+    uint32_t intr_mask;
+    uint32_t intr_status;
+    uint64_t next_tc_ns;        /* Next terminal count, in counter time */
+} pwm;
+
+static void pwm_sync(void);
+
+/* SysTick, clocked by the CPU clock: counts in Active and Sleep only */
+static struct
+{
+    bool enabled;
+    uint32_t reload;
+    uint64_t t0_cycles;
+} systick;
+
+static uint8_t gpio_out[8];
+
+/*******************************************************************************
+ * Virtual clock
+ ******************************************************************************/
+static uint64_t ilo_ticks(uint64_t t_ns)
+{
+    return (uint64_t)(((unsigned __int128)(t_ns - wdt.t0_ns) * sim_cfg.ilo_hz) / SIM_NS_PER_S);
+}
+
+static uint64_t ilo_tick_time(uint64_t ticks)
+{
+    unsigned __int128 scaled = (unsigned __int128)ticks * SIM_NS_PER_S;
+    return wdt.t0_ns + (uint64_t)((scaled + sim_cfg.ilo_hz - 1U) / sim_cfg.ilo_hz);
+}
+
+static uint64_t wdt_next_match_ns(void)
+{
+    if (!wdt.enabled)
+    {
+        return SIM_NO_EVENT;
+    }
+
+    uint64_t now_ticks = ilo_ticks(sim_stats.now_ns);
+    uint32_t delta = (wdt.match - (uint32_t)now_ticks) & SIM_WDT_COUNTER_MASK;
+
+    if (0U == delta)
+    {
+        delta = SIM_WDT_COUNTER_MASK + 1U;
+    }
+    return ilo_tick_time(now_ticks + delta);
+}
+
+/* TX FIFO level interrupt: the FIFO holds fewer than tx_level entries. The
+ * character in the shifter is not counted. */
+static bool uart_tx_level_reached(void)
+{
+    return (sim_stats.now_ns + ((uint64_t)uart.tx_level * uart.char_ns)) >= uart.line_free_ns;
+}
+
+/* Next time a masked TX interrupt source becomes active */
+static uint64_t uart_next_irq_ns(void)
+{
+    uint64_t next = SIM_NO_EVENT;
+
+    if (uart.enabled && (0U == Cy_SCB_GetTxInterruptStatusMasked(SCB1)))
+    {
+        if (0U != (uart.tx_mask & CY_SCB_TX_INTR_LEVEL))
+        {
+            next = uart.line_free_ns - ((uint64_t)uart.tx_level * uart.char_ns);
+        }
+        if ((0U != (uart.tx_mask & CY_SCB_TX_INTR_UART_DONE)) && (uart.line_free_ns < next))
+        {
+            next = uart.line_free_ns;
+        }
+    }
+    return next;
+}
+
+static void uart_check_irq(void)
+{
+    if (0U != Cy_SCB_GetTxInterruptStatusMasked(SCB1))
+    {
+        irq_pending[scb_1_interrupt_IRQn] = true;
+    }
+}
+
+static uint64_t next_event_ns(sim_cpu_state_t state)
+{
+    uint64_t next = wdt_next_match_ns();
+    uint64_t uart_next = uart_next_irq_ns();
+
+    if (uart_next < next)
+    {
+        next = uart_next;
+    }
+
+    for (uint32_t i = 0U; i < SIM_MAX_EVENTS; i++)
+    {
+        if (events[i].used && ((SIM_CPU_DEEP_SLEEP != state) || events[i].runs_in_deep_sleep) &&
+            (events[i].at_ns < next))
+        {
+            next = events[i].at_ns;
+        }
+    }
+    return next;
+}
+
+static void account(uint64_t ns, sim_cpu_state_t state)
+{
+    switch (state)
+    {
+    case SIM_CPU_ACTIVE:
+        sim_stats.active_ns += ns;
+        break;
+    case SIM_CPU_SLEEP:
+        sim_stats.cpu_sleep_ns += ns;
+        break;
+    default:
+        sim_stats.deep_sleep_ns += ns;
+        pwm_sync();
+        if (0U != pwm.compare0)
+        {
+            sim_stats.pwm_stalled_ns += ns;
+        }
+        /* Scan engines and other high-frequency peripherals are frozen */
+        for (uint32_t i = 0U; i < SIM_MAX_EVENTS; i++)
+        {
+            if (events[i].used && !events[i].runs_in_deep_sleep)
+            {
+                events[i].at_ns += ns;
+            }
+        }
+        break;
+    }
+}
+
+static void fire_events(void)
+{
+    if (wdt.enabled)
+    {
+        uint64_t now_ticks = ilo_ticks(sim_stats.now_ns);
+
+        if ((((uint32_t)now_ticks & SIM_WDT_COUNTER_MASK) == (wdt.match & SIM_WDT_COUNTER_MASK)) &&
+            (ilo_tick_time(now_ticks) == sim_stats.now_ns) && !wdt.masked)
+        {
+            irq_pending[srss_interrupt_wdt_IRQn] = true;
+        }
+    }
+
+    for (uint32_t i = 0U; i < SIM_MAX_EVENTS; i++)
+    {
+        if (events[i].used && (events[i].at_ns <= sim_stats.now_ns))
+        {
+            events[i].used = false;
+            if (NULL != events[i].fn)
+            {
+                events[i].fn(events[i].arg);
+            }
+            else
+            {
+                irq_pending[events[i].irq] = true;
+            }
+        }
+    }
+
+    uart_check_irq();
+}
+
+static bool irq_ready(void)
+{
+    for (uint32_t i = 0U; i < SIM_IRQ_COUNT; i++)
+    {
+        if (irq_pending[i] && irq_enabled[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void dispatch_irqs(void)
+{
+    if (primask || (0U != isr_depth))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0U; i < SIM_IRQ_COUNT; i++)
+    {
+        if (irq_pending[i] && irq_enabled[i] && (NULL != irq_handler[i]))
+        {
+            irq_pending[i] = false;
+            isr_depth++;
+            irq_handler[i]();
+            isr_depth--;
+            i = 0U;
+        }
+    }
+}
+
+static void check_stop(void)
+{
+    if (sim_stop_requested || sim_source_done ||
+        ((0U != sim_cfg.max_wakes) && (sim_stats.wakes >= sim_cfg.max_wakes)) ||
+        ((0U != sim_cfg.max_time_ns) && (sim_stats.now_ns >= sim_cfg.max_time_ns)))
+    {
+        longjmp(sim_exit, 1);
+    }
+}
+
+static void advance_active(uint64_t ns)
+{
+    uint64_t target = sim_stats.now_ns + ns;
+
+    while (sim_stats.now_ns < target)
+    {
+        uint64_t next = next_event_ns(SIM_CPU_ACTIVE);
+
+        if (next > target)
+        {
+            next = target;
+        }
+        account(next - sim_stats.now_ns, SIM_CPU_ACTIVE);
+        sim_stats.now_ns = next;
+        fire_events();
+        dispatch_irqs();
+    }
+}
+
+static void sleep_until_irq(sim_cpu_state_t state)
+{
+    while (!irq_ready())
+    {
+        uint64_t next = next_event_ns(state);
+
+        if (SIM_NO_EVENT == next)
+        {
+            fprintf(stderr, "sim: CPU entered low-power mode with no wake-up source\n");
+            sim_exit_code = 3;
+            longjmp(sim_exit, 1);
+        }
+        account(next - sim_stats.now_ns, state);
+        sim_stats.now_ns = next;
+        fire_events();
+    }
+}
+
+/*******************************************************************************
+ * Simulator control
+ ******************************************************************************/
+void sim_reset(const sim_config_t *config)
+{
+    memset(&sim_cfg, 0, sizeof(sim_cfg));
+    if (NULL != config)
+    {
+        sim_cfg = *config;
+    }
+    if (0U == sim_cfg.ilo_hz)
+    {
+        sim_cfg.ilo_hz = SIM_DEFAULT_ILO_HZ;
+    }
+    if (0U == sim_cfg.ilo_measure_us)
+    {
+        sim_cfg.ilo_measure_us = SIM_DEFAULT_ILO_MEASURE_US;
+    }
+
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    memset(irq_handler, 0, sizeof(irq_handler));
+    memset(irq_enabled, 0, sizeof(irq_enabled));
+    memset(irq_pending, 0, sizeof(irq_pending));
+    memset(events, 0, sizeof(events));
+    memset(pm_callbacks, 0, sizeof(pm_callbacks));
+    memset(&wdt, 0, sizeof(wdt));
+    memset(&uart, 0, sizeof(uart));
+    memset(&systick, 0, sizeof(systick));
+    memset(&pwm, 0, sizeof(pwm));
+    memset(gpio_out, 0, sizeof(gpio_out));
+
+    pm_callback_count = 0U;
+    primask = false;
+    isr_depth = 0U;
+    sim_running = false;
+    sim_stop_requested = false;
+    sim_source_done = false;
+    sim_exit_code = 0;
+    source_fn = NULL;
+    source_arg = NULL;
+    uart_sink_fn = NULL;
+    uart_sink_arg = NULL;
+    scan_hook_fn = NULL;
+    scan_hook_arg = NULL;
+
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+    {
+        source_frame.tp[i] = SIM_TP_IDLE_RAW;
+    }
+    source_frame.prox = SIM_PROX_IDLE_RAW;
+
+    sim_capsense_reset();
+}
+
+void sim_set_source(sim_source_fn fn, void *arg)
+{
+    source_fn = fn;
+    source_arg = arg;
+}
+
+void sim_set_uart_sink(sim_uart_sink_fn fn, void *arg)
+{
+    uart_sink_fn = fn;
+    uart_sink_arg = arg;
+}
+
+void sim_set_scan_hook(sim_scan_hook_fn fn, void *arg)
+{
+    scan_hook_fn = fn;
+    scan_hook_arg = arg;
+}
+
+int sim_run(int (*app)(void))
+{
+    sim_running = true;
+    if (0 == setjmp(sim_exit))
+    {
+        (void)app();
+    }
+    sim_running = false;
+    return sim_exit_code;
+}
+
+void sim_stop(void)
+{
+    sim_stop_requested = true;
+}
+
+const sim_stats_t *sim_get_stats(void)
+{
+    return &sim_stats;
+}
+
+void sim_print_stats(FILE *out, double host_seconds)
+{
+    const sim_stats_t *s = &sim_stats;
+    double wakes = (0U != s->wakes) ? (double)s->wakes : 1.0;
+
+    fprintf(out, "virtual time        : %.3f s\n", (double)s->now_ns / SIM_NS_PER_S);
+    fprintf(out, "wakes               : %u\n", s->wakes);
+    fprintf(out, "active time         : %.3f ms (%.1f us/wake)\n",
+            (double)s->active_ns / SIM_NS_PER_MS, (double)s->active_ns / SIM_NS_PER_US / wakes);
+    fprintf(out, "  ilo compensation  : %.3f ms\n", (double)s->ilo_wait_ns / SIM_NS_PER_MS);
+    fprintf(out, "  sleep delay       : %.3f ms\n", (double)s->delay_ns / SIM_NS_PER_MS);
+    fprintf(out, "  uart blocked      : %.3f ms\n", (double)s->uart_wait_ns / SIM_NS_PER_MS);
+    fprintf(out, "cpu sleep time      : %.3f ms\n", (double)s->cpu_sleep_ns / SIM_NS_PER_MS);
+    fprintf(out, "deep sleep time     : %.3f ms\n", (double)s->deep_sleep_ns / SIM_NS_PER_MS);
+    fprintf(out, "scans               : %u (%u rejected busy, %u raw count races)\n", s->scans, s->scan_busy,
+            s->raw_races);
+    for (uint32_t wd = 0U; wd < CY_CAPSENSE_WIDGET_COUNT; wd++)
+    {
+        double frames = (0U != s->frames[wd]) ? (double)s->frames[wd] : 1.0;
+
+        fprintf(out, "%-20s: %u frames, %.3f ms mean, %.3f ms max from scan end to processing\n",
+                (CY_CAPSENSE_TOUCHPAD0_WDGT_ID == wd) ? "touchpad latency" : "proximity latency", s->frames[wd],
+                (double)s->frame_age_ns[wd] / SIM_NS_PER_MS / frames,
+                (double)s->max_frame_age_ns[wd] / SIM_NS_PER_MS);
+    }
+    fprintf(out, "uart bytes          : %u (%u dropped, %u restarts)\n", s->uart_chars, s->uart_dropped,
+            s->uart_restarts);
+    fprintf(out, "pm callbacks        : %u calls (%.1f/wake)\n", s->pm_calls, (double)s->pm_calls / wakes);
+    fprintf(out, "pwm restarts        : %u\n", s->pwm_restarts);
+    fprintf(out, "flash rows written  : %u\n", s->flash_rows);
+    fprintf(out, "pwm                 : %u compare swaps, %u TC interrupts, %.3f ms stalled lit in deep sleep\n",
+            s->pwm_swaps, s->pwm_tc_irqs, (double)s->pwm_stalled_ns / SIM_NS_PER_MS);
+    if (host_seconds > 0.0)
+    {
+        fprintf(out, "host time           : %.3f s (%.0f wakes/s, %.0f ns/wake)\n",
+                host_seconds, wakes / host_seconds, host_seconds * 1e9 / wakes);
+    }
+}
+
+uint64_t sim_now_ns(void)
+{
+    return sim_stats.now_ns;
+}
+
+void sim_cpu_ns(uint64_t ns)
+{
+    advance_active(ns);
+    if (sim_running && (0U == isr_depth) &&
+        (0U != sim_cfg.max_time_ns) && (sim_stats.now_ns >= sim_cfg.max_time_ns))
+    {
+        longjmp(sim_exit, 1);
+    }
+}
+
+void sim_schedule_irq(IRQn_Type irq, uint64_t at_ns, bool runs_in_deep_sleep)
+{
+    for (uint32_t i = 0U; i < SIM_MAX_EVENTS; i++)
+    {
+        if (!events[i].used)
+        {
+            events[i].used = true;
+            events[i].irq = irq;
+            events[i].fn = NULL;
+            events[i].at_ns = at_ns;
+            events[i].runs_in_deep_sleep = runs_in_deep_sleep;
+            return;
+        }
+    }
+    CY_ASSERT(0);
+}
+
+void sim_schedule_call(sim_call_fn fn, uint32_t arg, uint64_t at_ns, bool runs_in_deep_sleep)
+{
+    for (uint32_t i = 0U; i < SIM_MAX_EVENTS; i++)
+    {
+        if (!events[i].used)
+        {
+            events[i].used = true;
+            events[i].fn = fn;
+            events[i].arg = arg;
+            events[i].at_ns = at_ns;
+            events[i].runs_in_deep_sleep = runs_in_deep_sleep;
+            return;
+        }
+    }
+    CY_ASSERT(0);
+}
+
+void sim_scan_busy(void)
+{
+    sim_stats.scan_busy++;
+}
+
+void sim_raw_race(void)
+{
+    sim_stats.raw_races++;
+}
+
+void sim_frame_processed(uint32_t widget_id, uint64_t age_ns)
+{
+    sim_stats.frames[widget_id]++;
+    sim_stats.frame_age_ns[widget_id] += age_ns;
+    if (age_ns > sim_stats.max_frame_age_ns[widget_id])
+    {
+        sim_stats.max_frame_age_ns[widget_id] = age_ns;
+    }
+}
+
+void sim_scan_complete(uint32_t start_slot, uint32_t num_slots)
+{
+    sim_stats.scans++;
+    if (NULL != scan_hook_fn)
+    {
+        scan_hook_fn(scan_hook_arg, start_slot, num_slots);
+    }
+}
+
+bool sim_read_frame(sim_frame_t *frame)
+{
+    bool fresh = false;
+
+    if ((NULL != source_fn) && !sim_source_done)
+    {
+        sim_frame_t next = source_frame;
+
+        if (source_fn(source_arg, sim_stats.now_ns, &next))
+        {
+            source_frame = next;
+            fresh = true;
+        }
+        else
+        {
+            sim_source_done = true;
+        }
+    }
+    *frame = source_frame;
+    return fresh;
+}
+
+uint32_t sim_pwm_compare0(void)
+{
+    pwm_sync();
+    return (pwm.enabled && pwm.running) ? pwm.compare0 : 0U;
+}
+
+uint32_t sim_gpio_out(GPIO_PRT_Type const *port, uint32_t pin)
+{
+    return (gpio_out[port->idx] >> pin) & 1U;
+}
+
+void sim_assert_failed(const char *file, int line)
+{
+    fprintf(stderr, "sim: assertion failed at %s:%d\n", file, line);
+    sim_exit_code = 2;
+    if (sim_running)
+    {
+        longjmp(sim_exit, 1);
+    }
+    abort();
+}
+
+/*******************************************************************************
+ * BSP and core
+ ******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+void __enable_irq(void)
+{
+    primask = false;
+    dispatch_irqs();
+}
+
+void __disable_irq(void)
+{
+    primask = true;
+}
+
+void __WFI(void)
+{
+    sleep_until_irq(SIM_CPU_SLEEP);
+    dispatch_irqs();
+}
+
+void __NOP(void)
+{
+}
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    irq_enabled[IRQn] = true;
+    dispatch_irqs();
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    irq_enabled[IRQn] = false;
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    irq_pending[IRQn] = false;
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    irq_pending[IRQn] = true;
+    dispatch_irqs();
+}
+
+/*******************************************************************************
+ * SysLib
+ ******************************************************************************/
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+    sim_stats.delay_ns += milliseconds * SIM_NS_PER_MS;
+    sim_cpu_ns(milliseconds * SIM_NS_PER_MS);
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    sim_stats.delay_ns += microseconds * SIM_NS_PER_US;
+    sim_cpu_ns(microseconds * SIM_NS_PER_US);
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    uint32_t saved = primask ? 1U : 0U;
+
+    primask = true;
+    return saved;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    primask = (0U != savedIntrStatus);
+    dispatch_irqs();
+}
+
+/*******************************************************************************
+ * SysInt
+ ******************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t* config, cy_israddress userIsr)
+{
+    if ((NULL == config) || ((uint32_t)config->intrSrc >= (uint32_t)SIM_IRQ_COUNT))
+    {
+        return CY_SYSINT_BAD_PARAM;
+    }
+    irq_handler[config->intrSrc] = userIsr;
+    return CY_SYSINT_SUCCESS;
+}
+
+/*******************************************************************************
+ * SysPm
+ ******************************************************************************/
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t *handler)
+{
+    uint32_t pos;
+
+    if ((NULL == handler) || (pm_callback_count >= SIM_MAX_CALLBACKS))
+    {
+        return false;
+    }
+    for (uint32_t i = 0U; i < pm_callback_count; i++)
+    {
+        if (pm_callbacks[i] == handler)
+        {
+            return false;
+        }
+    }
+
+    /* Keep the list sorted by order, registration order within equal order */
+    pos = pm_callback_count;
+    while ((pos > 0U) && (pm_callbacks[pos - 1U]->order > handler->order))
+    {
+        pm_callbacks[pos] = pm_callbacks[pos - 1U];
+        pos--;
+    }
+    pm_callbacks[pos] = handler;
+    pm_callback_count++;
+    return true;
+}
+
+static cy_en_syspm_status_t run_callback(cy_stc_syspm_callback_t *cb, cy_en_syspm_callback_mode_t mode)
+{
+    if (0U != (cb->skipMode & (uint32_t)mode))
+    {
+        return CY_SYSPM_SUCCESS;
+    }
+    sim_stats.pm_calls++;
+    return cb->callback(cb->callbackParams, mode);
+}
+
+static cy_en_syspm_status_t enter_low_power(cy_en_syspm_callback_type_t type, sim_cpu_state_t state)
+{
+    uint32_t saved = Cy_SysLib_EnterCriticalSection();
+    uint32_t ready = 0U;
+
+    for (ready = 0U; ready < pm_callback_count; ready++)
+    {
+        cy_stc_syspm_callback_t *cb = pm_callbacks[ready];
+
+        if ((cb->type == type) && (CY_SYSPM_SUCCESS != run_callback(cb, CY_SYSPM_CHECK_READY)))
+        {
+            /* Roll back the callbacks that already reported ready */
+            while (ready > 0U)
+            {
+                ready--;
+                if (pm_callbacks[ready]->type == type)
+                {
+                    (void)run_callback(pm_callbacks[ready], CY_SYSPM_CHECK_FAIL);
+                }
+            }
+            sim_stats.sleep_fails++;
+            Cy_SysLib_ExitCriticalSection(saved);
+            return CY_SYSPM_FAIL;
+        }
+    }
+
+    for (uint32_t i = 0U; i < pm_callback_count; i++)
+    {
+        if (pm_callbacks[i]->type == type)
+        {
+            (void)run_callback(pm_callbacks[i], CY_SYSPM_BEFORE_TRANSITION);
+        }
+    }
+
+    sleep_until_irq(state);
+    if (SIM_CPU_DEEP_SLEEP == state)
+    {
+        sim_stats.wakes++;
+        advance_active(SIM_DEEP_SLEEP_WAKEUP_NS);
+    }
+
+    for (uint32_t i = pm_callback_count; i > 0U; i--)
+    {
+        if (pm_callbacks[i - 1U]->type == type)
+        {
+            (void)run_callback(pm_callbacks[i - 1U], CY_SYSPM_AFTER_TRANSITION);
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(saved);
+    return CY_SYSPM_SUCCESS;
+}
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void)
+{
+    check_stop();
+    return enter_low_power(CY_SYSPM_SLEEP, SIM_CPU_SLEEP);
+}
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void)
+{
+    check_stop();
+    return enter_low_power(CY_SYSPM_DEEPSLEEP, SIM_CPU_DEEP_SLEEP);
+}
+
+/*******************************************************************************
+ * SysClk
+ ******************************************************************************/
+void Cy_SysClk_IloEnable(void)
+{
+    wdt.ilo_enabled = true;
+}
+
+void Cy_SysClk_WcoDisable(void)
+{
+}
+
+void Cy_SysClk_IloStartMeasurement(void)
+{
+    wdt.measuring = false;
+}
+
+void Cy_SysClk_IloStopMeasurement(void)
+{
+    wdt.measuring = false;
+}
+
+cy_en_sysclk_status_t Cy_SysClk_IloCompensate(uint32_t desiredDelay, uint32_t *compensatedCycles)
+{
+    if (!wdt.ilo_enabled)
+    {
+        return CY_SYSCLK_INVALID_STATE;
+    }
+
+    if (!wdt.measuring)
+    {
+        sim_stats.ilo_wait_ns += SIM_ILO_POLL_NS;
+        sim_cpu_ns(SIM_ILO_POLL_NS);
+        wdt.measuring = true;
+        wdt.measure_done_ns = sim_stats.now_ns + (sim_cfg.ilo_measure_us * SIM_NS_PER_US);
+        return CY_SYSCLK_STARTED;
+    }
+    if (sim_stats.now_ns < wdt.measure_done_ns)
+    {
+        /* Callers poll until the measurement completes. Charge all remaining
+         * polls at once, rounded up to whole polls; interrupts that fall in
+         * between are still serviced on time by sim_cpu_ns(). */
+        uint64_t polls = ((wdt.measure_done_ns - sim_stats.now_ns) + SIM_ILO_POLL_NS - 1U) / SIM_ILO_POLL_NS;
+
+        sim_stats.ilo_wait_ns += polls * SIM_ILO_POLL_NS;
+        sim_cpu_ns(polls * SIM_ILO_POLL_NS);
+        return CY_SYSCLK_STARTED;
+    }
+
+    sim_stats.ilo_wait_ns += SIM_ILO_POLL_NS;
+    sim_cpu_ns(SIM_ILO_POLL_NS);
+
+    wdt.measuring = false;
+    *compensatedCycles = (uint32_t)(((uint64_t)desiredDelay * sim_cfg.ilo_hz) / 1000000ULL);
+    return CY_SYSCLK_SUCCESS;
+}
+
+uint32_t Cy_SysClk_ClkSysGetFrequency(void)
+{
+    return SIM_CPU_HZ;
+}
+
+/*******************************************************************************
+ * SysTick
+ ******************************************************************************/
+static uint64_t systick_cycles(void)
+{
+    return ((sim_stats.active_ns + sim_stats.cpu_sleep_ns) * (SIM_CPU_HZ / 1000000UL)) / SIM_NS_PER_US;
+}
+
+void Cy_SysTick_SetClockSource(cy_en_systick_clock_source_t clockSource)
+{
+    /* Only the CPU clock is modelled */
+    (void)clockSource;
+}
+
+void Cy_SysTick_SetReload(uint32_t value)
+{
+    systick.reload = value & CY_SYSTICK_RELOAD_MAX;
+}
+
+void Cy_SysTick_Clear(void)
+{
+    systick.t0_cycles = systick_cycles();
+}
+
+void Cy_SysTick_Enable(void)
+{
+    if (!systick.enabled)
+    {
+        systick.enabled = true;
+        systick.t0_cycles = systick_cycles();
+    }
+}
+
+void Cy_SysTick_Disable(void)
+{
+    systick.enabled = false;
+}
+
+uint32_t Cy_SysTick_GetValue(void)
+{
+    if (!systick.enabled)
+    {
+        return 0U;
+    }
+    /* Down-counter that reloads after reaching zero */
+    return systick.reload - (uint32_t)((systick_cycles() - systick.t0_cycles) % ((uint64_t)systick.reload + 1U));
+}
+
+/*******************************************************************************
+ * WDT
+ ******************************************************************************/
+void Cy_WDT_Init(void)
+{
+    wdt.match = SIM_WDT_DEFAULT_MATCH;
+    wdt.masked = true;
+}
+
+void Cy_WDT_Enable(void)
+{
+    if (!wdt.enabled)
+    {
+        wdt.enabled = true;
+        wdt.t0_ns = sim_stats.now_ns;
+    }
+}
+
+void Cy_WDT_Disable(void)
+{
+    wdt.enabled = false;
+}
+
+void Cy_WDT_SetMatch(uint32_t match)
+{
+    wdt.match = match & SIM_WDT_COUNTER_MASK;
+}
+
+uint32_t Cy_WDT_GetMatch(void)
+{
+    return wdt.match;
+}
+
+uint32_t Cy_WDT_GetCount(void)
+{
+    return wdt.enabled ? ((uint32_t)ilo_ticks(sim_stats.now_ns) & SIM_WDT_COUNTER_MASK) : 0U;
+}
+
+void Cy_WDT_ClearInterrupt(void)
+{
+    irq_pending[srss_interrupt_wdt_IRQn] = false;
+}
+
+void Cy_WDT_MaskInterrupt(void)
+{
+    wdt.masked = true;
+}
+
+void Cy_WDT_UnmaskInterrupt(void)
+{
+    wdt.masked = false;
+}
+
+/*******************************************************************************
+ * Flash
+ ******************************************************************************/
+void sim_flash_write(const void *dst, const void *src, size_t size)
+{
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)dst & ~(page - 1U);
+
+    /* Flash contents are const data of the application; the pages are left
+     * writable, as they may be shared with other data */
+    if (0 != mprotect((void *)start, ((uintptr_t)dst + size) - start, PROT_READ | PROT_WRITE))
+    {
+        perror("sim flash");
+        exit(1);
+    }
+    memcpy((void *)(uintptr_t)dst, src, size);
+}
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t* data)
+{
+    if ((0U != (rowAddr % CY_FLASH_SIZEOF_ROW)) || (NULL == data))
+    {
+        return CY_FLASH_DRV_INVALID_INPUT_PARAMETERS;
+    }
+
+    /* Erase and program stall the CPU */
+    sim_cpu_ns(SIM_FLASH_ROW_WRITE_NS);
+    sim_flash_write((const void *)(uintptr_t)rowAddr, data, CY_FLASH_SIZEOF_ROW);
+    sim_stats.flash_rows++;
+    return CY_FLASH_DRV_SUCCESS;
+}
+
+/*******************************************************************************
+ * GPIO
+ ******************************************************************************/
+void Cy_GPIO_Write(GPIO_PRT_Type* base, uint32_t pinNum, uint32_t value)
+{
+    gpio_out[base->idx] = (uint8_t)((gpio_out[base->idx] & ~(1U << pinNum)) | ((value & 1U) << pinNum));
+}
+
+uint32_t Cy_GPIO_ReadOut(GPIO_PRT_Type* base, uint32_t pinNum)
+{
+    return (gpio_out[base->idx] >> pinNum) & 1U;
+}
+
+void Cy_GPIO_Inv(GPIO_PRT_Type* base, uint32_t pinNum)
+{
+    gpio_out[base->idx] ^= (uint8_t)(1U << pinNum);
+}
+
+/*******************************************************************************
+ * TCPWM
+ ******************************************************************************/
+/* Counter time: Active and Sleep only */
+static uint64_t pwm_now_ns(void)
+{
+    return sim_stats.active_ns + sim_stats.cpu_sleep_ns;
+}
+
+static uint64_t pwm_period_ns(void)
+{
+    return (((uint64_t)pwm.period0 + 1U) * ((uint64_t)1U << pwm.prescaler) * SIM_NS_PER_S) / SIM_PWM_CLK_HZ;
+}
+
+/* Brings the counter up to the present: a terminal count sets the TC
+ * interrupt and applies a pending compare swap */
+static void pwm_sync(void)
+{
+    uint64_t now = pwm_now_ns();
+
+    if (!pwm.running || (now < pwm.next_tc_ns))
+    {
+        return;
+    }
+
+    pwm.next_tc_ns += (((now - pwm.next_tc_ns) / pwm_period_ns()) + 1U) * pwm_period_ns();
+    pwm.intr_status |= CY_TCPWM_INT_ON_TC;
+    if (pwm.swap_pending)
+    {
+        uint32_t compare = pwm.compare0;
+
+        pwm.compare0 = pwm.compare1;
+        pwm.compare1 = compare;
+        pwm.swap_pending = false;
+        sim_stats.pwm_swaps++;
+    }
+}
+
+/* Raises the interrupt at the next terminal count */
+static void pwm_schedule_tc(void)
+{
+    if (pwm.running && (0U != (pwm.intr_mask & CY_TCPWM_INT_ON_TC)))
+    {
+        sim_schedule_irq(pwm2_IRQ, sim_stats.now_ns + (pwm.next_tc_ns - pwm_now_ns()), false);
+        sim_stats.pwm_tc_irqs++;
+    }
+}
+
+cy_en_tcpwm_status_t Cy_TCPWM_PWM_Init(TCPWM_Type *base, uint32_t cntNum, cy_stc_tcpwm_pwm_config_t const *config)
+{
+    (void)base;
+    (void)cntNum;
+    pwm.prescaler = config->clockPrescaler;
+    pwm.period0 = config->period0;
+    pwm.compare0 = config->compare0;
+    pwm.compare1 = config->compare1;
+    pwm.intr_mask = config->interruptSources;
+    return CY_TCPWM_SUCCESS;
+}
+
+void Cy_TCPWM_PWM_Enable(TCPWM_Type *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+    if (pwm.was_disabled)
+    {
+        sim_stats.pwm_restarts++;
+        pwm.was_disabled = false;
+    }
+    pwm.enabled = true;
+}
+
+void Cy_TCPWM_PWM_Disable(TCPWM_Type *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+    pwm.enabled = false;
+    pwm.running = false;
+    pwm.was_disabled = true;
+}
+
+void Cy_TCPWM_TriggerStart(TCPWM_Type *base, uint32_t counters)
+{
+    (void)base;
+    if ((0U != (counters & pwm2_MASK)) && pwm.enabled && !pwm.running)
+    {
+        pwm.running = true;
+        pwm.next_tc_ns = pwm_now_ns() + pwm_period_ns();
+        pwm_schedule_tc();
+    }
+}
+
+void Cy_TCPWM_TriggerCaptureOrSwap(TCPWM_Type *base, uint32_t counters)
+{
+    (void)base;
+    if (0U != (counters & pwm2_MASK))
+    {
+        pwm_sync();
+        pwm.swap_pending = true;
+    }
+}
+
+void Cy_TCPWM_PWM_SetCompare0(TCPWM_Type *base, uint32_t cntNum, uint32_t compare0)
+{
+    (void)base;
+    (void)cntNum;
+    pwm_sync();
+    pwm.compare0 = compare0 & 0xFFFFU;
+}
+
+uint32_t Cy_TCPWM_PWM_GetCompare0(TCPWM_Type const *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+    pwm_sync();
+    return pwm.compare0;
+}
+
+void Cy_TCPWM_PWM_SetCompare1(TCPWM_Type *base, uint32_t cntNum, uint32_t compare1)
+{
+    (void)base;
+    (void)cntNum;
+    pwm_sync();
+    pwm.compare1 = compare1 & 0xFFFFU;
+}
+
+uint32_t Cy_TCPWM_PWM_GetCompare1(TCPWM_Type const *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+    pwm_sync();
+    return pwm.compare1;
+}
+
+uint32_t Cy_TCPWM_PWM_GetPeriod0(TCPWM_Type const *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+    return pwm.period0;
+}
+
+void Cy_TCPWM_SetInterruptMask(TCPWM_Type *base, uint32_t cntNum, uint32_t source)
+{
+    bool was_masked = (0U == (pwm.intr_mask & CY_TCPWM_INT_ON_TC));
+
+    (void)base;
+    (void)cntNum;
+    pwm_sync();
+    pwm.intr_mask = source;
+    if (was_masked)
+    {
+        pwm_schedule_tc();
+    }
+}
+
+uint32_t Cy_TCPWM_GetInterruptMask(TCPWM_Type const *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+    return pwm.intr_mask;
+}
+
+uint32_t Cy_TCPWM_GetInterruptStatusMasked(TCPWM_Type const *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+    pwm_sync();
+    return pwm.intr_status & pwm.intr_mask;
+}
+
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source)
+{
+    (void)base;
+    (void)cntNum;
+    pwm_sync();
+    pwm.intr_status &= ~source;
+    if (0U != (source & CY_TCPWM_INT_ON_TC))
+    {
+        pwm_schedule_tc();
+    }
+}
+
+/*******************************************************************************
+ * SCB UART
+ ******************************************************************************/
+static uint32_t uart_in_flight(void)
+{
+    if (sim_stats.now_ns >= uart.line_free_ns)
+    {
+        return 0U;
+    }
+    return (uint32_t)((uart.line_free_ns - sim_stats.now_ns + uart.char_ns - 1U) / uart.char_ns);
+}
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, cy_stc_scb_uart_config_t const *config,
+                                         cy_stc_scb_uart_context_t *context)
+{
+    (void)base;
+    if ((NULL == config) || (NULL == context) || (0U == config->baudRate))
+    {
+        return CY_SCB_UART_BAD_PARAM;
+    }
+
+    /* 8N1: ten bit times per character */
+    uart.char_ns = (10ULL * SIM_NS_PER_S) / config->baudRate;
+    uart.line_free_ns = sim_stats.now_ns;
+    return CY_SCB_UART_SUCCESS;
+}
+
+void Cy_SCB_UART_Enable(CySCB_Type *base)
+{
+    (void)base;
+    if (!uart.enabled)
+    {
+        sim_stats.uart_restarts++;
+    }
+    uart.enabled = true;
+    uart_check_irq();
+}
+
+void Cy_SCB_UART_Disable(CySCB_Type *base, cy_stc_scb_uart_context_t *context)
+{
+    (void)base;
+    (void)context;
+    uart.enabled = false;
+    uart.line_free_ns = sim_stats.now_ns;
+}
+
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data)
+{
+    (void)base;
+    if (!uart.enabled)
+    {
+        sim_stats.uart_dropped++;
+        return 1U;
+    }
+    if (uart_in_flight() > SIM_UART_FIFO_DEPTH)
+    {
+        return 0U;
+    }
+
+    if (uart.line_free_ns < sim_stats.now_ns)
+    {
+        uart.line_free_ns = sim_stats.now_ns;
+    }
+    uart.line_free_ns += uart.char_ns;
+    sim_stats.uart_chars++;
+    if (NULL != uart_sink_fn)
+    {
+        uart_sink_fn(uart_sink_arg, (uint8_t)data);
+    }
+    return 1U;
+}
+
+void Cy_SCB_UART_PutString(CySCB_Type *base, char_t const string[])
+{
+    for (uint32_t i = 0U; '\0' != string[i]; i++)
+    {
+        while (0U == Cy_SCB_UART_Put(base, (uint32_t)(uint8_t)string[i]))
+        {
+            /* Blocks until the FIFO has room for one more character */
+            uint64_t room_at = uart.line_free_ns - (SIM_UART_FIFO_DEPTH * uart.char_ns);
+            uint64_t wait = (room_at > sim_stats.now_ns) ? (room_at - sim_stats.now_ns) : 1U;
+
+            sim_stats.uart_wait_ns += wait;
+            sim_cpu_ns(wait);
+        }
+        sim_cpu_ns(SIM_UART_PUT_NS);
+    }
+}
+
+void Cy_SCB_SetTxFifoLevel(CySCB_Type *base, uint32_t level)
+{
+    (void)base;
+    uart.tx_level = level;
+    uart_check_irq();
+}
+
+void Cy_SCB_SetTxInterruptMask(CySCB_Type *base, uint32_t interruptMask)
+{
+    (void)base;
+    uart.tx_mask = interruptMask;
+    uart_check_irq();
+}
+
+uint32_t Cy_SCB_GetTxInterruptMask(CySCB_Type const *base)
+{
+    (void)base;
+    return uart.tx_mask;
+}
+
+uint32_t Cy_SCB_GetTxInterruptStatusMasked(CySCB_Type const *base)
+{
+    uint32_t status = 0U;
+
+    (void)base;
+    if (uart.enabled && uart_tx_level_reached())
+    {
+        status |= CY_SCB_TX_INTR_LEVEL;
+    }
+    if (uart.enabled && (sim_stats.now_ns >= uart.line_free_ns))
+    {
+        status |= CY_SCB_TX_INTR_UART_DONE;
+    }
+    return status & uart.tx_mask;
+}
+
+void Cy_SCB_ClearTxInterrupt(CySCB_Type *base, uint32_t interruptMask)
+{
+    /* Both sources are level-sensitive in this model */
+    (void)base;
+    (void)interruptMask;
+}
+
+uint32_t Cy_SCB_UART_GetNumInTxFifo(CySCB_Type const *base)
+{
+    uint32_t n = uart_in_flight();
+
+    (void)base;
+    return (n > 0U) ? (n - 1U) : 0U;
+}
+
+bool Cy_SCB_UART_IsTxComplete(CySCB_Type const *base)
+{
+    bool complete = (sim_stats.now_ns >= uart.line_free_ns);
+
+    (void)base;
+    if (!complete)
+    {
+        /* Callers poll in a loop, each poll costs CPU time */
+        sim_stats.uart_wait_ns += SIM_UART_POLL_NS;
+        sim_cpu_ns(SIM_UART_POLL_NS);
+    }
+    return complete;
+}
+
+/*******************************************************************************
+ * SCB EZI2C
+ ******************************************************************************/
+cy_en_scb_ezi2c_status_t Cy_SCB_EZI2C_Init(CySCB_Type *base, cy_stc_scb_ezi2c_config_t const *config,
+                                           cy_stc_scb_ezi2c_context_t *context)
+{
+    (void)base;
+    if ((NULL == config) || (NULL == context))
+    {
+        return CY_SCB_EZI2C_BAD_PARAM;
+    }
+    memset(context, 0, sizeof(*context));
+    return CY_SCB_EZI2C_SUCCESS;
+}
+
+void Cy_SCB_EZI2C_Enable(CySCB_Type *base)
+{
+    (void)base;
+}
+
+void Cy_SCB_EZI2C_Disable(CySCB_Type *base, cy_stc_scb_ezi2c_context_t *context)
+{
+    (void)base;
+    (void)context;
+}
+
+void Cy_SCB_EZI2C_SetBuffer1(CySCB_Type const *base, uint8_t *buffer, uint32_t size, uint32_t rwBoundary,
+                             cy_stc_scb_ezi2c_context_t *context)
+{
+    (void)base;
+    context->buf1 = buffer;
+    context->buf1Size = size;
+    context->buf1rwBondary = rwBoundary;
+}
+
+void Cy_SCB_EZI2C_SetBuffer2(CySCB_Type const *base, uint8_t *buffer, uint32_t size, uint32_t rwBoundary,
+                             cy_stc_scb_ezi2c_context_t *context)
+{
+    (void)base;
+    context->buf2 = buffer;
+    context->buf2Size = size;
+    context->buf2rwBondary = rwBoundary;
+}
+
+void Cy_SCB_EZI2C_Interrupt(CySCB_Type *base, cy_stc_scb_ezi2c_context_t *context)
+{
+    (void)base;
+    (void)context;
+}
+
+/* A connected tuner reads the primary buffer continuously, so there is
+ * always activity to report once it has connected */
+uint32_t Cy_SCB_EZI2C_GetActivity(CySCB_Type const *base, cy_stc_scb_ezi2c_context_t *context)
+{
+    (void)base;
+    (void)context;
+    if ((0U != sim_cfg.tuner_connect_ns) && (sim_stats.now_ns >= sim_cfg.tuner_connect_ns))
+    {
+        return CY_SCB_EZI2C_STATUS_READ1;
+    }
+    return 0U;
+}
+
+cy_en_syspm_status_t Cy_SCB_EZI2C_DeepSleepCallback(cy_stc_syspm_callback_params_t *callbackParams,
+                                                    cy_en_syspm_callback_mode_t mode)
+{
+    (void)callbackParams;
+    (void)mode;
+    return CY_SYSPM_SUCCESS;
+}
+
+/* [] END OF FILE */
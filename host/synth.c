@@ -0,0 +1,195 @@
+/******************************************************************************
+ * File Name: synth.c
+ *
+ * Description: Synthetic raw-count generator for the host simulator. Fingers
+ * are rendered as a Gaussian signal profile over the touchpad columns and rows;
+ * the proximity sensor sees a hand approaching shortly before and leaving
+ * shortly after each stroke.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "synth.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define SYNTH_TOUCH_SIGNAL          (200.0)     /* Peak diff count of a finger */
+#define SYNTH_FINGER_SIGMA          (0.8)       /* Finger size in sensor pitches */
+#define SYNTH_PROX_SIGNAL           (450.0)     /* Proximity diff count of a hand */
+#define SYNTH_PROX_LEAD_MS          (400U)      /* Hand approach before a stroke */
+#define SYNTH_PROX_TRAIL_MS         (200U)      /* Hand retreat after a stroke */
+
+#define SYNTH_X_RESOLUTION          (160.0)
+#define SYNTH_Y_RESOLUTION          (100.0)
+
+/*******************************************************************************
+ * Demo script
+ ******************************************************************************/
+/* Covers the gestures handled by the application. Strokes are five seconds
+ * apart so each one starts from the proximity-only state with a settled
+ * proximity baseline. */
+static const synth_stroke_t demo_strokes[] =
+{
+    /* start  dur  fingers  x0   y0   x1   y1  spread0 spread1 */
+    {   500U, 150U, 1U,      80,  50,  80,  50,   0,   0 },   /* Single click */
+    {  5500U, 150U, 1U,      80,  50,  80,  50,   0,   0 },   /* Double click */
+    {  5750U, 150U, 1U,      82,  50,  82,  50,   0,   0 },
+    { 10500U, 300U, 1U,      20,  50, 140,  50,   0,   0 },   /* Scroll right */
+    { 15500U, 300U, 1U,     140,  50,  20,  50,   0,   0 },   /* Scroll left */
+    { 20500U, 200U, 1U,      80,  90,  80,  10,   0,   0 },   /* Scroll up */
+    { 25500U, 200U, 1U,      80,  10,  80,  90,   0,   0 },   /* Scroll down */
+    { 30500U, 100U, 1U,      50,  50,  90,  50,   0,   0 },   /* Flick right */
+    { 35500U, 150U, 2U,      80,  50,  80,  50,  60,  60 },   /* Two finger click */
+    { 40500U, 200U, 2U,      80,  50,  80,  50,  30, 140 },   /* Zoom in */
+    { 45500U, 200U, 2U,      80,  50,  80,  50, 140,  30 },   /* Zoom out */
+};
+
+#define DEMO_LENGTH_MS              (50000U)
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static uint32_t synth_rand(uint32_t *state)
+{
+    *state = (*state * 1664525UL) + 1013904223UL;
+    return *state >> 16;
+}
+
+static void add_finger(double *signal, double x, double y)
+{
+    double col = (x * (double)(CY_CAPSENSE_TOUCHPAD0_NUM_COLS - 1U)) / SYNTH_X_RESOLUTION;
+    double row = (y * (double)(CY_CAPSENSE_TOUCHPAD0_NUM_ROWS - 1U)) / SYNTH_Y_RESOLUTION;
+    double k = 1.0 / (2.0 * SYNTH_FINGER_SIGMA * SYNTH_FINGER_SIGMA);
+
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_COLS; i++)
+    {
+        double d = (double)i - col;
+        signal[i] += SYNTH_TOUCH_SIGNAL * exp(-d * d * k);
+    }
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_ROWS; i++)
+    {
+        double d = (double)i - row;
+        signal[CY_CAPSENSE_TOUCHPAD0_NUM_COLS + i] += SYNTH_TOUCH_SIGNAL * exp(-d * d * k);
+    }
+}
+
+static double lerp(int16_t a, int16_t b, double f)
+{
+    return (double)a + (((double)b - (double)a) * f);
+}
+
+/*******************************************************************************
+ * Function Name: synth_init_demo
+ ********************************************************************************
+ * Summary:
+ *  Loads the built-in demo script.
+ *
+ *******************************************************************************/
+void synth_init_demo(synth_t *synth, bool loop)
+{
+    synth->strokes = demo_strokes;
+    synth->num_strokes = (uint32_t)(sizeof(demo_strokes) / sizeof(demo_strokes[0]));
+    synth->length_ms = DEMO_LENGTH_MS;
+    synth->loop = loop;
+    synth->noise = 6U;
+    synth->seed = 1U;
+}
+
+/*******************************************************************************
+ * Function Name: synth_source
+ ********************************************************************************
+ * Summary:
+ *  sim_source_fn rendering the script at the given virtual time.
+ *
+ *******************************************************************************/
+bool synth_source(void *arg, uint64_t now_ns, sim_frame_t *frame)
+{
+    synth_t *synth = (synth_t *)arg;
+    uint64_t t_ms = now_ns / SIM_NS_PER_MS;
+    double signal[CY_CAPSENSE_TOUCHPAD0_NUM_SNS] = { 0.0 };
+    double prox = 0.0;
+
+    if (t_ms >= synth->length_ms)
+    {
+        if (!synth->loop)
+        {
+            return false;
+        }
+        t_ms %= synth->length_ms;
+    }
+
+    for (uint32_t i = 0U; i < synth->num_strokes; i++)
+    {
+        const synth_stroke_t *s = &synth->strokes[i];
+        uint64_t end = (uint64_t)s->start_ms + s->duration_ms;
+
+        if (((t_ms + SYNTH_PROX_LEAD_MS) >= s->start_ms) && (t_ms < (end + SYNTH_PROX_TRAIL_MS)))
+        {
+            prox = SYNTH_PROX_SIGNAL;
+        }
+
+        if ((t_ms >= s->start_ms) && (t_ms < end))
+        {
+            double f = (double)(t_ms - s->start_ms) / (double)s->duration_ms;
+            double x = lerp(s->x0, s->x1, f);
+            double y = lerp(s->y0, s->y1, f);
+
+            if (s->fingers >= 2U)
+            {
+                double half = lerp(s->spread0, s->spread1, f) / 2.0;
+
+                add_finger(signal, x - half, y);
+                add_finger(signal, x + half, y);
+            }
+            else
+            {
+                add_finger(signal, x, y);
+            }
+        }
+    }
+
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+    {
+        int32_t n = (0U != synth->noise) ? (int32_t)(synth_rand(&synth->seed) % synth->noise) - (synth->noise / 2) : 0;
+        frame->tp[i] = (uint16_t)((int32_t)SIM_TP_IDLE_RAW + (int32_t)signal[i] + n);
+    }
+    frame->prox = (uint16_t)(SIM_PROX_IDLE_RAW + (uint32_t)prox);
+    return true;
+}
+
+/* [] END OF FILE */
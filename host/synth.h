@@ -0,0 +1,88 @@
+/******************************************************************************
+ * File Name: synth.h
+ *
+ * Description: Synthetic raw-count generator for the host simulator. A script
+ * of finger strokes is rendered into touchpad and proximity raw counts at any
+ * virtual time, so the application can be exercised without a recorded trace.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* One finger contact moving linearly from (x0, y0) to (x1, y1). Two-finger
+ * strokes place the fingers symmetrically around the path, spread apart
+ * horizontally by a distance that changes linearly from spread0 to spread1.
+ * Coordinates use the touchpad resolution (160 x 100). */
+typedef struct
+{
+    uint32_t start_ms;
+    uint32_t duration_ms;
+    uint8_t fingers;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+    int16_t spread0;
+    int16_t spread1;
+} synth_stroke_t;
+
+typedef struct
+{
+    const synth_stroke_t *strokes;
+    uint32_t num_strokes;
+    uint32_t length_ms;         /* Script length; the script repeats when loop is set */
+    bool loop;
+    uint16_t noise;             /* Peak-to-peak raw count noise */
+    uint32_t seed;
+} synth_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void synth_init_demo(synth_t *synth, bool loop);
+bool synth_source(void *arg, uint64_t now_ns, sim_frame_t *frame);
+
+#endif /* SYNTH_H */
+
+/* [] END OF FILE */
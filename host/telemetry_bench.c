@@ -0,0 +1,312 @@
+/******************************************************************************
+ * File Name: telemetry_bench.c
+ *
+ * Description: Telemetry bench (touchpad_telemetry_bench). Replays a raw-count
+ * capture through the CAPSENSE processing path, publishes every frame with the
+ * firmware telemetry encoder, and reads it back with the host reader library
+ * the way an I2C host polling the secondary EZI2C buffer would. Checks that the
+ * reader rebuilds every diff count exactly and compares the bytes per poll and
+ * the achievable frame rate on the bus with reading the whole cy_capsense_tuner
+ * structure.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+#include "capture_io.h"
+#include "telemetry.h"
+#include "telemetry_reader.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Default I2C clock of the KitProg bridge */
+#define BENCH_BUS_HZ                (400000UL)
+
+/* Bits of a sub-addressed EZI2C read besides the data: start, address and
+ * two sub-address bytes, repeated start, address, stop */
+#define BENCH_READ_OVERHEAD_BITS    (1U + 9U + 18U + 1U + 9U + 1U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint64_t polls;
+    uint64_t transfers;
+    uint64_t bytes;
+    uint64_t bits;
+} bus_stats_t;
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+/* One sub-addressed read of length bytes from the region */
+static void bus_read(bus_stats_t *bus, uint8_t *dest, uint32_t addr, uint32_t length)
+{
+    memcpy(dest, (const uint8_t *)&telemetry_region + addr, length);
+    bus->transfers++;
+    bus->bytes += length;
+    bus->bits += BENCH_READ_OVERHEAD_BITS + (9U * (uint64_t)length);
+}
+
+/* Polls the way a host would: header first, then the payload, then the
+ * snapshot if frames were missed. The header and payload are one transfer
+ * when the payload length is known from the previous poll; the bench keeps
+ * it simple and reads the header with the largest payload seen so far. */
+static telemetry_reader_status_t poll(telemetry_reader_t *reader, bus_stats_t *bus, uint32_t *read_ahead)
+{
+    uint8_t frame[sizeof(telemetry_frame_t)];
+    uint8_t snapshot[sizeof(telemetry_snapshot_t)];
+    uint32_t size;
+    telemetry_reader_status_t status;
+
+    bus->polls++;
+    bus_read(bus, frame, TELEMETRY_READER_FRAME_ADDR, TELEMETRY_FRAME_HEADER_SIZE + *read_ahead);
+    size = telemetry_reader_frame_size(frame);
+    if (size > (TELEMETRY_FRAME_HEADER_SIZE + *read_ahead))
+    {
+        /* Rest of the payload */
+        bus_read(bus, &frame[TELEMETRY_FRAME_HEADER_SIZE + *read_ahead],
+                 TELEMETRY_READER_FRAME_ADDR + TELEMETRY_FRAME_HEADER_SIZE + *read_ahead,
+                 size - TELEMETRY_FRAME_HEADER_SIZE - *read_ahead);
+        *read_ahead = size - TELEMETRY_FRAME_HEADER_SIZE;
+    }
+
+    status = telemetry_reader_frame(reader, frame, size);
+    if (TELEMETRY_READER_RESYNC == status)
+    {
+        bus_read(bus, snapshot, TELEMETRY_READER_SNAPSHOT_ADDR, sizeof(snapshot));
+        status = telemetry_reader_snapshot(reader, snapshot, sizeof(snapshot));
+    }
+    return status;
+}
+
+static void load_raw_counts(const capture_frame_t *frame)
+{
+    const cy_stc_capsense_widget_config_t *wd = cy_capsense_context.ptrWdConfig;
+
+    if (0U != (frame->flags & CAPTURE_FLAG_PROXIMITY))
+    {
+        wd[CY_CAPSENSE_PROXIMITY0_WDGT_ID].ptrSnsContext[0].raw = frame->prox_raw;
+    }
+    if (0U != (frame->flags & CAPTURE_FLAG_TOUCHPAD))
+    {
+        for (uint32_t i = 0U; i < CAPTURE_TOUCHPAD_NUM_SNS; i++)
+        {
+            wd[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrSnsContext[i].raw = frame->touchpad_raw[i];
+        }
+    }
+}
+
+/* Diff counts of all sensors in telemetry order match the reader */
+static bool reader_matches(const telemetry_reader_t *reader)
+{
+    const cy_stc_capsense_widget_config_t *wd = cy_capsense_context.ptrWdConfig;
+
+    for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+    {
+        if (reader->diff[i] != wd[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrSnsContext[i].diff)
+        {
+            return false;
+        }
+    }
+    return (reader->diff[TELEMETRY_PROX_SENSOR] == wd[CY_CAPSENSE_PROXIMITY0_WDGT_ID].ptrSnsContext[0].diff);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options] CAPTURE\n"
+            "  CAPTURE   raw-count capture, '-' reads standard input\n"
+            "  -b HZ     I2C clock (default %lu)\n"
+            "  -r BYTES  size of cy_capsense_tuner on the device (default: host build, %zu)\n"
+            "  -n N      poll after every Nth frame (default 1); N > 1 exercises resync\n",
+            prog, BENCH_BUS_HZ, sizeof(cy_capsense_tuner));
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *  Host entry point of the telemetry bench.
+ *
+ *******************************************************************************/
+int main(int argc, char **argv)
+{
+    capture_reader_t capture;
+    const capture_frame_t *frame;
+    telemetry_reader_t reader;
+    bus_stats_t bus = { 0 };
+    uint32_t bus_hz = BENCH_BUS_HZ;
+    uint32_t raw_bytes = (uint32_t)sizeof(cy_capsense_tuner);
+    uint32_t poll_every = 1U;
+    uint32_t read_ahead = 0U;
+    uint16_t initialized = 0U;
+    uint64_t published = 0U;
+    uint64_t payload_bytes = 0U;
+    uint32_t payload_max = 0U;
+    uint64_t mismatches = 0U;
+    uint64_t bad = 0U;
+    uint64_t raw_bits;
+    double telemetry_s;
+    double raw_s;
+    double host_s;
+    struct timespec t0;
+    struct timespec t1;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "b:r:n:h")))
+    {
+        switch (opt)
+        {
+        case 'b': bus_hz = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'r': raw_bytes = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'n': poll_every = (uint32_t)strtoul(optarg, NULL, 0); break;
+        default:
+            usage(argv[0]);
+            return ('h' == opt) ? 0 : 2;
+        }
+    }
+    if (((optind + 1) != argc) || (0U == bus_hz) || (0U == poll_every))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    if (!capture_reader_open(&capture, argv[optind]))
+    {
+        return 1;
+    }
+
+    sim_reset(NULL);
+    (void)Cy_CapSense_Init(&cy_capsense_context);
+    cy_capsense_context.ptrCommonContext->timestampInterval = capture.header.timestamp_interval;
+    telemetry_init(&cy_capsense_context);
+    telemetry_reader_init(&reader);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    while (NULL != (frame = capture_reader_next(&capture)))
+    {
+        load_raw_counts(frame);
+        if (0U != (frame->flags & (uint16_t)~initialized & CAPTURE_FLAG_PROXIMITY))
+        {
+            Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_PROXIMITY0_WDGT_ID, &cy_capsense_context);
+        }
+        if (0U != (frame->flags & (uint16_t)~initialized & CAPTURE_FLAG_TOUCHPAD))
+        {
+            Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+        }
+        initialized |= frame->flags;
+        Cy_CapSense_SetGestureTimestamp(frame->timestamp, &cy_capsense_context);
+
+        /* Publish as the firmware does after processing each widget */
+        if (0U != (frame->flags & CAPTURE_FLAG_PROXIMITY))
+        {
+            (void)Cy_CapSense_ProcessWidget(CY_CAPSENSE_PROXIMITY0_WDGT_ID, &cy_capsense_context);
+            telemetry_publish(CY_CAPSENSE_PROXIMITY0_WDGT_ID, 0U, NULL);
+            published++;
+            payload_bytes += telemetry_region.frame.payload_len;
+        }
+        if (0U != (frame->flags & CAPTURE_FLAG_TOUCHPAD))
+        {
+            uint32_t gest;
+
+            (void)Cy_CapSense_ProcessWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+            gest = Cy_CapSense_DecodeWidgetGestures(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+            telemetry_publish(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, gest,
+                              Cy_CapSense_GetTouchInfo(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context));
+            published++;
+            payload_bytes += telemetry_region.frame.payload_len;
+        }
+        if (telemetry_region.frame.payload_len > payload_max)
+        {
+            payload_max = telemetry_region.frame.payload_len;
+        }
+
+        if (0U != ((capture.frames - 1U) % poll_every))
+        {
+            continue;
+        }
+        if (TELEMETRY_READER_OK != poll(&reader, &bus, &read_ahead))
+        {
+            bad++;
+        }
+        else if (!reader_matches(&reader))
+        {
+            mismatches++;
+        }
+        else
+        {
+            /* Rebuilt exactly */
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    host_s = (double)(t1.tv_sec - t0.tv_sec) + ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9);
+
+    if (0U == bus.polls)
+    {
+        fprintf(stderr, "empty capture\n");
+        capture_reader_close(&capture);
+        return 1;
+    }
+
+    raw_bits = bus.polls * (BENCH_READ_OVERHEAD_BITS + (9U * (uint64_t)raw_bytes));
+    telemetry_s = (double)bus.bits / (double)bus_hz;
+    raw_s = (double)raw_bits / (double)bus_hz;
+
+    printf("frames published    : %llu (payload %.1f bytes avg, %u max)\n", (unsigned long long)published,
+           (double)payload_bytes / (double)published, payload_max);
+    printf("polls               : %llu every %u frame(s), %u resyncs, %u frames missed\n",
+           (unsigned long long)bus.polls, poll_every, reader.resyncs, reader.missed);
+    printf("reader              : %llu mismatches, %llu failed polls, %u rejected transfers\n",
+           (unsigned long long)mismatches, (unsigned long long)bad, reader.errors);
+    printf("bytes per poll      : %.1f telemetry, %u raw tuner structure\n",
+           (double)bus.bytes / (double)bus.polls, raw_bytes);
+    printf("max polls/s at %4lu kHz: %.0f telemetry, %.0f raw tuner structure (%.1fx)\n",
+           (unsigned long)(bus_hz / 1000U), (double)bus.polls / telemetry_s, (double)bus.polls / raw_s,
+           raw_s / telemetry_s);
+    printf("host time           : %.3f s (%.0f ns/frame)\n", host_s,
+           (0U != published) ? (host_s * 1e9 / (double)published) : 0.0);
+
+    capture_reader_close(&capture);
+    return ((0U == mismatches) && (0U == bad)) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,247 @@
+/******************************************************************************
+ * File Name: telemetry_reader.c
+ *
+ * Description: Host-side reader of the compact telemetry region.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <string.h>
+#include "telemetry_reader.h"
+
+/*******************************************************************************
+ * Helpers
+ ******************************************************************************/
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t checksum(const uint8_t *data, size_t length)
+{
+    uint8_t sum = 0U;
+
+    for (size_t i = 0U; i < length; i++)
+    {
+        sum ^= data[i];
+    }
+    return sum;
+}
+
+/* Header fields of a frame whose checksum has been verified */
+static void load_header(telemetry_reader_t *reader, const uint8_t *data)
+{
+    reader->frame = get16(&data[offsetof(telemetry_frame_t, frame)]);
+    reader->changed = get32(&data[offsetof(telemetry_frame_t, changed)]);
+    reader->gesture = get32(&data[offsetof(telemetry_frame_t, gesture)]);
+    reader->timestamp = get16(&data[offsetof(telemetry_frame_t, timestamp)]);
+    reader->num_touch = data[offsetof(telemetry_frame_t, num_touch)];
+    reader->x = get16(&data[offsetof(telemetry_frame_t, x)]);
+    reader->y = get16(&data[offsetof(telemetry_frame_t, y)]);
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_reader_init
+ ********************************************************************************
+ * Summary:
+ *  Resets a reader; the first frame read asks for a snapshot.
+ *
+ *******************************************************************************/
+void telemetry_reader_init(telemetry_reader_t *reader)
+{
+    memset(reader, 0, sizeof(*reader));
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_reader_frame_size
+ ********************************************************************************
+ * Summary:
+ *  Returns the transfer size of the frame whose header is given.
+ *
+ *******************************************************************************/
+uint32_t telemetry_reader_frame_size(const uint8_t *header)
+{
+    uint32_t payload = header[offsetof(telemetry_frame_t, payload_len)];
+
+    return (uint32_t)TELEMETRY_FRAME_HEADER_SIZE + ((payload <= TELEMETRY_PAYLOAD_MAX) ? payload : 0U);
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_reader_frame
+ ********************************************************************************
+ * Summary:
+ *  Applies a frame read from TELEMETRY_READER_FRAME_ADDR.
+ *
+ * Parameters:
+ *  reader: reader state
+ *  data: header and payload as transferred
+ *  length: bytes in data
+ *
+ * Return:
+ *  TELEMETRY_READER_RESYNC if the snapshot must be read next
+ *
+ *******************************************************************************/
+telemetry_reader_status_t telemetry_reader_frame(telemetry_reader_t *reader, const uint8_t *data, size_t length)
+{
+    uint32_t size;
+    uint16_t number;
+    uint32_t changed;
+    uint16_t diff[TELEMETRY_NUM_SENSORS];
+    const uint8_t *p;
+    const uint8_t *end;
+
+    if ((length < TELEMETRY_FRAME_HEADER_SIZE) || (TELEMETRY_VERSION != data[offsetof(telemetry_frame_t, version)]) ||
+        (data[offsetof(telemetry_frame_t, payload_len)] > TELEMETRY_PAYLOAD_MAX))
+    {
+        reader->errors++;
+        return TELEMETRY_READER_BAD;
+    }
+    size = telemetry_reader_frame_size(data);
+    if ((length < size) || (0U != checksum(data, size)))
+    {
+        reader->errors++;
+        return TELEMETRY_READER_BAD;
+    }
+
+    number = get16(&data[offsetof(telemetry_frame_t, frame)]);
+    if (reader->synced && (number == reader->frame))
+    {
+        return TELEMETRY_READER_SAME;
+    }
+    if (!reader->synced || (number != (uint16_t)(reader->frame + 1U)))
+    {
+        if (reader->synced)
+        {
+            reader->missed += (uint16_t)(number - reader->frame - 1U);
+        }
+        /* Touch and gesture state are complete in the header */
+        load_header(reader, data);
+        reader->synced = false;
+        reader->pending_frame = number;
+        return TELEMETRY_READER_RESYNC;
+    }
+
+    /* One zigzag varint per changed sensor */
+    memcpy(diff, reader->diff, sizeof(diff));
+    changed = get32(&data[offsetof(telemetry_frame_t, changed)]);
+    p = &data[TELEMETRY_FRAME_HEADER_SIZE];
+    end = &data[size];
+    for (uint32_t i = 0U; i < TELEMETRY_NUM_SENSORS; i++)
+    {
+        uint32_t value = 0U;
+        uint32_t shift = 0U;
+
+        if (0U == (changed & (1UL << i)))
+        {
+            continue;
+        }
+        do
+        {
+            if ((p == end) || (shift >= (7U * TELEMETRY_DELTA_MAX_BYTES)))
+            {
+                reader->errors++;
+                return TELEMETRY_READER_BAD;
+            }
+            value |= (uint32_t)(*p & 0x7FU) << shift;
+            shift += 7U;
+        } while (0U != (*p++ & 0x80U));
+
+        diff[i] = (uint16_t)(diff[i] + (uint16_t)((value >> 1) ^ (0U - (value & 1U))));
+    }
+    if ((p != end) || (0U != (changed >> TELEMETRY_NUM_SENSORS)))
+    {
+        reader->errors++;
+        return TELEMETRY_READER_BAD;
+    }
+
+    memcpy(reader->diff, diff, sizeof(diff));
+    load_header(reader, data);
+    reader->frames++;
+    return TELEMETRY_READER_OK;
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_reader_snapshot
+ ********************************************************************************
+ * Summary:
+ *  Loads the snapshot read from TELEMETRY_READER_SNAPSHOT_ADDR after
+ *  telemetry_reader_frame() asked for a resync. Touch and gesture state were
+ *  taken from that frame; only the diff counts come from the snapshot.
+ *
+ * Parameters:
+ *  reader: reader state
+ *  data: snapshot as transferred
+ *  length: bytes in data
+ *
+ * Return:
+ *  TELEMETRY_READER_OK if the reader is synchronized again,
+ *  TELEMETRY_READER_RESYNC if the device has moved on: read the frame again
+ *
+ *******************************************************************************/
+telemetry_reader_status_t telemetry_reader_snapshot(telemetry_reader_t *reader, const uint8_t *data,
+                                                    size_t length)
+{
+    uint16_t number;
+
+    if ((length < sizeof(telemetry_snapshot_t)) ||
+        (TELEMETRY_VERSION != data[offsetof(telemetry_snapshot_t, version)]) ||
+        (0U != checksum(data, sizeof(telemetry_snapshot_t))))
+    {
+        reader->errors++;
+        return TELEMETRY_READER_BAD;
+    }
+
+    number = get16(&data[offsetof(telemetry_snapshot_t, frame)]);
+    if (number != reader->pending_frame)
+    {
+        return TELEMETRY_READER_RESYNC;
+    }
+
+    for (uint32_t i = 0U; i < TELEMETRY_NUM_SENSORS; i++)
+    {
+        reader->diff[i] = get16(&data[offsetof(telemetry_snapshot_t, diff) + (2U * i)]);
+    }
+    reader->frame = number;
+    reader->synced = true;
+    reader->resyncs++;
+    return TELEMETRY_READER_OK;
+}
+
+/* [] END OF FILE */
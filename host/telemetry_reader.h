@@ -0,0 +1,104 @@
+/******************************************************************************
+ * File Name: telemetry_reader.h
+ *
+ * Description: Host-side reader of the compact telemetry region
+ * (source/telemetry.h). Rebuilds the diff counts of all sensors from the delta-
+ * encoded frames read over I2C, and resynchronizes from the snapshot when
+ * frames were missed. Works on the raw bytes of a transfer, independent of the
+ * host byte order.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef TELEMETRY_READER_H
+#define TELEMETRY_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "telemetry.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Offsets of the parts of the region, as I2C sub-addresses */
+#define TELEMETRY_READER_FRAME_ADDR     (offsetof(telemetry_region_t, frame))
+#define TELEMETRY_READER_SNAPSHOT_ADDR  (offsetof(telemetry_region_t, snapshot))
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef enum
+{
+    TELEMETRY_READER_OK,            /* New frame applied */
+    TELEMETRY_READER_SAME,          /* Frame already applied */
+    TELEMETRY_READER_RESYNC,        /* Frames were missed: read the snapshot */
+    TELEMETRY_READER_BAD            /* Torn or corrupt transfer: read again */
+} telemetry_reader_status_t;
+
+typedef struct
+{
+    bool synced;
+    uint16_t frame;                 /* Last applied frame */
+    uint16_t diff[TELEMETRY_NUM_SENSORS];
+    uint32_t changed;               /* Sensors changed by the last frame */
+    uint32_t gesture;
+    uint16_t timestamp;
+    uint8_t num_touch;
+    uint16_t x;
+    uint16_t y;
+    uint16_t pending_frame;         /* Frame waiting for its snapshot */
+    uint32_t frames;                /* Frames applied from deltas */
+    uint32_t resyncs;               /* Frames applied from a snapshot */
+    uint32_t missed;                /* Frames never seen */
+    uint32_t errors;                /* Transfers rejected */
+} telemetry_reader_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void telemetry_reader_init(telemetry_reader_t *reader);
+
+/* Bytes needed for a frame with the given header: read the header first,
+ * or read TELEMETRY_FRAME_HEADER_SIZE + TELEMETRY_PAYLOAD_MAX at once */
+uint32_t telemetry_reader_frame_size(const uint8_t *header);
+
+telemetry_reader_status_t telemetry_reader_frame(telemetry_reader_t *reader, const uint8_t *data, size_t length);
+telemetry_reader_status_t telemetry_reader_snapshot(telemetry_reader_t *reader, const uint8_t *data,
+                                                    size_t length);
+
+#endif /* TELEMETRY_READER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,184 @@
+/******************************************************************************
+ * File Name: trace.c
+ *
+ * Description: Raw-count trace reader of the host tools.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define TRACE_LINE_MAX              (512U)
+#define TRACE_COLUMNS               (2U + CY_CAPSENSE_TOUCHPAD0_NUM_SNS)
+
+/*******************************************************************************
+ * Reader
+ ******************************************************************************/
+static bool trace_read_row(trace_t *trace)
+{
+    char line[TRACE_LINE_MAX];
+
+    while (NULL != fgets(line, sizeof(line), trace->file))
+    {
+        unsigned long value[TRACE_COLUMNS];
+        char *p = line;
+        uint32_t n = 0U;
+
+        trace->line++;
+        if (('#' == line[0]) || ('t' == line[0]) || ('\n' == line[0]) || ('\r' == line[0]))
+        {
+            continue;
+        }
+
+        while (n < TRACE_COLUMNS)
+        {
+            char *end;
+
+            value[n] = strtoul(p, &end, 10);
+            if (end == p)
+            {
+                break;
+            }
+            n++;
+            p = end;
+            if (',' != *p)
+            {
+                break;
+            }
+            p++;
+        }
+
+        if (TRACE_COLUMNS != n)
+        {
+            fprintf(stderr, "trace:%u: expected %u columns, got %u\n", trace->line, TRACE_COLUMNS, n);
+            continue;
+        }
+
+        trace->next_ns = (uint64_t)value[0] * SIM_NS_PER_MS;
+        trace->next.prox = (uint16_t)value[1];
+        for (uint32_t i = 0U; i < CY_CAPSENSE_TOUCHPAD0_NUM_SNS; i++)
+        {
+            trace->next.tp[i] = (uint16_t)value[2U + i];
+        }
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: trace_source
+ ********************************************************************************
+ * Summary:
+ *  sim_source_fn returning the trace row in effect at the given virtual time.
+ *  The last row is held for one more request once the file ends.
+ *
+ *******************************************************************************/
+bool trace_source(void *arg, uint64_t now_ns, sim_frame_t *frame)
+{
+    trace_t *trace = (trace_t *)arg;
+
+    while (trace->have_next && (now_ns >= trace->next_ns))
+    {
+        trace->current = trace->next;
+        trace->have_next = trace_read_row(trace);
+        if (!trace->have_next)
+        {
+            /* Hold the last row for one more wake, then stop */
+            *frame = trace->current;
+            return true;
+        }
+    }
+
+    if (!trace->have_next && (now_ns > trace->next_ns))
+    {
+        return false;
+    }
+    *frame = trace->current;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: trace_open
+ ********************************************************************************
+ * Summary:
+ *  Opens a trace and reads its first row.
+ *
+ * Parameters:
+ *  trace: reader to initialize
+ *  path: CSV file
+ *
+ * Return:
+ *  false if the file cannot be opened
+ *
+ *******************************************************************************/
+bool trace_open(trace_t *trace, const char *path)
+{
+    memset(trace, 0, sizeof(*trace));
+    trace->file = fopen(path, "r");
+    if (NULL == trace->file)
+    {
+        perror(path);
+        return false;
+    }
+    trace->have_next = trace_read_row(trace);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: trace_close
+ ********************************************************************************
+ * Summary:
+ *  Closes a trace opened by trace_open().
+ *
+ * Parameters:
+ *  trace: reader to close
+ *
+ *******************************************************************************/
+void trace_close(trace_t *trace)
+{
+    if (NULL != trace->file)
+    {
+        fclose(trace->file);
+        trace->file = NULL;
+    }
+}
+
+/* [] END OF FILE */
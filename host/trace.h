@@ -0,0 +1,76 @@
+/******************************************************************************
+ * File Name: trace.h
+ *
+ * Description: Raw-count trace reader of the host tools. A trace is a CSV file
+ * with one row per sensor state change: t_ms,prox,c0..c15,r0..r9. Every row
+ * holds until the timestamp of the next row is reached.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "sim.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* Streaming reader, the file is read one row ahead of the requested time */
+typedef struct
+{
+    FILE *file;
+    uint32_t line;
+    bool have_next;
+    uint64_t next_ns;
+    sim_frame_t current;
+    sim_frame_t next;
+} trace_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool trace_open(trace_t *trace, const char *path);
+void trace_close(trace_t *trace);
+
+/* sim_source_fn, arg is the trace_t */
+bool trace_source(void *arg, uint64_t now_ns, sim_frame_t *frame);
+
+#endif /* TRACE_H */
+
+/* [] END OF FILE */
@@ -48,6 +48,26 @@
 #include "cycfg_capsense.h"
 #include "stdio.h"
 #include "string.h"
+#include "ilo_comp.h"
+#include "gesture_clock.h"
+#include "low_power.h"
+#include "gesture_log.h"
+#include "gesture_table.h"
+#include "scan_pipeline.h"
+#include "prox_baseline.h"
+#include "power_policy.h"
+#include "power_levels.h"
+#include "stage_profile.h"
+#include "telemetry.h"
+#include "tuner_service.h"
+#include "liquid_detect.h"
+#include "touch_roi.h"
+#include "raw_filter.h"
+#include "touch_history.h"
+#include "led_control.h"
+#include "noise_hop.h"
+#include "cal_store.h"
+#include "boot_profile.h"
 
 /*******************************************************************************
  * Macros
@@ -67,23 +87,52 @@
 /* WDT interrupt priority */
 #define WDT_INTERRUPT_PRIORITY     (3U)
 
+/* UART TX interrupt priority, lowest so it never delays a scan */
+#define UART_INTERRUPT_PRIORITY    (3U)
+
+/* The WDT counter is 16 bits wide */
+#define WDT_COUNTER_MASK           (0xFFFFUL)
+
+/* Longest approach-to-gesture time profiled, 60 s */
+#define APPROACH_MAX_US            (60000000UL)
+
+/* Brightness steps grow with the finger speed over the last 100 ms: one more
+ * step per BRIGHTNESS_ACCEL_SPEED position units per timestamp tick */
+#define BRIGHTNESS_ACCEL_SPAN      (10U)
+#define BRIGHTNESS_ACCEL_SPEED     (4U)
+#define BRIGHTNESS_ACCEL_MAX       (4U)
+
 /* Gesture Macros */
-#define SINGLE_CLICK            (0x0001U)
-#define DOUBLE_CLICK            (0x0002U)
-#define SCROLL_RIGHT            (0x00020010U)
-#define SCROLL_LEFT             (0x00030010U)
-#define SCROLL_UP               (0x000010U)
-#define SCROLL_DOWN             (0x010010U)
-#define FLICK_UP                (0x00000080U)
-#define FLICK_DOWN              (0x010000080U)
-#define FLICK_RIGHT             (0x02000080U)
-#define FLICK_LEFT              (0x03000080U)
-#define TWO_FINGER_ZOOM_IN      (0x00000200U)
-#define TWO_FINGER_ZOOM_OUT     (0x00800200U)
-#define TWO_FINGER_CLICK        (0x00000008U)
-
-/* Delays */
-#define DELAY_MS    (5U) /* in ms */
+#define SINGLE_CLICK            GESTURE_CODE(CY_CAPSENSE_GESTURE_ONE_FNGR_SINGLE_CLICK_MASK)
+#define DOUBLE_CLICK            GESTURE_CODE(CY_CAPSENSE_GESTURE_ONE_FNGR_DOUBLE_CLICK_MASK)
+#define SCROLL_RIGHT            GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_SCROLL_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL, CY_CAPSENSE_GESTURE_DIRECTION_RIGHT)
+#define SCROLL_LEFT             GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_SCROLL_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL, CY_CAPSENSE_GESTURE_DIRECTION_LEFT)
+#define SCROLL_UP               GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_SCROLL_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL, CY_CAPSENSE_GESTURE_DIRECTION_UP)
+#define SCROLL_DOWN             GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_SCROLL_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL, CY_CAPSENSE_GESTURE_DIRECTION_DOWN)
+#define FLICK_UP                GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_FLICK_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_FLICK, CY_CAPSENSE_GESTURE_DIRECTION_UP)
+#define FLICK_DOWN              GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_FLICK_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_FLICK, CY_CAPSENSE_GESTURE_DIRECTION_DOWN)
+#define FLICK_RIGHT             GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_FLICK_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_FLICK, CY_CAPSENSE_GESTURE_DIRECTION_RIGHT)
+#define FLICK_LEFT              GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_ONE_FNGR_FLICK_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_FLICK, CY_CAPSENSE_GESTURE_DIRECTION_LEFT)
+#define TWO_FINGER_ZOOM_IN      GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_TWO_FNGR_ZOOM_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_TWO_ZOOM, CY_CAPSENSE_GESTURE_DIRECTION_IN)
+#define TWO_FINGER_ZOOM_OUT     GESTURE_CODE_DIR(CY_CAPSENSE_GESTURE_TWO_FNGR_ZOOM_MASK, \
+                                    CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_TWO_ZOOM, CY_CAPSENSE_GESTURE_DIRECTION_OUT)
+#define TWO_FINGER_CLICK        GESTURE_CODE(CY_CAPSENSE_GESTURE_TWO_FNGR_SINGLE_CLICK_MASK)
+
+/* The codes reported on the UART must not change with the middleware version */
+_Static_assert(SCROLL_RIGHT == 0x00020010UL, "Unexpected scroll gesture layout");
+_Static_assert(SCROLL_DOWN == 0x00010010UL, "Unexpected scroll gesture layout");
+_Static_assert(FLICK_DOWN == 0x01000080UL, "Unexpected flick gesture layout");
+_Static_assert(FLICK_LEFT == 0x03000080UL, "Unexpected flick gesture layout");
+_Static_assert(TWO_FINGER_ZOOM_OUT == 0x00800200UL, "Unexpected zoom gesture layout");
 
 /*******************************************************************************
  * Global Definitions
@@ -101,20 +150,50 @@ const cy_stc_sysint_t wdt_isr_cfg =
     .intrPriority = WDT_INTERRUPT_PRIORITY /* Interrupt priority is 0 */
 };
 
+/* UART TX interrupt configuration, drains the gesture log */
+const cy_stc_sysint_t scb_1_isr_cfg =
+{
+    .intrSrc = scb_1_IRQ,
+    .intrPriority = UART_INTERRUPT_PRIORITY
+};
+
+/* Peripherals prepared by the Deep Sleep callback */
+static const low_power_config_t low_power_config =
+{
+    .uart_base = scb_1_HW,
+    .uart_context = &scb_1_context,
+    .ezi2c_base = CYBSP_EZI2C_HW,
+    .ezi2c_context = &ezi2c_context,
+    .capsense_context = &cy_capsense_context
+};
+
 /* Variable to check whether WDT interrupt is triggered */
 bool flag = false;
 
 /* Variable to store the counts required after ILO compensation */
-static uint32_t ilo_cycles = 0U;
 static uint32_t ilo_compensated_counts = 0U;
 static uint32_t DESIRED_WDT_INTERVAL_MS = 100000U;
 
-/* Variable to check the state of an LED */
+/* Brightness step of a gesture, in LED_CONTROL_LEVEL_MAX levels */
 uint16_t bright = 100U;
-uint8_t state = 0U;
 uint16_t inc;
 uint16_t dec;
 
+/* Scan being timed by the stage profiler, STAGE_PROFILE_COUNT if none */
+static volatile stage_profile_stage_t scan_stage = STAGE_PROFILE_COUNT;
+static volatile uint32_t scan_start = 0U;
+
+/* CPU Sleep of the current wake-up spent waiting for the scan, in CPU cycles */
+static uint32_t scan_wait_cycles = 0U;
+
+/* Device time since the proximity detection, until the first gesture */
+static bool approach_pending = false;
+static uint32_t approach_us = 0U;
+
+/* The debug UART and the EZI2C slave are brought up once */
+static bool uart_started = false;
+static bool tuner_started = false;
+
 /*******************************************************************************
  * Function Prototypes
  *******************************************************************************/
@@ -124,19 +203,57 @@ static void capsense_msc0_isr(void);
 static void capsense_msc1_isr(void);
 static void initialize_capsense_tuner(void);
 
+/* Peripherals brought up on first use */
+static void start_uart(void);
+static void start_tuner(void);
+
 /* EZ-I2C ISR */
 static void ezi2c_isr(void);
+static void scan_profile_isr(void);
 
 /* PWM functions to control led brightness */ 
 void incr_brightness(uint16_t inc);
 void decr_brightness(uint16_t dec);
 void toggle_pwm(void);
 
+/* Power level change */
+static void power_level_changed(uint32_t from_level, uint32_t to_level);
+
+/* Gesture actions */
+static uint16_t brightness_step(void);
+static void gesture_toggle_led(uint32_t gesture);
+static void gesture_brightness_up(uint32_t gesture);
+static void gesture_brightness_down(uint32_t gesture);
+static void gesture_toggle_led3(uint32_t gesture);
+
 /* WDT function */ 
 void wdt_isr(void); /* WDT interrupt service routine */
 void wdt_trigger(void);
-cy_en_syspm_status_t deep_sleep_callback(
-    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+ * Gesture Actions
+ *******************************************************************************/
+/* Action of each handled gesture. Further actions can be added at run time
+ * with gesture_table_register(). */
+static const gesture_table_entry_t gesture_actions[] =
+{
+    { SINGLE_CLICK,         gesture_toggle_led },
+    { DOUBLE_CLICK,         gesture_toggle_led },
+#if !LED_CONTROL_CONTINUOUS
+    /* Otherwise one-finger movement is tracked frame by frame */
+    { SCROLL_DOWN,          gesture_brightness_down },
+    { SCROLL_UP,            gesture_brightness_up },
+    { SCROLL_RIGHT,         gesture_brightness_up },
+    { SCROLL_LEFT,          gesture_brightness_down },
+    { FLICK_UP,             gesture_brightness_up },
+    { FLICK_DOWN,           gesture_brightness_down },
+    { FLICK_RIGHT,          gesture_brightness_up },
+    { FLICK_LEFT,           gesture_brightness_down },
+#endif /* !LED_CONTROL_CONTINUOUS */
+    { TWO_FINGER_CLICK,     gesture_toggle_led3 },
+    { TWO_FINGER_ZOOM_OUT,  gesture_brightness_down },
+    { TWO_FINGER_ZOOM_IN,   gesture_brightness_up },
+};
 
 /*******************************************************************************
  * Function Name: main
@@ -155,22 +272,42 @@ cy_en_syspm_status_t deep_sleep_callback(
 int main(void)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_en_sysint_status_t sysintStatus;
 
-    /* This variable is used to store the string of characters to be displayed on UART Terminal */
-    char buf[10] = " ";
+    /* Last touch position on the touchpad, reported with each gesture */
+    cy_stc_capsense_position_t last_position = { .x = GESTURE_LOG_NO_POSITION, .y = GESTURE_LOG_NO_POSITION };
+    cy_stc_capsense_touch_t *touch_info;
 
     /* This varible is used to store timestamp value */
     uint32_t user_time_stamp = 2U;
 
-    /* Proximity touch state */
-    uint8_t proximity_state = 0U;
-
-    /* This variable is used to implement software counter */
-    uint8_t soft_counter = 0U;
+    /* Activity seen in the processed frame, POWER_POLICY_EVENT_* */
+    uint32_t power_events;
 
     /* variable to store decode values */
     uint32_t gest = 0U, lgest = 0U;
 
+    /* Widget of the frame processed in this iteration */
+    uint32_t frame_widget;
+
+    /* Slots of the frame started in this iteration */
+    uint32_t scan_slots;
+
+    /* Raw count filter stages of the touchpad frame, RAW_FILTER_* */
+    uint32_t filter_stages;
+
+    /* Start of the stage being profiled */
+    uint32_t stage_start;
+
+    /* Device time of the frame that has just been processed */
+    uint32_t frame_us;
+
+    /* The first scan ends the boot */
+    bool first_scan = true;
+
+    /* Time the boot phases from here */
+    boot_profile_init();
+
     /* Initialize the device and board peripherals */
     result = cybsp_init();
 
@@ -182,42 +319,77 @@ int main(void)
 
     /* Enable global interrupts */
     __enable_irq();
+    boot_profile_mark(BOOT_PROFILE_BSP);
 
-    /* Initializes the SCB for debug UART port */
-    result = Cy_SCB_UART_Init(SCB1, &scb_1_config, &scb_1_context);
-
-    /* SCB UART init failed. Stop program execution */
-    if (result != CY_SCB_UART_SUCCESS)
+    /* One Deep Sleep callback for the UART, PWM, EzI2C and MSC blocks;
+     * entry waits only for pending UART output and scans */
+    if (!low_power_init(&low_power_config))
     {
         CY_ASSERT(0);
     }
+    boot_profile_mark(BOOT_PROFILE_LOW_POWER);
 
-    /* Enables the SCB block for the UART operation */
-    Cy_SCB_UART_Enable(SCB1);
+#if !BOOT_PROFILE_LAZY_START
+    /* Otherwise started with the first gesture */
+    start_uart();
+#endif /* !BOOT_PROFILE_LAZY_START */
 
     /* Initialize timestamp for gestures */
     Cy_CapSense_SetGestureTimestamp(user_time_stamp, &cy_capsense_context);
 
-    /* Print Charaters on UART Terminal */
-    Cy_SCB_UART_PutString(SCB1, "Touchpad 10x16\r\n");
+    /* Publish telemetry and time the loop stages; read over I2C next to
+     * the tuner data */
+    telemetry_init(&cy_capsense_context);
+    boot_profile_mark(BOOT_PROFILE_TELEMETRY);
 
-    /* Initialize EZI2C */
-    initialize_capsense_tuner();
+#if !BOOT_PROFILE_LAZY_START
+    /* Otherwise started once the first scan is running */
+    start_tuner();
+#endif /* !BOOT_PROFILE_LAZY_START */
 
     /* Initialize MSC CapSense */
     initialize_capsense();
+    boot_profile_mark(BOOT_PROFILE_CAPSENSE);
 
-    /* Initialize the TCPWM block */
-    Cy_TCPWM_PWM_Init(pwm2_HW, pwm2_NUM, &pwm2_config);
-    
-    /* Enable the TCPWM block */
-    Cy_TCPWM_PWM_Enable(pwm2_HW, pwm2_NUM);
-    
-    /* Triggers a software start on the selected TCPWMs */
-    Cy_TCPWM_TriggerStart(pwm2_HW, pwm2_MASK);
+    /* Start in the proximity-only level */
+    if (!power_policy_init(power_levels, POWER_LEVEL_COUNT, POWER_LEVEL_PROX_IDLE, power_level_changed))
+    {
+        CY_ASSERT(0);
+    }
+    DESIRED_WDT_INTERVAL_MS = power_policy_get_interval_us();
+
+    /* Start with a dry panel */
+    liquid_detect_init(&cy_capsense_context);
+
+    /* Start with full touchpad scans and no touch history */
+    touch_roi_init(&cy_capsense_context);
+    touch_history_init();
+
+    /* Scan the touchpad at its configured sense clock until noise is seen */
+    noise_hop_init(&cy_capsense_context);
+
+    /* The packed raw count filters need the touchpad raw counts below 2^14 */
+    if (!raw_filter_init(&cy_capsense_context))
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Load the gesture actions */
+    if (!gesture_table_init(gesture_actions, sizeof(gesture_actions) / sizeof(gesture_actions[0])))
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Start with LED1 off */
+    led_control_init();
+#if !BOOT_PROFILE_LAZY_START
+    /* Otherwise started when LED1 first lights */
+    led_control_start();
+#endif /* !BOOT_PROFILE_LAZY_START */
+    boot_profile_mark(BOOT_PROFILE_MODULES);
 
     /* Configure the interrupt with a vector at Wdt_Isr(). */
-    cy_en_sysint_status_t sysintStatus = Cy_SysInt_Init(&wdt_isr_cfg, wdt_isr);
+    sysintStatus = Cy_SysInt_Init(&wdt_isr_cfg, wdt_isr);
     
     if (CY_SYSINT_SUCCESS != sysintStatus)
     {
@@ -237,215 +409,247 @@ int main(void)
     /* Disable the WCO */
     Cy_SysClk_WcoDisable();
     
+    /* Measure the ILO once, the compensated counts are cached */
+    ilo_comp_init();
+
     /* Enable WDT */
     Cy_WDT_Enable();
+
+    /* Gesture time runs from the WDT counter */
+    gesture_clock_init(Cy_WDT_GetCount());
     
     /* Unmask the WDT interrupt */
     Cy_WDT_UnmaskInterrupt();
+    boot_profile_mark(BOOT_PROFILE_WDT);
 
-    /* Callback parameters for EzI2C */
-    cy_stc_syspm_callback_params_t ezi2cCallbackParams =
+    for (;;)
     {
-        .base       = SCB0,
-        .context    = &ezi2c_context
-    };
+        /* WDT interrupt source */
+        wdt_trigger();
 
-    /* Callback declaration for EzI2C Deep Sleep callback */
-    cy_stc_syspm_callback_t ezi2cCallback =
-    {
-        .callback       = (Cy_SysPmCallback)&Cy_SCB_EZI2C_DeepSleepCallback,
-        .type           = CY_SYSPM_DEEPSLEEP,
-        .skipMode       = 0UL,
-        .callbackParams = &ezi2cCallbackParams,
-        .prevItm        = NULL,
-        .nextItm        = NULL,
-        .order          = 0
-    };
+        /* Count the device time of this wake-up in gesture ticks, whichever
+         * widget is scanned */
+        gesture_clock_update(Cy_WDT_GetCount());
 
-    /* SysPm callback params */
-    cy_stc_syspm_callback_params_t sysClkCallbackParams =
-    {
-        .base       = CYBSP_MSC0_HW,
-        .context    = &cy_capsense_context
-    };
+#if NOISE_HOP_ENABLED
+        /* Change the touchpad sense clock if the last touchpad frame asked
+         * for it; the calibration scans replace the touchpad raw counts, and
+         * the filter history of the old clock is dropped */
+        if (noise_hop_apply())
+        {
+            raw_filter_reset();
+        }
+#endif /* NOISE_HOP_ENABLED */
 
-    /* SysPm callback params */
-    cy_stc_syspm_callback_params_t sysClkCallbackParams1 =
-    {
-        .base       = CYBSP_MSC1_HW,
-        .context    = &cy_capsense_context
-    };
+        /* Record a calibration made at boot, once the MSC blocks are idle;
+         * the flash write waits until the first scan has been started */
+        if (!first_scan)
+        {
+            (void)cal_store_commit();
+        }
 
-    /* Callback declaration for Deep Sleep mode */
-    cy_stc_syspm_callback_t sysClkCallback =
-    {
-        .callback       = &deep_sleep_callback,
-        .type           = CY_SYSPM_DEEPSLEEP,
-        .skipMode       = 0UL,
-        .callbackParams = &sysClkCallbackParams,
-        .prevItm        = NULL,
-        .nextItm        = NULL,
-        .order          = 1
-    };
+        /* Scan the frame of this wake-up. The power level decides which
+         * widget is scanned; a touchpad frame scans only the window around a
+         * tracked finger, or all of it while the panel is wet. */
+        scan_start = stage_profile_now();
+        scan_slots = SCAN_PIPELINE_ALL_SLOTS;
+        if (CY_CAPSENSE_PROXIMITY0_WDGT_ID == power_policy_get_config()->scan_widget)
+        {
+            scan_stage = STAGE_PROFILE_PROX_SCAN;
+        }
+        else
+        {
+            scan_stage = STAGE_PROFILE_TOUCH_SCAN;
+            if (!liquid_detect_is_wet())
+            {
+                scan_slots = touch_roi_get_slots();
+            }
+        }
+        if (CY_CAPSENSE_STATUS_SUCCESS != scan_pipeline_start_slots(power_policy_get_config()->scan_widget, scan_slots))
+        {
+            scan_stage = STAGE_PROFILE_COUNT;
+        }
 
-    /* Callback declaration for Deep Sleep mode */
-    cy_stc_syspm_callback_t sysClkCallback1 =
-    {
-        .callback       = &deep_sleep_callback,
-        .type           = CY_SYSPM_DEEPSLEEP,
-        .skipMode       = 0UL,
-        .callbackParams = &sysClkCallbackParams1,
-        .prevItm        = NULL,
-        .nextItm        = NULL,
-        .order          = 1
-    };
+        /* The tuner is not needed before the first scan; bring it up while
+         * that scan runs */
+        if (first_scan)
+        {
+            first_scan = false;
+            boot_profile_mark(BOOT_PROFILE_FIRST_SCAN);
+            start_tuner();
+        }
 
-    /* Register EzI2C Deep Sleep callback */
-    Cy_SysPm_RegisterCallback(&ezi2cCallback);
-    
-    /* Register Deep Sleep callback */
-    Cy_SysPm_RegisterCallback(&sysClkCallback);
-    
-    /* Register Deep Sleep callback */
-    Cy_SysPm_RegisterCallback(&sysClkCallback1);
+        /* Gestures come only from touchpad frames; bring the UART up while
+         * the first touchpad scan runs, before any gesture is posted */
+        if (CY_CAPSENSE_TOUCHPAD0_WDGT_ID == power_policy_get_config()->scan_widget)
+        {
+            start_uart();
+        }
 
-    for (;;)
-    {
-        /* WDT interrupt source */
-        wdt_trigger();
+        /* Wait for the frame in CPU Sleep; the MSC interrupts wake the CPU.
+         * The scan writes the raw counts in place, so the frame is processed
+         * only once it has completed */
+        if (scan_pipeline_is_busy())
+        {
+            stage_start = stage_profile_now();
+            scan_pipeline_wait();
+            scan_wait_cycles = stage_profile_elapsed(stage_start);
+            stage_profile_record(STAGE_PROFILE_SCAN_WAIT, scan_wait_cycles);
+        }
+        frame_widget = scan_pipeline_take();
 
-        if (CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(&cy_capsense_context))
+        power_events = POWER_POLICY_EVENT_NONE;
+
+        if(CY_CAPSENSE_PROXIMITY0_WDGT_ID == frame_widget)
         {
-            /* Check the system state */
-            if(proximity_state == 0)
+            /* Process only the proximity widget and check if the proximity
+             * sensor is active */
+            stage_start = stage_profile_now();
+            if(prox_baseline_process())
             {
-                /* 100MS Deep-Sleep state, scan only proximity sensor */
-                Cy_CapSense_ScanSlots(cy_capsense_context.ptrWdConfig[CY_CAPSENSE_PROXIMITY0_WDGT_ID].firstSlotId,
-                    cy_capsense_context.ptrWdConfig[CY_CAPSENSE_PROXIMITY0_WDGT_ID].numSlots, &cy_capsense_context);
-
-                /* Process only the proximity widget */
-                Cy_CapSense_ProcessWidget(CY_CAPSENSE_PROXIMITY0_WDGT_ID, &cy_capsense_context);
+                power_events |= POWER_POLICY_EVENT_PROXIMITY;
 
-                /* Check if proximity sensor is active */
-                proximity_state = Cy_CapSense_IsProximitySensorActive(CY_CAPSENSE_PROXIMITY0_WDGT_ID, CY_CAPSENSE_PROXIMITY0_SNS0_ID, &cy_capsense_context);
+                /* Time the approach until the first gesture */
+                if (!approach_pending)
+                {
+                    approach_pending = true;
+                    approach_us = 0U;
+                }
+            }
+            stage_profile_since(STAGE_PROFILE_PROX_PROCESS, stage_start);
 
+            /* A steady signal below the proximity threshold is liquid. A
+             * frame discarded by the frozen baseline has no new diff. */
+            if (!prox_baseline_is_frozen())
+            {
+                liquid_detect_proximity();
             }
 
-            if(proximity_state)
+            telemetry_publish(CY_CAPSENSE_PROXIMITY0_WDGT_ID, 0U, NULL);
+        }
+
+        if(CY_CAPSENSE_TOUCHPAD0_WDGT_ID == frame_widget)
+        {
+            /* increment the timestamp register by the device time since the
+             * last touchpad frame, measured on the WDT counter; the wet
+             * intervals are shorter than one tick */
+            cy_capsense_context.ptrCommonContext->timestampInterval = gesture_clock_take_ticks();
+            Cy_CapSense_IncrementGestureTimestamp(&cy_capsense_context);
+
+            /* Look for conducted noise before the frame is filtered */
+            touch_roi_prepare(scan_pipeline_get_slots());
+#if NOISE_HOP_ENABLED
+            (void)noise_hop_check();
+#endif /* NOISE_HOP_ENABLED */
+
+            /* Filter the whole frame with the stages of the panel state */
+            filter_stages = liquid_detect_is_wet() ? RAW_FILTER_WET_STAGES : RAW_FILTER_DRY_STAGES;
+            stage_start = stage_profile_now();
+            raw_filter_apply(filter_stages);
+            if (0U != filter_stages)
             {
-                /* Configure the wake up period to 10ms */
-                DESIRED_WDT_INTERVAL_MS = 10000U;
-                
-                /* Initialize baselines */
-                Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_PROXIMITY0_WDGT_ID, &cy_capsense_context);
+                stage_profile_since(STAGE_PROFILE_RAW_FILTER, stage_start);
+            }
 
-                /* Scan touchpad widget */
-                Cy_CapSense_ScanSlots(cy_capsense_context.ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].firstSlotId,
-                    cy_capsense_context.ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].numSlots, &cy_capsense_context);
+            /* Process only the touchpad widget, filtering the wet sensors
+             * first */
+            stage_start = stage_profile_now();
+            liquid_detect_filter();
+            Cy_CapSense_ProcessWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+            liquid_detect_touchpad();
+            stage_profile_since(STAGE_PROFILE_TOUCH_PROCESS, stage_start);
+
+            /* decode all the gestures once per timestamp tick; the gesture
+             * distance thresholds are tuned for that frame rate */
+            if (0U != cy_capsense_context.ptrCommonContext->timestampInterval)
+            {
+                stage_start = stage_profile_now();
+                gest = Cy_CapSense_DecodeWidgetGestures(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+                stage_profile_since(STAGE_PROFILE_DECODE, stage_start);
+            }
 
-                /* increment the timestamp register */
-                Cy_CapSense_IncrementGestureTimestamp(&cy_capsense_context);
+            /* Track the last reported position; gestures such as a click
+             * are decoded after the finger has already lifted */
+            touch_info = Cy_CapSense_GetTouchInfo(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+            if (touch_info->numPosition > 0U)
+            {
+                last_position = touch_info->ptrPosition[0];
+            }
 
-                /* Process only the touchpad widget */
-                Cy_CapSense_ProcessWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+            /* Window of the next touchpad frame */
+            touch_roi_update(touch_info);
 
-                /* decode all the gestures */
-                gest = Cy_CapSense_DecodeWidgetGestures(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, &cy_capsense_context);
+            /* Keep the frame for the gesture actions that look back */
+            touch_history_push(touch_info, cy_capsense_context.ptrCommonContext->timestamp,
+                               (gest != lgest) ? gest : 0U,
+                               liquid_detect_is_wet() ? TOUCH_HISTORY_FLAG_WET : 0U);
 
-                if (gest != lgest)
+            if (gest != lgest)
+            {
+                if (gest > 0U)
                 {
-                    if (gest > 0U)
+                    /* Queue the event for the UART; never waits on the UART.
+                     * The UART is left off after Deep Sleep until needed */
+                    low_power_resume(LOW_POWER_UART);
+                    (void)gesture_log_post(gest, cy_capsense_context.ptrCommonContext->timestamp,
+                                           last_position.x, last_position.y);
+
+                    /* Run the action registered for the gesture */
+                    (void)gesture_table_dispatch(gest);
+
+                    if (approach_pending)
                     {
-                        switch (gest)
-                        {
-                        case SINGLE_CLICK : Cy_SCB_UART_PutString(SCB1, "Single Click \r\n"); /* Print Charaters on UART Terminal */
-                        toggle_pwm(); /* Turns LED ON/OFF based on touch status */
-                        break;
-
-                        case DOUBLE_CLICK : Cy_SCB_UART_PutString(SCB1, "Double Click \r\n");
-                        toggle_pwm();
-                        break;
-
-                        case SCROLL_DOWN :Cy_SCB_UART_PutString(SCB1, "Scroll Down \r\n");
-                        decr_brightness(bright); /* Decreases brightness of an LED */
-                        break;
-
-                        case SCROLL_UP :Cy_SCB_UART_PutString(SCB1, "Scroll up \r\n");
-                        incr_brightness(bright); /* Increases brightness of an LED */
-                        break;
-
-                        case SCROLL_RIGHT : Cy_SCB_UART_PutString(SCB1, "Scroll right \r\n");
-                        incr_brightness(bright); 
-                        break;
-
-                        case SCROLL_LEFT : Cy_SCB_UART_PutString(SCB1, "Scroll left \r\n");
-                        decr_brightness(bright); 
-                        break;
-
-                        case FLICK_UP: Cy_SCB_UART_PutString(SCB1, "flick up \r\n");
-                        incr_brightness(bright); 
-                        break;
-
-                        case FLICK_DOWN : Cy_SCB_UART_PutString(SCB1, "flick down \r\n");
-                        decr_brightness(bright); 
-                        break;
-
-                        case FLICK_RIGHT : Cy_SCB_UART_PutString(SCB1, "flick right \r\n");
-                        incr_brightness(bright); 
-                        break;
-
-                        case FLICK_LEFT : Cy_SCB_UART_PutString(SCB1, "flick left \r\n");
-                        decr_brightness(bright);
-                        break;
-
-                        case TWO_FINGER_CLICK : Cy_SCB_UART_PutString(SCB1, "Two Finger Click \r\n");
-                        Cy_GPIO_Inv(CYBSP_USER_LED3_PORT, CYBSP_USER_LED3_NUM); /* Invert LED3 (out value = ~(out value)) */
-                        break;
-
-                        case TWO_FINGER_ZOOM_OUT : Cy_SCB_UART_PutString(SCB1, "Two Finger Zoom OUT \r\n");
-                        decr_brightness(bright);
-                        break;
-
-                        case TWO_FINGER_ZOOM_IN : Cy_SCB_UART_PutString(SCB1, "Two Finger Zoom In \r\n");
-                        incr_brightness(bright);
-                        break;
-
-                        default :
-                            sprintf(buf, "%lx", (unsigned long)gest); /* Sends formatted output to a string */
-                            Cy_SCB_UART_PutString(SCB1, buf); /* Print buffer value on UART Terminal */
-                            Cy_SCB_UART_PutString(SCB1, "\r\n"); /* Print Charaters on UART Terminal */
-
-                            break;
-                        }
+                        approach_pending = false;
+                        stage_profile_record(STAGE_PROFILE_FIRST_GESTURE,
+                                             approach_us * (stage_profile_get_cpu_hz() / 1000000UL));
                     }
-
-                    /* Reset varibles */
-                    soft_counter = 0;
-                    lgest = gest;
                 }
 
-                /* If the CapSense touch is inactive, increment the software counter */
-                if(gest == 0)
-                {
-                    soft_counter++;
-                }
+                lgest = gest;
+            }
 
-                if(soft_counter > 100)
-                {
-                    /* CapSense touch is inactive. Increase Deep-Sleep duration */
-                    DESIRED_WDT_INTERVAL_MS = 100000U;
+#if LED_CONTROL_CONTINUOUS
+            /* Move the brightness with the finger of this frame */
+            led_control_track(DESIRED_WDT_INTERVAL_MS);
+#endif /* LED_CONTROL_CONTINUOUS */
 
-                    /* Reset counter */
-                    soft_counter = 0;
+            telemetry_publish(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, gest, touch_info);
 
-                    /* Clear Proximity Sensor status */
-                    proximity_state = 0;
-                }
+            /* A finger on the touchpad or a gesture keeps the device active */
+            if ((0U != gest) || (touch_info->numPosition > 0U))
+            {
+                power_events |= POWER_POLICY_EVENT_TOUCH;
             }
+        }
 
-            /* Establishes synchronized communication with the CapSense Tuner tool */
-            Cy_CapSense_RunTuner(&cy_capsense_context);
+        /* Apply the brightness set on this frame */
+        led_control_apply();
+
+        /* Device time of the approach, limited so that it fits the cycle
+         * count of the histogram */
+        if (approach_pending && (approach_us < APPROACH_MAX_US))
+        {
+            approach_us += DESIRED_WDT_INTERVAL_MS;
         }
+
+        /* Move between power levels; the new interval applies from the
+         * next wake-up */
+        frame_us = DESIRED_WDT_INTERVAL_MS;
+        power_policy_update(frame_us, power_events);
+        power_policy_set_wet(liquid_detect_is_wet());
+        DESIRED_WDT_INTERVAL_MS = power_policy_get_interval_us();
+
+        /* Serve requests of the I2C host to the telemetry region */
+        telemetry_service();
+
+#if TUNER_ENABLED
+        /* Synchronize with the CapSense Tuner tool while it is connected */
+        stage_start = stage_profile_now();
+        tuner_service_run(frame_us);
+        stage_profile_since(STAGE_PROFILE_TUNER, stage_start);
+#else
+        (void)frame_us;
+#endif /* TUNER_ENABLED */
     }
 }
 
@@ -487,6 +691,17 @@ void wdt_isr(void)
  *******************************************************************************/
 void wdt_trigger(void){
 
+    /* SysTick timestamp of the return from Deep Sleep */
+    static uint32_t loop_start = 0U;
+    static bool loop_started = false;
+    uint32_t start;
+    uint32_t ilo_ticks;
+
+    if (loop_started)
+    {
+        stage_profile_since(STAGE_PROFILE_LOOP, loop_start);
+    }
+
     if (flag)
     {
         /* Clear the interrupt flag */
@@ -496,105 +711,206 @@ void wdt_trigger(void){
         Cy_WDT_SetMatch((uint16_t)(ilo_compensated_counts + Cy_WDT_GetMatch())); /* Program the next WDT event */
     }
 
-    /* Start ILO measurement */
-    Cy_SysClk_IloStartMeasurement();
-
     /* Get the ILO compensated counts i.e. the actual counts for the
         desired ILO frequency. ILO default accuracy is +/- 60%.
-        Note that DESIRED_WDT_INTERVAL should be less than the total
-        count time */
-    while (CY_SYSCLK_SUCCESS != Cy_SysClk_IloCompensate(DESIRED_WDT_INTERVAL_MS, &ilo_cycles)); /* The desired WDT delay in second */
-    ilo_compensated_counts = (uint32_t)ilo_cycles;
+        The counts are cached per interval; the ILO is measured again
+        only when the recalibration period has expired */
+    start = stage_profile_now();
+    ilo_compensated_counts = ilo_comp_get_counts(DESIRED_WDT_INTERVAL_MS);
+    stage_profile_since(STAGE_PROFILE_ILO, start);
+
+    /* Active CPU time of this wake-up: the time awake without the scan wait.
+     * The CPU only sleeps from here */
+    if (loop_started)
+    {
+        stage_profile_record(STAGE_PROFILE_ACTIVE, stage_profile_elapsed(loop_start) - scan_wait_cycles);
+    }
+    scan_wait_cycles = 0U;
 
-    /* Stop ILO measurement before entering deep sleep mode */
-    Cy_SysClk_IloStopMeasurement();
+    /* Enter deep sleep mode once the UART tx buffer is empty and the scan
+       has completed. The PWM stops in deep sleep; LED_CONTROL_SLEEP_WHILE_LIT
+       keeps only the CPU sleeping while LED1 is lit or fading instead */
+    if ((0U != LED_CONTROL_SLEEP_WHILE_LIT) && led_control_is_lit())
+    {
+        low_power_enter_sleep(&flag);
+    }
+    else
+    {
+        low_power_enter_deep_sleep();
+    }
 
-    /* Delay to empty the UART tx buffer */
-    Cy_SysLib_Delay(DELAY_MS);
+    /* Time from the WDT match to here, counted in ILO ticks and converted
+     * with the compensated ILO rate; SysTick stops in Deep Sleep */
+    if (flag && (0U != ilo_compensated_counts))
+    {
+        ilo_ticks = (Cy_WDT_GetCount() - Cy_WDT_GetMatch()) & WDT_COUNTER_MASK;
+        stage_profile_record(STAGE_PROFILE_WAKE, ilo_ticks *
+            ((DESIRED_WDT_INTERVAL_MS * (stage_profile_get_cpu_hz() / 1000000UL)) / ilo_compensated_counts));
+    }
 
-    /* Enter deep sleep mode */
-    Cy_SysPm_CpuEnterDeepSleep();
+    loop_start = stage_profile_now();
+    loop_started = true;
 }
 
 /*******************************************************************************
  * Function Name: toggle_pwm
  ********************************************************************************
  * Summary:
- *  Function to process the touch. Depending on the command passed as parameter,
- *  new compare values are calculated.
- *
- *  The values are written to the respective buffer registers and a compare
- *  swap is issued.
+ *  Turns LED1 off, or back on at the brightness it had when turned off. The
+ *  compare value is written by led_control_ramp().
  *
  *******************************************************************************/
 void toggle_pwm()
 {
-    state = !state;
+    led_control_toggle();
+}
+
+/*******************************************************************************
+ * Function Name: incr_brightness
+ ********************************************************************************
+ * Summary:
+ *  Increases the LED1 brightness. The compare value is written by
+ *  led_control_ramp() through the gamma curve.
+ *
+ * Parameters:
+ *  inc: number of LED_CONTROL_LEVEL_MAX levels
+ *
+ *******************************************************************************/
+void incr_brightness(uint16_t inc)
+{
+    led_control_adjust((int32_t)inc);
+}
+
+/*******************************************************************************
+ * Function Name: decr_brightness
+ ********************************************************************************
+ * Summary:
+ *  Decreases the LED1 brightness. The compare value is written by
+ *  led_control_ramp() through the gamma curve.
+ *
+ * Parameters:
+ *  dec: number of LED_CONTROL_LEVEL_MAX levels
+ *
+ *******************************************************************************/
+void decr_brightness(uint16_t dec)
+{
+    led_control_adjust(-(int32_t)dec);
+}
 
-    if (state)
+/*******************************************************************************
+ * Function Name: power_level_changed
+ ********************************************************************************
+ * Summary:
+ *  Power level transition hook. The proximity baseline is frozen while the
+ *  touchpad is scanned and restarted when the proximity sensor takes over.
+ *  The proximity wet state is left to the touchpad sensors meanwhile.
+ *
+ * Parameters:
+ *  from_level: previous level
+ *  to_level: new level
+ *
+ *******************************************************************************/
+static void power_level_changed(uint32_t from_level, uint32_t to_level)
+{
+    bool was_touchpad = (CY_CAPSENSE_TOUCHPAD0_WDGT_ID == power_levels[from_level].scan_widget);
+    bool is_touchpad = (CY_CAPSENSE_TOUCHPAD0_WDGT_ID == power_levels[to_level].scan_widget);
+
+    if (!was_touchpad && is_touchpad)
     {
-        /* Modify the compare value here */
-        Cy_TCPWM_PWM_SetCompare0(pwm2_HW, pwm2_NUM, bright);
-        Cy_TCPWM_PWM_SetCompare1(pwm2_HW, pwm2_NUM, 1000U - bright);
+        /* Keep the hand out of the proximity baseline */
+        prox_baseline_freeze();
+
+        /* The proximity wet state cannot age while the sensor is not scanned */
+        liquid_detect_proximity_clear();
     }
+    else if (was_touchpad && !is_touchpad)
+    {
+        /* Restart the proximity baseline from a fresh scan */
+        prox_baseline_resume();
 
+        /* The hand left without a gesture */
+        approach_pending = false;
+    }
     else
     {
-        /* Modify the compare value here */
-        Cy_TCPWM_PWM_SetCompare0(pwm2_HW, pwm2_NUM, 0U);
-        Cy_TCPWM_PWM_SetCompare1(pwm2_HW, pwm2_NUM, 1000U);
+        /* Same widget, nothing to do */
     }
 }
 
 /*******************************************************************************
- * Function Name: incr_brightness
+ * Function Name: gesture_toggle_led
  ********************************************************************************
  * Summary:
- *  Function to process the touch. Depending on the command passed as parameter,
- *  new compare values are calculated.
+ *  Gesture action: turns the LED ON/OFF.
  *
- * The values are written to the respective buffer registers and compare is issued.
+ *******************************************************************************/
+static void gesture_toggle_led(uint32_t gesture)
+{
+    toggle_pwm();
+}
+
+/*******************************************************************************
+ * Function Name: brightness_step
+ ********************************************************************************
+ * Summary:
+ *  Returns the brightness change of a gesture: the base step, multiplied for a
+ *  fast single-finger movement in the touch history.
  *
  *******************************************************************************/
-void incr_brightness(uint16_t inc)
+static uint16_t brightness_step(void)
 {
-    if(inc<1000U)
+    touch_history_summary_t recent;
+    uint32_t scale = 1U;
+
+    if (touch_history_summarize(BRIGHTNESS_ACCEL_SPAN, &recent) && (1U == recent.max_fingers) &&
+        (0U != recent.ticks))
     {
-        inc++;
-        uint16_t compare = Cy_TCPWM_PWM_GetCompare0(pwm2_HW, pwm2_NUM); /* Get the currently existing period value */
-        uint16_t new_compare = compare + inc;
+        uint32_t dx = (uint32_t)((recent.dx < 0) ? -recent.dx : recent.dx);
+        uint32_t dy = (uint32_t)((recent.dy < 0) ? -recent.dy : recent.dy);
 
-        if(new_compare > Cy_TCPWM_PWM_GetPeriod0(pwm2_HW, pwm2_NUM)){
-            new_compare = Cy_TCPWM_PWM_GetPeriod0(pwm2_HW, pwm2_NUM);
+        scale += ((dx + dy) / recent.ticks) / BRIGHTNESS_ACCEL_SPEED;
+        if (scale > BRIGHTNESS_ACCEL_MAX)
+        {
+            scale = BRIGHTNESS_ACCEL_MAX;
         }
-        Cy_TCPWM_PWM_SetCompare0(pwm2_HW, pwm2_NUM, new_compare); /* Modify the compare value here */
     }
+    return (uint16_t)(bright * scale);
 }
 
 /*******************************************************************************
- * Function Name: decr_brightness
+ * Function Name: gesture_brightness_up
  ********************************************************************************
  * Summary:
- *  Function to process the touch. Depending on the command passed as parameter,
- *  new compare values are calculated.
- *
- *  The values are written to the respective buffer registers and a compare is issued.
+ *  Gesture action: increases the LED brightness.
  *
  *******************************************************************************/
+static void gesture_brightness_up(uint32_t gesture)
+{
+    incr_brightness(brightness_step());
+}
 
-void decr_brightness(uint16_t dec)
+/*******************************************************************************
+ * Function Name: gesture_brightness_down
+ ********************************************************************************
+ * Summary:
+ *  Gesture action: decreases the LED brightness.
+ *
+ *******************************************************************************/
+static void gesture_brightness_down(uint32_t gesture)
 {
-    uint16_t compare = Cy_TCPWM_PWM_GetCompare0(pwm2_HW, pwm2_NUM); /* Get the currently existing period value */
-    uint16_t new_compare;
+    decr_brightness(brightness_step());
+}
 
-    if(compare >= dec){
-        new_compare = compare - dec;
-    }
-    else
-    {
-        new_compare = 0;
-    }
-    Cy_TCPWM_PWM_SetCompare0(pwm2_HW, pwm2_NUM, new_compare); /* Modify the compare value here */
+/*******************************************************************************
+ * Function Name: gesture_toggle_led3
+ ********************************************************************************
+ * Summary:
+ *  Gesture action: inverts LED3.
+ *
+ *******************************************************************************/
+static void gesture_toggle_led3(uint32_t gesture)
+{
+    Cy_GPIO_Inv(CYBSP_USER_LED3_PORT, CYBSP_USER_LED3_NUM);
 }
 
 /*******************************************************************************
@@ -635,6 +951,10 @@ static void initialize_capsense(void)
 
     if (CY_CAPSENSE_STATUS_SUCCESS == status)
     {
+        /* The MSC interrupts signal completed frames to the scan pipeline */
+        scan_pipeline_init(&cy_capsense_context);
+        prox_baseline_init(&cy_capsense_context);
+
         /* Initialize CapSense interrupt for MSC 0 */
         Cy_SysInt_Init(&capsense_msc0_interrupt_config, capsense_msc0_isr);
         NVIC_ClearPendingIRQ(capsense_msc0_interrupt_config.intrSrc);
@@ -645,8 +965,9 @@ static void initialize_capsense(void)
         NVIC_ClearPendingIRQ(capsense_msc1_interrupt_config.intrSrc);
         NVIC_EnableIRQ(capsense_msc1_interrupt_config.intrSrc);
 
-        /* Initialize the CapSense firmware modules. */
-        status = Cy_CapSense_Enable(&cy_capsense_context);
+        /* Initialize the CapSense firmware modules. The CDAC calibration
+         * of a previous boot is restored from flash if it is still valid. */
+        status = cal_store_start(&cy_capsense_context);
     }
 
     if(status != CY_CAPSENSE_STATUS_SUCCESS)
@@ -662,11 +983,14 @@ static void initialize_capsense(void)
  ********************************************************************************
  * Summary:
  *  Wrapper function for handling interrupts from CapSense MSC0 block.
+ *  Signals the end of a frame to the scan pipeline.
  *
  *******************************************************************************/
 static void capsense_msc0_isr(void)
 {
     Cy_CapSense_InterruptHandler(CY_MSC0_HW, &cy_capsense_context);
+    scan_pipeline_isr();
+    scan_profile_isr();
 }
 
 /*******************************************************************************
@@ -674,11 +998,31 @@ static void capsense_msc0_isr(void)
  ********************************************************************************
  * Summary:
  *  Wrapper function for handling interrupts from CapSense MSC1 block.
+ *  Signals the end of a frame to the scan pipeline.
  *
  *******************************************************************************/
 static void capsense_msc1_isr(void)
 {
     Cy_CapSense_InterruptHandler(CY_MSC1_HW, &cy_capsense_context);
+    scan_pipeline_isr();
+    scan_profile_isr();
+}
+
+/*******************************************************************************
+ * Function Name: scan_profile_isr
+ ********************************************************************************
+ * Summary:
+ *  Records the scan time of a frame once the scan pipeline has seen it
+ *  complete. Called from both MSC interrupt handlers.
+ *
+ *******************************************************************************/
+static void scan_profile_isr(void)
+{
+    if ((STAGE_PROFILE_COUNT != scan_stage) && !scan_pipeline_is_busy())
+    {
+        stage_profile_since(scan_stage, scan_start);
+        scan_stage = STAGE_PROFILE_COUNT;
+    }
 }
 
 /*******************************************************************************
@@ -713,6 +1057,7 @@ static void initialize_capsense_tuner(void)
     /* Enable the interrupt */
     NVIC_EnableIRQ(ezi2c_intr_config.intrSrc);
 
+#if TUNER_ENABLED
     /* Set the CapSense data structure as the I2C buffer to be exposed to the
      * master on primary slave address interface. Any I2C host tools such as
      * the Tuner or the Bridge Control Panel can read this buffer but you can
@@ -722,96 +1067,102 @@ static void initialize_capsense_tuner(void)
         sizeof(cy_capsense_tuner), sizeof(cy_capsense_tuner),
         &ezi2c_context);
 
+    /* The tuner is synchronized only once it reads or writes this buffer */
+    tuner_service_init(CYBSP_EZI2C_HW, &ezi2c_context, &cy_capsense_context);
+#endif /* TUNER_ENABLED */
+
+    /* The compact telemetry frame and the stage profile histograms are
+     * exposed on the secondary slave address; only the control word is
+     * writable */
+    Cy_SCB_EZI2C_SetBuffer2(CYBSP_EZI2C_HW, (uint8_t *)&telemetry_region,
+        sizeof(telemetry_region), TELEMETRY_RW_BOUNDARY,
+        &ezi2c_context);
+
     /* Enables the SCB block for the EZI2C operation */
     Cy_SCB_EZI2C_Enable(CYBSP_EZI2C_HW);
 }
 
 /*******************************************************************************
- * Function Name: ezi2c_isr
+ * Function Name: start_tuner
  ********************************************************************************
  * Summary:
- * Wrapper function for handling interrupts from EZI2C block.
+ *  Brings up the EZI2C slave for the tuner and the telemetry region, once,
+ *  and hands it to the Deep Sleep callback.
  *
  *******************************************************************************/
-static void ezi2c_isr(void)
+static void start_tuner(void)
 {
-    Cy_SCB_EZI2C_Interrupt(CYBSP_EZI2C_HW, &ezi2c_context);
+    uint32_t start;
+
+    if (tuner_started)
+    {
+        return;
+    }
+    start = stage_profile_now();
+
+    initialize_capsense_tuner();
+    low_power_start(LOW_POWER_EZI2C);
+
+    tuner_started = true;
+    boot_profile_since(BOOT_PROFILE_EZI2C, start);
 }
 
 /*******************************************************************************
- * Function Name: deep_sleep_callback
+ * Function Name: start_uart
  ********************************************************************************
  * Summary:
- * Deep Sleep callback implementation. It changes PWM and UART status based on
- * the power state and MCU state.
- *
- * Parameters:
- *  callbackParams: The pointer to the callback parameters structure
- *  cy_stc_syspm_callback_params_t.
- *  mode: Callback mode, see cy_en_syspm_callback_mode_t
- *
- * Return:
- *  Entered status, see cy_en_syspm_status_t.
+ *  Brings up the debug UART and the gesture log that drains into it, once,
+ *  and queues the banner.
  *
  *******************************************************************************/
-cy_en_syspm_status_t deep_sleep_callback(
-    cy_stc_syspm_callback_params_t *callbackParams, cy_en_syspm_callback_mode_t mode)
+static void start_uart(void)
 {
-    cy_en_syspm_status_t ret_val = CY_SYSPM_FAIL;
-
-    switch (mode)
-    {    /* Check if the device is ready to enter the low power mode */
-    case CY_SYSPM_CHECK_READY:
-
-        while(Cy_SCB_UART_IsTxComplete(scb_1_HW) == 0U)
-        {
-            /* Wait until the TX FIFO
-             * and Shifter are empty and there is no more data to send. */
-        }
-
-        /* Disable the UART */
-        Cy_SCB_UART_Disable(scb_1_HW, &scb_1_context);
-
-        ret_val = CY_SYSPM_SUCCESS;
-        break;
-
-        /* Roll back the actions performed in the previously executed callback with CY_SYSPM_CHECK_READY */
-    case CY_SYSPM_CHECK_FAIL:
-
-        /* Enable the UART */
-        Cy_SCB_UART_Enable(scb_1_HW);
+    cy_en_scb_uart_status_t status;
+    uint32_t start;
 
-        ret_val = CY_SYSPM_SUCCESS;
-        break;
-
-        /* Performs the actions to be done before entering into the low power mode */
-    case CY_SYSPM_BEFORE_TRANSITION:
+    if (uart_started)
+    {
+        return;
+    }
+    start = stage_profile_now();
 
-        /* Disable the PWM */
-        Cy_TCPWM_PWM_Disable(pwm2_HW, pwm2_NUM);
+    /* Initializes the SCB for debug UART port */
+    status = Cy_SCB_UART_Init(SCB1, &scb_1_config, &scb_1_context);
 
-        ret_val = CY_SYSPM_SUCCESS;
-        break;
+    /* SCB UART init failed. Stop program execution */
+    if (status != CY_SCB_UART_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
 
-        /* Performs the actions to be done after exiting the low power mode if entered */
-    case CY_SYSPM_AFTER_TRANSITION:
+    /* Gesture events are sent from the UART TX interrupt */
+    gesture_log_init(SCB1);
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&scb_1_isr_cfg, gesture_log_isr))
+    {
+        CY_ASSERT(0);
+    }
+    NVIC_EnableIRQ(scb_1_isr_cfg.intrSrc);
 
-        /* Enable and Start the PWM */
-        Cy_TCPWM_PWM_Enable(pwm2_HW, pwm2_NUM);
-        Cy_TCPWM_TriggerStart(pwm2_HW, pwm2_MASK);
+    /* Enables the SCB block for the UART operation */
+    low_power_start(LOW_POWER_UART);
 
-        /* Enable the UART */
-        Cy_SCB_UART_Enable(scb_1_HW);
+    /* Print Charaters on UART Terminal, from the TX interrupt */
+    (void)gesture_log_print("Touchpad 10x16\r\n");
 
-        ret_val = CY_SYSPM_SUCCESS;
-        break;
+    uart_started = true;
+    boot_profile_since(BOOT_PROFILE_UART, start);
+}
 
-    default:
-        /* Don't do anything in the other modes */
-        ret_val = CY_SYSPM_SUCCESS;
-        break;
-    }
-    return ret_val;
+/*******************************************************************************
+ * Function Name: ezi2c_isr
+ ********************************************************************************
+ * Summary:
+ * Wrapper function for handling interrupts from EZI2C block.
+ *
+ *******************************************************************************/
+static void ezi2c_isr(void)
+{
+    Cy_SCB_EZI2C_Interrupt(CYBSP_EZI2C_HW, &ezi2c_context);
 }
 
 /* [] END OF FILE */
@@ -0,0 +1,238 @@
+/******************************************************************************
+ * File Name: boot_profile.c
+ *
+ * Description: Boot phase timing. The record is placed in the .noinit section,
+ * which the startup code leaves alone, and is checked before use: after a power
+ * cycle it holds noise and is started again, after a warm reset it is kept as
+ * the record of the previous boot.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stddef.h>
+#include "cy_pdl.h"
+#include "boot_profile.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define BOOT_PROFILE_MAGIC              (0x544F4F42UL)  /* "BOOT" */
+#define BOOT_PROFILE_WORDS              ((sizeof(boot_profile_record_t) / sizeof(uint32_t)) - 1U)
+#define BOOT_PROFILE_MAX_BOOTS          (0xFFFFU)
+
+_Static_assert(0U == (sizeof(boot_profile_record_t) % sizeof(uint32_t)), "Record is checked by words");
+_Static_assert(BOOT_PROFILE_COUNT <= 32U, "Phases are recorded in a 32-bit mask");
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Not cleared by the startup code */
+CY_NOINIT static boot_profile_record_t record;
+
+/* Record found at boot, when it was valid */
+static boot_profile_record_t previous;
+static bool previous_valid = false;
+
+/* Start of the phase marked next, and the cycles marked so far */
+static uint32_t phase_start = 0U;
+static uint32_t total_cycles = 0U;
+
+/*******************************************************************************
+ * Function Name: checksum
+ ********************************************************************************
+ * Summary:
+ *  Returns the check word of a record.
+ *
+ *******************************************************************************/
+static uint32_t checksum(const boot_profile_record_t *rec)
+{
+    const uint32_t *words = (const uint32_t *)rec;
+    uint32_t sum = 0U;
+
+    for (uint32_t i = 0U; i < BOOT_PROFILE_WORDS; i++)
+    {
+        sum ^= words[i];
+    }
+    return ~sum;
+}
+
+/*******************************************************************************
+ * Function Name: is_valid
+ ********************************************************************************
+ * Summary:
+ *  Returns true if the record was written by this layout version.
+ *
+ *******************************************************************************/
+static bool is_valid(const boot_profile_record_t *rec)
+{
+    return (BOOT_PROFILE_MAGIC == rec->magic) && (BOOT_PROFILE_VERSION == rec->version) &&
+           (checksum(rec) == rec->check);
+}
+
+/*******************************************************************************
+ * Function Name: seal
+ ********************************************************************************
+ * Summary:
+ *  Updates the check word after a change, so that a reset at any point leaves
+ *  a valid record of the phases recorded until then.
+ *
+ *******************************************************************************/
+static void seal(void)
+{
+    record.cpu_hz = Cy_SysClk_ClkSysGetFrequency();
+    record.check = checksum(&record);
+}
+
+/*******************************************************************************
+ * Function Name: boot_profile_init
+ ********************************************************************************
+ * Summary:
+ *  Starts the cycle counter and the first phase. Call first in main(). A valid
+ *  record left by the previous boot is kept for boot_profile_get_previous().
+ *
+ *******************************************************************************/
+void boot_profile_init(void)
+{
+    uint32_t boots = 1U;
+
+    stage_profile_start();
+    phase_start = stage_profile_now();
+    total_cycles = 0U;
+
+    previous_valid = is_valid(&record);
+    if (previous_valid)
+    {
+        previous = record;
+        boots = (previous.boots < BOOT_PROFILE_MAX_BOOTS) ? (previous.boots + 1U) : BOOT_PROFILE_MAX_BOOTS;
+    }
+
+    record = (boot_profile_record_t){ 0 };
+    record.magic = BOOT_PROFILE_MAGIC;
+    record.version = BOOT_PROFILE_VERSION;
+    record.boots = (uint16_t)boots;
+    seal();
+}
+
+/*******************************************************************************
+ * Function Name: boot_profile_mark
+ ********************************************************************************
+ * Summary:
+ *  Ends a phase marked by main(), which started where the previous one ended.
+ *  Marking BOOT_PROFILE_FIRST_SCAN ends the boot.
+ *
+ * Parameters:
+ *  phase: phase that has just ended
+ *
+ *******************************************************************************/
+void boot_profile_mark(boot_profile_phase_t phase)
+{
+    uint32_t cycles = stage_profile_elapsed(phase_start);
+
+    phase_start = stage_profile_now();
+    if (0U != (record.done & (1UL << BOOT_PROFILE_FIRST_SCAN)))
+    {
+        return;
+    }
+
+    total_cycles += cycles;
+    record.cycles[phase] = cycles;
+    record.done |= (1UL << phase);
+    if (BOOT_PROFILE_FIRST_SCAN == phase)
+    {
+        record.ready_cycles = total_cycles;
+    }
+    seal();
+}
+
+/*******************************************************************************
+ * Function Name: boot_profile_since
+ ********************************************************************************
+ * Summary:
+ *  Records the start of a peripheral brought up on first use, once. Before the
+ *  end of the boot, the span is taken out of the phase running at the time and
+ *  counted in the time to the first scan.
+ *
+ * Parameters:
+ *  phase: peripheral phase
+ *  start: stage_profile_now() timestamp of its start
+ *
+ *******************************************************************************/
+void boot_profile_since(boot_profile_phase_t phase, uint32_t start)
+{
+    uint32_t cycles = stage_profile_elapsed(start);
+
+    if (0U != (record.done & (1UL << phase)))
+    {
+        return;
+    }
+
+    if (0U == (record.done & (1UL << BOOT_PROFILE_FIRST_SCAN)))
+    {
+        /* SysTick counts down: the running phase now starts later */
+        phase_start = (phase_start - cycles) & CY_SYSTICK_RELOAD_MAX;
+        total_cycles += cycles;
+    }
+    record.cycles[phase] = cycles;
+    record.done |= (1UL << phase);
+    seal();
+}
+
+/*******************************************************************************
+ * Function Name: boot_profile_get
+ ********************************************************************************
+ * Summary:
+ *  Returns the record of this boot.
+ *
+ *******************************************************************************/
+const boot_profile_record_t *boot_profile_get(void)
+{
+    return &record;
+}
+
+/*******************************************************************************
+ * Function Name: boot_profile_get_previous
+ ********************************************************************************
+ * Summary:
+ *  Returns the record of the previous boot, NULL if it did not survive the
+ *  reset.
+ *
+ *******************************************************************************/
+const boot_profile_record_t *boot_profile_get_previous(void)
+{
+    return previous_valid ? &previous : NULL;
+}
+
+/* [] END OF FILE */
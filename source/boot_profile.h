@@ -0,0 +1,110 @@
+/******************************************************************************
+ * File Name: boot_profile.h
+ *
+ * Description: Boot phase timing. main() marks the end of each bring-up phase
+ * up to the first proximity scan, and the peripherals brought up on first use
+ * record their own start; the Active CPU cycles of each phase are kept in a
+ * small record that survives a warm reset, so that the next boot can still read
+ * it.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* 1 - bring up the debug UART, the LED PWM and the EZI2C slave on first use,
+ * after the first proximity scan has started; 0 - bring them up in main()
+ * before it, to compare the boot phases */
+#ifndef BOOT_PROFILE_LAZY_START
+#define BOOT_PROFILE_LAZY_START         (1)
+#endif
+
+/* Layout version of boot_profile_record_t */
+#define BOOT_PROFILE_VERSION            (1U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef enum
+{
+    /* Marked in order by main(); each phase starts where the previous one
+     * ended */
+    BOOT_PROFILE_BSP,               /* main() entry to the end of cybsp_init(), at the reset clock first */
+    BOOT_PROFILE_LOW_POWER,         /* Deep Sleep callback registration */
+    BOOT_PROFILE_TELEMETRY,         /* Telemetry region and stage profiler */
+    BOOT_PROFILE_CAPSENSE,          /* Middleware start: calibration or restore */
+    BOOT_PROFILE_MODULES,           /* Power policy, liquid detection and the other firmware modules */
+    BOOT_PROFILE_WDT,               /* WDT and ILO measurement */
+    BOOT_PROFILE_FIRST_SCAN,        /* Main loop entry to the first proximity scan start */
+    /* Brought up on first use; not counted in the phase running at the time */
+    BOOT_PROFILE_UART,              /* Debug UART, gesture log and banner */
+    BOOT_PROFILE_EZI2C,             /* Tuner and telemetry EZI2C slave */
+    BOOT_PROFILE_PWM,               /* LED PWM */
+    BOOT_PROFILE_COUNT
+} boot_profile_phase_t;
+
+/* Active CPU cycles; SysTick stops in Deep Sleep, so the time spent there
+ * before the first scan is not counted */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t boots;                 /* Boots since the record was last lost, saturating */
+    uint32_t cpu_hz;                /* Cycle rate once the clocks are configured */
+    uint32_t done;                  /* Phases recorded, one bit per boot_profile_phase_t */
+    uint32_t ready_cycles;          /* main() entry to the first proximity scan start */
+    uint32_t cycles[BOOT_PROFILE_COUNT];
+    uint32_t check;                 /* Complement of the XOR of all words above */
+} boot_profile_record_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void boot_profile_init(void);
+void boot_profile_mark(boot_profile_phase_t phase);
+void boot_profile_since(boot_profile_phase_t phase, uint32_t start);
+const boot_profile_record_t *boot_profile_get(void);
+const boot_profile_record_t *boot_profile_get_previous(void);
+
+#endif /* BOOT_PROFILE_H */
+
+/* [] END OF FILE */
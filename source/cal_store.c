@@ -0,0 +1,433 @@
+/******************************************************************************
+ * File Name: cal_store.c
+ *
+ * Description: CAPSENSE calibration record in flash. On a valid record, the
+ * middleware is started without the CDAC auto-calibration, the recorded CDAC
+ * codes are written back, and one scan of all slots checks them against the
+ * baselines recorded with them. Otherwise the middleware calibrates as before
+ * and the record is written again from the main loop.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <string.h>
+#include "cal_store.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* "CCAL" */
+#define CAL_STORE_MAGIC                 (0x4C414343UL)
+
+/* CRC-32 (IEEE 802.3), reflected */
+#define CAL_STORE_CRC_POLY              (0xEDB88320UL)
+#define CAL_STORE_CRC_INIT              (0xFFFFFFFFUL)
+
+#define CAL_STORE_AREA_SIZE             (CAL_STORE_ROWS * CY_FLASH_SIZEOF_ROW)
+
+_Static_assert(sizeof(cal_store_record_t) <= UINT16_MAX, "Record size must fit its size field");
+_Static_assert(0U == (CY_FLASH_SIZEOF_ROW % sizeof(uint32_t)), "Rows are written as words");
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Flash rows of the record, in the section reserved for emulated EEPROM.
+ * Volatile: the flash writes change it behind the compiler, which would
+ * otherwise read the zero initializer. */
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+const volatile uint8_t cal_store_area[CAL_STORE_AREA_SIZE] = { 0U };
+
+/* The record read from flash or being written, padded to whole rows */
+static uint32_t image[CAL_STORE_AREA_SIZE / sizeof(uint32_t)];
+
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/* The middleware has calibrated; the record is written by cal_store_commit() */
+static bool commit_pending = false;
+
+static cal_store_stats_t stats;
+
+/*******************************************************************************
+ * Function Name: crc32_update
+ ********************************************************************************
+ * Summary:
+ *  Adds bytes to a CRC-32. Bitwise: the record is checked once per boot.
+ *
+ *******************************************************************************/
+static uint32_t crc32_update(uint32_t crc, const void *data, uint32_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        crc ^= bytes[i];
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (0U != (crc & 1U)) ? ((crc >> 1U) ^ CAL_STORE_CRC_POLY) : (crc >> 1U);
+        }
+    }
+    return crc;
+}
+
+/*******************************************************************************
+ * Function Name: crc32_value
+ ********************************************************************************
+ * Summary:
+ *  Adds a value to a CRC-32 as four little-endian bytes, so that the key does
+ *  not depend on the layout of the middleware structures.
+ *
+ *******************************************************************************/
+static uint32_t crc32_value(uint32_t crc, uint32_t value)
+{
+    uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8U), (uint8_t)(value >> 16U), (uint8_t)(value >> 24U) };
+
+    return crc32_update(crc, bytes, sizeof(bytes));
+}
+
+/*******************************************************************************
+ * Function Name: area_equal
+ ********************************************************************************
+ * Summary:
+ *  Compares flash contents with a RAM buffer.
+ *
+ *******************************************************************************/
+static bool area_equal(const volatile uint8_t *area, const void *data, uint32_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        if (area[i] != bytes[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: config_key
+ ********************************************************************************
+ * Summary:
+ *  Returns the CRC-32 of the settings the calibration depends on: the
+ *  middleware version, the widget layout, and the configured sense clocks,
+ *  conversions and CDAC codes. Call before the middleware is enabled, while
+ *  the contexts still hold the configured values.
+ *
+ *******************************************************************************/
+static uint32_t config_key(const cy_stc_capsense_context_t *context)
+{
+    uint32_t crc = crc32_value(CAL_STORE_CRC_INIT, CY_CAPSENSE_MW_VERSION);
+
+    for (uint32_t wd_id = 0U; wd_id < CY_CAPSENSE_WIDGET_COUNT; wd_id++)
+    {
+        const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[wd_id];
+        const cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+
+        crc = crc32_value(crc, ((uint32_t)wd->numSns << 16U) | ((uint32_t)wd->senseMethod << 8U) | wd->wdType);
+        crc = crc32_value(crc, ((uint32_t)wd->firstSlotId << 16U) | wd->numSlots);
+        crc = crc32_value(crc, ((uint32_t)wdc->snsClk << 16U) | wdc->rowSnsClk);
+        crc = crc32_value(crc, ((uint32_t)wdc->numSubConversions << 16U) | ((uint32_t)wdc->snsClkSource << 8U) |
+                               wdc->cicRate);
+        crc = crc32_value(crc, ((uint32_t)wdc->cdacRef << 16U) | ((uint32_t)wdc->rowCdacRef << 8U) |
+                               wdc->cdacCompDivider);
+        for (uint32_t i = 0U; i < wd->numSns; i++)
+        {
+            crc = crc32_value(crc, wd->ptrSnsContext[i].cdacComp);
+        }
+    }
+    return ~crc;
+}
+
+/*******************************************************************************
+ * Function Name: scan_all
+ ********************************************************************************
+ * Summary:
+ *  Scans all slots and waits in CPU Sleep for the end of the scan. The scan
+ *  pipeline ignores the completion: no frame of it is in flight.
+ *
+ *******************************************************************************/
+static cy_capsense_status_t scan_all(cy_stc_capsense_context_t *context)
+{
+    cy_capsense_status_t status = Cy_CapSense_ScanAllSlots(context);
+
+    while ((CY_CAPSENSE_STATUS_SUCCESS == status) && (CY_CAPSENSE_NOT_BUSY != Cy_CapSense_IsBusy(context)))
+    {
+        (void)Cy_SysPm_CpuEnterSleep();
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: restore
+ ********************************************************************************
+ * Summary:
+ *  Starts the middleware from the record in flash: checks the record, starts
+ *  the middleware without calibrating, writes the recorded CDAC codes and
+ *  validates them with one scan.
+ *
+ * Return:
+ *  CAL_STORE_REJECT_NONE if the calibration was restored and the baselines
+ *  initialized, else why the record was not used
+ *
+ *******************************************************************************/
+static uint32_t restore(cy_stc_capsense_context_t *context)
+{
+    const cal_store_record_t *rec = (const cal_store_record_t *)image;
+    uint8_t *copy = (uint8_t *)image;
+    uint32_t sns_id = 0U;
+
+    for (uint32_t i = 0U; i < sizeof(cal_store_record_t); i++)
+    {
+        copy[i] = cal_store_area[i];
+    }
+    if (CAL_STORE_MAGIC != rec->magic)
+    {
+        return CAL_STORE_REJECT_EMPTY;
+    }
+    if ((CAL_STORE_VERSION != rec->version) || (sizeof(cal_store_record_t) != rec->size))
+    {
+        return CAL_STORE_REJECT_VERSION;
+    }
+    if (rec->crc != ~crc32_update(CAL_STORE_CRC_INIT, rec, offsetof(cal_store_record_t, crc)))
+    {
+        return CAL_STORE_REJECT_CRC;
+    }
+    if (rec->config_key != stats.config_key)
+    {
+        return CAL_STORE_REJECT_CONFIG;
+    }
+
+    /* Cy_CapSense_Enable() without the auto-calibration */
+    if (CY_CAPSENSE_STATUS_SUCCESS != Cy_CapSense_Initialize(context))
+    {
+        return CAL_STORE_REJECT_VALIDATION;
+    }
+    for (uint32_t wd_id = 0U; wd_id < CY_CAPSENSE_WIDGET_COUNT; wd_id++)
+    {
+        const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[wd_id];
+        cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+
+        wdc->maxRawCount = rec->widget[wd_id].maxRawCount;
+        wdc->maxRawCountRow = rec->widget[wd_id].maxRawCountRow;
+        wdc->cdacRef = rec->widget[wd_id].cdacRef;
+        wdc->rowCdacRef = rec->widget[wd_id].rowCdacRef;
+        wdc->cdacCompDivider = rec->widget[wd_id].cdacCompDivider;
+        for (uint32_t i = 0U; i < wd->numSns; i++)
+        {
+            wd->ptrSnsContext[i].cdacComp = rec->cdac_comp[sns_id + i];
+        }
+        sns_id += wd->numSns;
+    }
+
+    /* Cy_CapSense_Initialize() generated the sensor frames loaded by the
+     * CS_DMA chain from the configured codes. Generate them again from the
+     * recorded ones, as the middleware does at the end of a calibration */
+    for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+    {
+        Cy_CapSense_GenerateAllSensorConfig(ch, &context->ptrSensorFrameContext[ch * CY_CAPSENSE_SLOT_COUNT * CY_MSC_6_SNS_REGS],
+                                            context);
+    }
+
+    /* The codes are good if the raw counts land where the baselines were
+     * when the record was written */
+    if (CY_CAPSENSE_STATUS_SUCCESS != scan_all(context))
+    {
+        return CAL_STORE_REJECT_VALIDATION;
+    }
+    sns_id = 0U;
+    for (uint32_t wd_id = 0U; wd_id < CY_CAPSENSE_WIDGET_COUNT; wd_id++)
+    {
+        const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[wd_id];
+
+        for (uint32_t i = 0U; i < wd->numSns; i++)
+        {
+            uint32_t raw = wd->ptrSnsContext[i].raw;
+            uint32_t ref = rec->bsln[sns_id];
+            uint32_t error = (raw > ref) ? (raw - ref) : (ref - raw);
+
+            if (error > (ref >> CAL_STORE_TOLERANCE_SHIFT))
+            {
+                stats.failed_sensors++;
+            }
+            sns_id++;
+        }
+    }
+    if (0U != stats.failed_sensors)
+    {
+        return CAL_STORE_REJECT_VALIDATION;
+    }
+
+    Cy_CapSense_InitializeAllBaselines(context);
+    return CAL_STORE_REJECT_NONE;
+}
+
+/*******************************************************************************
+ * Function Name: save
+ ********************************************************************************
+ * Summary:
+ *  Records the calibration left by Cy_CapSense_Enable() and the baselines
+ *  tracked with it. Rows already holding the record are not written again.
+ *
+ *******************************************************************************/
+static void save(const cy_stc_capsense_context_t *context)
+{
+    cal_store_record_t *rec = (cal_store_record_t *)image;
+    uint32_t sns_id = 0U;
+
+    memset(image, 0, sizeof(image));
+    rec->magic = CAL_STORE_MAGIC;
+    rec->version = CAL_STORE_VERSION;
+    rec->size = (uint16_t)sizeof(cal_store_record_t);
+    rec->config_key = stats.config_key;
+    for (uint32_t wd_id = 0U; wd_id < CY_CAPSENSE_WIDGET_COUNT; wd_id++)
+    {
+        const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[wd_id];
+        const cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+
+        rec->widget[wd_id].maxRawCount = wdc->maxRawCount;
+        rec->widget[wd_id].maxRawCountRow = wdc->maxRawCountRow;
+        rec->widget[wd_id].cdacRef = wdc->cdacRef;
+        rec->widget[wd_id].rowCdacRef = wdc->rowCdacRef;
+        rec->widget[wd_id].cdacCompDivider = wdc->cdacCompDivider;
+        for (uint32_t i = 0U; i < wd->numSns; i++)
+        {
+            rec->bsln[sns_id] = wd->ptrSnsContext[i].bsln;
+            rec->cdac_comp[sns_id] = wd->ptrSnsContext[i].cdacComp;
+            sns_id++;
+        }
+    }
+    rec->crc = ~crc32_update(CAL_STORE_CRC_INIT, rec, offsetof(cal_store_record_t, crc));
+
+    for (uint32_t row = 0U; row < CAL_STORE_ROWS; row++)
+    {
+        const uint32_t *data = &image[(row * CY_FLASH_SIZEOF_ROW) / sizeof(uint32_t)];
+        const volatile uint8_t *dst = &cal_store_area[row * CY_FLASH_SIZEOF_ROW];
+
+        if (!area_equal(dst, data, CY_FLASH_SIZEOF_ROW))
+        {
+            stats.write_status = Cy_Flash_WriteRow((uint32_t)(uintptr_t)dst, data);
+            stats.rows_written++;
+            if (CY_FLASH_DRV_SUCCESS != stats.write_status)
+            {
+                break;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: cal_store_start
+ ********************************************************************************
+ * Summary:
+ *  Enables the middleware in place of Cy_CapSense_Enable(). A valid record of
+ *  the same configuration is restored; if there is none, or the validation
+ *  scan rejects it, the middleware calibrates and cal_store_commit() writes
+ *  the record again later. Call after Cy_CapSense_Init(), with the MSC
+ *  interrupts enabled. The time taken is recorded in the stage profile.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ * Return:
+ *  Status of Cy_CapSense_Enable(), success if the record was restored
+ *
+ *******************************************************************************/
+cy_capsense_status_t cal_store_start(cy_stc_capsense_context_t *context)
+{
+    cy_capsense_status_t status = CY_CAPSENSE_STATUS_SUCCESS;
+    uint32_t start = stage_profile_now();
+
+    capsense_ctx = context;
+    commit_pending = false;
+    stats = (cal_store_stats_t){ .write_status = CY_FLASH_DRV_SUCCESS };
+    stats.config_key = config_key(context);
+#if CAL_STORE_ENABLED
+    stats.reject = restore(context);
+#else
+    stats.reject = CAL_STORE_REJECT_DISABLED;
+#endif /* CAL_STORE_ENABLED */
+    stats.restored = (CAL_STORE_REJECT_NONE == stats.reject);
+
+    if (!stats.restored)
+    {
+        status = Cy_CapSense_Enable(context);
+#if CAL_STORE_ENABLED
+        commit_pending = (CY_CAPSENSE_STATUS_SUCCESS == status);
+#endif /* CAL_STORE_ENABLED */
+    }
+
+    stats.start_cycles = stage_profile_elapsed(start);
+    stage_profile_record(STAGE_PROFILE_CAPSENSE_START, stats.start_cycles);
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: cal_store_commit
+ ********************************************************************************
+ * Summary:
+ *  Writes the record after a calibration at boot, once no scan is running.
+ *  Flash writes stall the CPU for each row, so this is kept off the boot
+ *  path; call from the main loop.
+ *
+ * Return:
+ *  true if the record was written on this call
+ *
+ *******************************************************************************/
+bool cal_store_commit(void)
+{
+    if (!commit_pending || (CY_CAPSENSE_NOT_BUSY != Cy_CapSense_IsBusy(capsense_ctx)))
+    {
+        return false;
+    }
+    commit_pending = false;
+    save(capsense_ctx);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: cal_store_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns how the middleware was started on this boot.
+ *
+ *******************************************************************************/
+const cal_store_stats_t *cal_store_get_stats(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * File Name: cal_store.h
+ *
+ * Description: CAPSENSE calibration record in flash. The CDAC codes found by
+ * the auto-calibration are kept in a versioned, CRC-protected record keyed on
+ * the CAPSENSE configuration, so that later boots restore them after one
+ * validation scan instead of calibrating again.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CAL_STORE_H
+#define CAL_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* 1 - restore the calibration from flash when the record is valid, 0 -
+ * calibrate on every boot */
+#ifndef CAL_STORE_ENABLED
+#define CAL_STORE_ENABLED               (1)
+#endif
+
+/* Layout version of cal_store_record_t */
+#define CAL_STORE_VERSION               (1U)
+
+/* A restored sensor passes the validation scan when its raw count is within
+ * 1/2^N of the baseline recorded with the calibration */
+#define CAL_STORE_TOLERANCE_SHIFT       (3U)
+
+/* Why the record was not used */
+#define CAL_STORE_REJECT_NONE           (0U)    /* Restored */
+#define CAL_STORE_REJECT_EMPTY          (1U)    /* No record: erased flash or other data */
+#define CAL_STORE_REJECT_VERSION        (2U)    /* Record of another layout version */
+#define CAL_STORE_REJECT_CRC            (3U)    /* Corrupted record */
+#define CAL_STORE_REJECT_CONFIG         (4U)    /* Record of another CAPSENSE configuration */
+#define CAL_STORE_REJECT_VALIDATION     (5U)    /* Validation scan out of tolerance */
+#define CAL_STORE_REJECT_DISABLED       (6U)    /* CAL_STORE_ENABLED is 0 */
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t maxRawCount;
+    uint16_t maxRawCountRow;
+    uint8_t cdacRef;
+    uint8_t rowCdacRef;
+    uint8_t cdacCompDivider;
+    uint8_t reserved;
+} cal_store_widget_t;
+
+/* Written to flash as is, padding included: the record is zeroed before it
+ * is filled */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;                          /* sizeof(cal_store_record_t) */
+    uint32_t config_key;                    /* CRC-32 of the CAPSENSE configuration */
+    cal_store_widget_t widget[CY_CAPSENSE_WIDGET_COUNT];
+    uint16_t bsln[CY_CAPSENSE_SENSOR_COUNT];    /* Baselines when the record was written */
+    uint8_t cdac_comp[CY_CAPSENSE_SENSOR_COUNT];
+    uint32_t crc;                           /* CRC-32 of all fields above */
+} cal_store_record_t;
+
+typedef struct
+{
+    bool restored;                          /* Calibration restored from flash */
+    uint32_t reject;                        /* CAL_STORE_REJECT_* */
+    uint32_t failed_sensors;                /* Sensors out of tolerance on validation */
+    uint32_t config_key;
+    uint32_t start_cycles;                  /* CPU cycles from the start of the
+                                             * middleware to the first scan */
+    uint32_t rows_written;                  /* Flash rows written on this boot */
+    cy_en_flashdrv_status_t write_status;   /* Last row write */
+} cal_store_stats_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Flash rows holding the record */
+#define CAL_STORE_ROWS                  ((sizeof(cal_store_record_t) + CY_FLASH_SIZEOF_ROW - 1U) / CY_FLASH_SIZEOF_ROW)
+
+extern const volatile uint8_t cal_store_area[CAL_STORE_ROWS * CY_FLASH_SIZEOF_ROW];
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+cy_capsense_status_t cal_store_start(cy_stc_capsense_context_t *context);
+bool cal_store_commit(void);
+const cal_store_stats_t *cal_store_get_stats(void);
+
+#endif /* CAL_STORE_H */
+
+/* [] END OF FILE */
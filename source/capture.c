@@ -0,0 +1,100 @@
+/******************************************************************************
+ * File Name: capture.c
+ *
+ * Description: Builds capture records (see capture.h) from the current CAPSENSE
+ * sensor data.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <string.h>
+#include "capture.h"
+
+/*******************************************************************************
+ * Function Name: capture_init_header
+ ********************************************************************************
+ * Summary:
+ *  Fills the header written at the start of every capture.
+ *
+ * Parameters:
+ *  header: header to fill
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void capture_init_header(capture_header_t *header, const cy_stc_capsense_context_t *context)
+{
+    memset(header, 0, sizeof(*header));
+    header->magic = CAPTURE_MAGIC;
+    header->version = CAPTURE_VERSION;
+    header->header_size = (uint16_t)sizeof(capture_header_t);
+    header->frame_size = (uint16_t)sizeof(capture_frame_t);
+    header->num_cols = (uint8_t)CAPTURE_TOUCHPAD_NUM_COLS;
+    header->num_rows = (uint8_t)CAPTURE_TOUCHPAD_NUM_ROWS;
+    header->timestamp_interval = context->ptrCommonContext->timestampInterval;
+}
+
+/*******************************************************************************
+ * Function Name: capture_fill_frame
+ ********************************************************************************
+ * Summary:
+ *  Copies the raw counts of the proximity and touchpad sensors and the gesture
+ *  timestamp into a capture frame. Call after the scan of the widgets named
+ *  by flags has completed.
+ *
+ * Parameters:
+ *  frame: frame to fill
+ *  time_ms: device time of the scan
+ *  flags: CAPTURE_FLAG_xxx, widgets scanned for this frame
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void capture_fill_frame(capture_frame_t *frame, uint32_t time_ms, uint16_t flags,
+                        const cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_sensor_context_t *tp_sns =
+        context->ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrSnsContext;
+
+    frame->time_ms = time_ms;
+    frame->timestamp = context->ptrCommonContext->timestamp;
+    frame->flags = flags;
+    frame->prox_raw = context->ptrWdConfig[CY_CAPSENSE_PROXIMITY0_WDGT_ID].ptrSnsContext[0].raw;
+
+    for (uint32_t i = 0U; i < CAPTURE_TOUCHPAD_NUM_SNS; i++)
+    {
+        frame->touchpad_raw[i] = tp_sns[i].raw;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * File Name: capture.h
+ *
+ * Description: Binary capture format for per-frame raw counts of the PROXIMITY0
+ * and TOUCHPAD0 widgets. A capture is one capture_header_t followed by any
+ * number of fixed-size capture_frame_t records, so it can be written as a
+ * stream and read back frame by frame. All fields are little-endian, which is
+ * the native byte order of both the device and the host tools.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define CAPTURE_MAGIC                   (0x50435054UL)  /* "TPCP" */
+#define CAPTURE_VERSION                 (1U)
+
+/* Touchpad0: 16 column sensors followed by 10 row sensors */
+#define CAPTURE_TOUCHPAD_NUM_COLS       (16U)
+#define CAPTURE_TOUCHPAD_NUM_ROWS       (10U)
+#define CAPTURE_TOUCHPAD_NUM_SNS        (CAPTURE_TOUCHPAD_NUM_COLS + CAPTURE_TOUCHPAD_NUM_ROWS)
+
+/* capture_frame_t.flags: widgets scanned for this frame */
+#define CAPTURE_FLAG_PROXIMITY          (0x0001U)
+#define CAPTURE_FLAG_TOUCHPAD           (0x0002U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t magic;             /* CAPTURE_MAGIC */
+    uint16_t version;           /* CAPTURE_VERSION */
+    uint16_t header_size;       /* sizeof(capture_header_t) */
+    uint16_t frame_size;        /* sizeof(capture_frame_t) */
+    uint8_t num_cols;           /* CAPTURE_TOUCHPAD_NUM_COLS */
+    uint8_t num_rows;           /* CAPTURE_TOUCHPAD_NUM_ROWS */
+    uint32_t timestamp_interval;/* Gesture timestamp increment per frame */
+} capture_header_t;
+
+typedef struct
+{
+    uint32_t time_ms;           /* Device time of the scan */
+    uint32_t timestamp;         /* Gesture timestamp after the scan */
+    uint16_t flags;             /* CAPTURE_FLAG_xxx */
+    uint16_t prox_raw;
+    uint16_t touchpad_raw[CAPTURE_TOUCHPAD_NUM_SNS];
+} capture_frame_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void capture_init_header(capture_header_t *header, const cy_stc_capsense_context_t *context);
+void capture_fill_frame(capture_frame_t *frame, uint32_t time_ms, uint16_t flags,
+                        const cy_stc_capsense_context_t *context);
+
+_Static_assert(sizeof(capture_header_t) == 16U, "capture_header_t layout changed");
+_Static_assert(sizeof(capture_frame_t) == 64U, "capture_frame_t layout changed");
+
+#endif /* CAPTURE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * File Name: gesture_clock.c
+ *
+ * Description: Gesture timestamp clock. The WDT counter runs from the ILO in
+ * every power mode; the ticks seen between two wake-ups are scaled by the last
+ * ILO measurement into gesture timestamp ticks, carrying the remainder so that
+ * no time is lost between frames.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "ilo_comp.h"
+#include "gesture_clock.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Gesture ticks per ILO reference interval */
+#define GESTURE_CLOCK_TICKS_PER_REF     (ILO_COMP_REFERENCE_US / GESTURE_CLOCK_TICK_US)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* WDT counter at the last update */
+static uint32_t last_count = 0U;
+
+/* ILO ticks not yet counted as gesture ticks, times GESTURE_CLOCK_TICKS_PER_REF;
+ * one gesture tick is the compensated reference count */
+static uint32_t pending = 0U;
+
+/*******************************************************************************
+ * Function Name: gesture_clock_init
+ ********************************************************************************
+ * Summary:
+ *  Starts the clock at the current WDT counter. The WDT must be running and
+ *  the ILO measured with ilo_comp_init().
+ *
+ * Parameters:
+ *  wdt_count: Cy_WDT_GetCount()
+ *
+ *******************************************************************************/
+void gesture_clock_init(uint32_t wdt_count)
+{
+    last_count = wdt_count & GESTURE_CLOCK_WDT_MASK;
+    pending = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: gesture_clock_update
+ ********************************************************************************
+ * Summary:
+ *  Counts the WDT ticks since the last update. Call on every wake-up, at
+ *  least once per wrap of the 16-bit WDT counter: 1.6 s at 40 kHz, longer
+ *  than the slowest power level.
+ *
+ * Parameters:
+ *  wdt_count: Cy_WDT_GetCount()
+ *
+ *******************************************************************************/
+void gesture_clock_update(uint32_t wdt_count)
+{
+    uint32_t delta = (wdt_count - last_count) & GESTURE_CLOCK_WDT_MASK;
+
+    last_count = wdt_count & GESTURE_CLOCK_WDT_MASK;
+    if (pending < GESTURE_CLOCK_MAX_PENDING)
+    {
+        pending += delta * GESTURE_CLOCK_TICKS_PER_REF;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: gesture_clock_take_ticks
+ ********************************************************************************
+ * Summary:
+ *  Returns the whole gesture timestamp ticks elapsed since the last call and
+ *  keeps the rest for the next one. Called once per touchpad frame, the
+ *  result is the timestamp interval of the frame: 0 for frames shorter than
+ *  a tick, and the whole gap after the touchpad was not scanned.
+ *
+ * Return:
+ *  Gesture timestamp ticks
+ *
+ *******************************************************************************/
+uint32_t gesture_clock_take_ticks(void)
+{
+    uint32_t counts = ilo_comp_get_reference_counts();
+    uint32_t ticks;
+
+    if (0U == counts)
+    {
+        return 0U;
+    }
+    ticks = pending / counts;
+    pending -= ticks * counts;
+    return ticks;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * File Name: gesture_clock.h
+ *
+ * Description: Gesture timestamp clock. Counts CAPSENSE gesture timestamp ticks
+ * from the WDT counter, converted with the compensated ILO rate, so that the
+ * gesture time thresholds hold at any frame period.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef GESTURE_CLOCK_H
+#define GESTURE_CLOCK_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Device time of one gesture timestamp tick; the gesture time thresholds of
+ * the touchpad are set in these ticks. Must divide ILO_COMP_REFERENCE_US. */
+#define GESTURE_CLOCK_TICK_US           (10000UL)
+
+/* WDT counter width */
+#define GESTURE_CLOCK_WDT_MASK          (0xFFFFUL)
+
+/* Longest time counted between two touchpad frames, in ILO ticks scaled by
+ * ILO_COMP_REFERENCE_US / GESTURE_CLOCK_TICK_US: over 10 minutes at 40 kHz.
+ * Longer gaps only matter as "long ago" to the gesture decoder. */
+#define GESTURE_CLOCK_MAX_PENDING       (0x10000000UL)
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void gesture_clock_init(uint32_t wdt_count);
+void gesture_clock_update(uint32_t wdt_count);
+uint32_t gesture_clock_take_ticks(void);
+
+#endif /* GESTURE_CLOCK_H */
+
+/* [] END OF FILE */
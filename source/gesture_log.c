@@ -0,0 +1,272 @@
+/******************************************************************************
+ * File Name: gesture_log.c
+ *
+ * Description: Non-blocking gesture event log on the debug UART. The main loop
+ * is the only producer and the SCB TX interrupt the only consumer of the record
+ * ring, so the ring needs no locking: each side writes only its own index.
+ * There is no free DMA channel, all eight are used by the MSC blocks in CS_DMA
+ * mode, so the ring is drained from the TX FIFO level interrupt.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "gesture_log.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define GESTURE_LOG_INDEX_MASK          (GESTURE_LOG_DEPTH - 1U)
+
+#if (0U != (GESTURE_LOG_DEPTH & GESTURE_LOG_INDEX_MASK))
+#error "GESTURE_LOG_DEPTH must be a power of two"
+#endif
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static CySCB_Type *uart_hw = NULL;
+
+static uint8_t ring[GESTURE_LOG_DEPTH][GESTURE_LOG_RECORD_SIZE];
+
+/* Written by the producer only */
+static volatile uint32_t head = 0U;
+
+/* Written by the TX interrupt only */
+static volatile uint32_t tail = 0U;
+static uint32_t tx_pos = 0U;
+
+/* Records discarded because the ring was full */
+static uint32_t dropped = 0U;
+
+/* Text sent ahead of the records, NULL once sent */
+static const char_t *volatile text = NULL;
+
+/*******************************************************************************
+ * Function Name: gesture_log_init
+ ********************************************************************************
+ * Summary:
+ *  Sets up the TX FIFO level used to refill the UART from the ring. The
+ *  caller routes the SCB interrupt to gesture_log_isr().
+ *
+ * Parameters:
+ *  uart_base: SCB block of the debug UART
+ *
+ *******************************************************************************/
+void gesture_log_init(CySCB_Type *uart_base)
+{
+    uart_hw = uart_base;
+    head = 0U;
+    tail = 0U;
+    tx_pos = 0U;
+    dropped = 0U;
+    text = NULL;
+
+    Cy_SCB_SetTxInterruptMask(uart_hw, 0U);
+    Cy_SCB_SetTxFifoLevel(uart_hw, GESTURE_LOG_TX_FIFO_LEVEL);
+}
+
+/*******************************************************************************
+ * Function Name: gesture_log_encode
+ ********************************************************************************
+ * Summary:
+ *  Serializes one gesture event into the record layout described in
+ *  gesture_log.h.
+ *
+ *******************************************************************************/
+void gesture_log_encode(uint8_t record[GESTURE_LOG_RECORD_SIZE], uint32_t gesture, uint32_t timestamp,
+                        uint16_t x, uint16_t y)
+{
+    uint8_t check = 0U;
+
+    record[0] = GESTURE_LOG_SYNC;
+    record[1] = (uint8_t)gesture;
+    record[2] = (uint8_t)(gesture >> 8U);
+    record[3] = (uint8_t)(gesture >> 16U);
+    record[4] = (uint8_t)(gesture >> 24U);
+    record[5] = (uint8_t)timestamp;
+    record[6] = (uint8_t)(timestamp >> 8U);
+    record[7] = (uint8_t)x;
+    record[8] = (uint8_t)(x >> 8U);
+    record[9] = (uint8_t)y;
+    record[10] = (uint8_t)(y >> 8U);
+
+    for (uint32_t i = 0U; i < (GESTURE_LOG_RECORD_SIZE - 1U); i++)
+    {
+        check ^= record[i];
+    }
+    record[GESTURE_LOG_RECORD_SIZE - 1U] = check;
+}
+
+/*******************************************************************************
+ * Function Name: gesture_log_post
+ ********************************************************************************
+ * Summary:
+ *  Queues a gesture event for transmission. Never blocks: when the ring is
+ *  full the event is dropped and counted.
+ *
+ * Parameters:
+ *  gesture: gesture code
+ *  timestamp: gesture timestamp
+ *  x, y: touch position, GESTURE_LOG_NO_POSITION if unknown
+ *
+ * Return:
+ *  true if the event was queued
+ *
+ *******************************************************************************/
+bool gesture_log_post(uint32_t gesture, uint32_t timestamp, uint16_t x, uint16_t y)
+{
+    uint32_t h = head;
+
+    if ((h - tail) >= GESTURE_LOG_DEPTH)
+    {
+        dropped++;
+        return false;
+    }
+
+    gesture_log_encode(ring[h & GESTURE_LOG_INDEX_MASK], gesture, timestamp, x, y);
+
+    /* Publish the record, then let the TX interrupt pick it up */
+    head = h + 1U;
+    Cy_SCB_SetTxInterruptMask(uart_hw, CY_SCB_TX_INTR_LEVEL);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: gesture_log_print
+ ********************************************************************************
+ * Summary:
+ *  Queues a text line, such as the banner, ahead of the records. Never
+ *  blocks; one line can be pending at a time. The string must stay valid
+ *  until it is sent.
+ *
+ * Parameters:
+ *  string: null-terminated text
+ *
+ * Return:
+ *  true if the text was queued
+ *
+ *******************************************************************************/
+bool gesture_log_print(const char_t *string)
+{
+    if (NULL != text)
+    {
+        return false;
+    }
+    text = string;
+    Cy_SCB_SetTxInterruptMask(uart_hw, CY_SCB_TX_INTR_LEVEL);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: gesture_log_isr
+ ********************************************************************************
+ * Summary:
+ *  SCB TX interrupt handler. Refills the TX FIFO from the pending text, then
+ *  from the ring, and masks the interrupt once both are empty.
+ *
+ *******************************************************************************/
+void gesture_log_isr(void)
+{
+    uint32_t t = tail;
+    const char_t *c = text;
+
+    if (0U == (Cy_SCB_GetTxInterruptStatusMasked(uart_hw) & CY_SCB_TX_INTR_LEVEL))
+    {
+        return;
+    }
+
+    while ((NULL != c) && ('\0' != *c))
+    {
+        if (0U == Cy_SCB_UART_Put(uart_hw, (uint32_t)(uint8_t)*c))
+        {
+            break;
+        }
+        c++;
+    }
+    if ((NULL != c) && ('\0' == *c))
+    {
+        c = NULL;
+    }
+    text = c;
+
+    while ((NULL == c) && (t != head))
+    {
+        if (0U == Cy_SCB_UART_Put(uart_hw, ring[t & GESTURE_LOG_INDEX_MASK][tx_pos]))
+        {
+            /* FIFO full, continue at the next level interrupt */
+            break;
+        }
+        tx_pos++;
+        if (GESTURE_LOG_RECORD_SIZE == tx_pos)
+        {
+            tx_pos = 0U;
+            t++;
+        }
+    }
+    tail = t;
+
+    if ((NULL == c) && (t == head))
+    {
+        Cy_SCB_SetTxInterruptMask(uart_hw, 0U);
+    }
+    Cy_SCB_ClearTxInterrupt(uart_hw, CY_SCB_TX_INTR_LEVEL);
+}
+
+/*******************************************************************************
+ * Function Name: gesture_log_is_busy
+ ********************************************************************************
+ * Summary:
+ *  Returns true while text or records are queued or still being shifted out. The
+ *  UART is disabled in Deep Sleep, so Deep Sleep entry must wait for this.
+ *
+ *******************************************************************************/
+bool gesture_log_is_busy(void)
+{
+    return (head != tail) || (NULL != text) || !Cy_SCB_UART_IsTxComplete(uart_hw);
+}
+
+/*******************************************************************************
+ * Function Name: gesture_log_get_dropped
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of events dropped because the ring was full.
+ *
+ *******************************************************************************/
+uint32_t gesture_log_get_dropped(void)
+{
+    return dropped;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File Name: gesture_log.h
+ *
+ * Description: Non-blocking gesture event log on the debug UART. Gesture events
+ * are queued as compact binary records in a single-producer, single-consumer
+ * ring and shifted out by the SCB TX FIFO interrupt, so the scan loop never
+ * waits on the UART. The record layout is defined here and decoded back to text
+ * on the host.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef GESTURE_LOG_H
+#define GESTURE_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_pdl.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Record layout, all multi-byte fields little-endian:
+ *  [0]      GESTURE_LOG_SYNC
+ *  [1..4]   gesture code as returned by Cy_CapSense_DecodeWidgetGestures()
+ *  [5..6]   gesture timestamp, low 16 bits
+ *  [7..8]   X position, GESTURE_LOG_NO_POSITION if unknown
+ *  [9..10]  Y position, GESTURE_LOG_NO_POSITION if unknown
+ *  [11]     XOR of bytes 0..10 */
+#define GESTURE_LOG_SYNC                (0xA5U)
+#define GESTURE_LOG_RECORD_SIZE         (12U)
+#define GESTURE_LOG_NO_POSITION         (0xFFFFU)
+
+/* Number of queued records, must be a power of two */
+#define GESTURE_LOG_DEPTH               (16U)
+
+/* TX FIFO refill threshold: the interrupt fires below this many entries */
+#define GESTURE_LOG_TX_FIFO_LEVEL       (2U)
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void gesture_log_init(CySCB_Type *uart_base);
+bool gesture_log_post(uint32_t gesture, uint32_t timestamp, uint16_t x, uint16_t y);
+bool gesture_log_print(const char_t *string);
+bool gesture_log_is_busy(void);
+uint32_t gesture_log_get_dropped(void);
+void gesture_log_isr(void);
+void gesture_log_encode(uint8_t record[GESTURE_LOG_RECORD_SIZE], uint32_t gesture, uint32_t timestamp,
+                        uint16_t x, uint16_t y);
+
+#endif /* GESTURE_LOG_H */
+
+/* [] END OF FILE */
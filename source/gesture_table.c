@@ -0,0 +1,258 @@
+/******************************************************************************
+ * File Name: gesture_table.c
+ *
+ * Description: Table-driven dispatch of decoded touchpad gestures. The low bits
+ * of a gesture code select one of the CAPSENSE gesture groups and each group
+ * owns a direction field in the upper half-word; every valid (group, direction)
+ * pair gets one slot of a dense action table. The slot layout is derived from
+ * the middleware gesture masks at compile time.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "gesture_table.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Number of directions encoded by a direction field */
+#define GESTURE_DIRS(name) \
+    ((CY_CAPSENSE_GESTURE_DIRECTION_MASK_##name >> CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_##name) + 1U)
+
+#define GESTURE_GROUP_COUNT         (11U)
+
+/* De Bruijn sequence mapping an isolated bit to its index */
+#define GESTURE_DEBRUIJN            (0x077CB531UL)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* First action slot of each gesture group */
+enum
+{
+    SLOT_ONE_FNGR_SINGLE_CLICK  = 0,
+    SLOT_ONE_FNGR_DOUBLE_CLICK  = SLOT_ONE_FNGR_SINGLE_CLICK + 1,
+    SLOT_ONE_FNGR_CLICK_DRAG    = SLOT_ONE_FNGR_DOUBLE_CLICK + 1,
+    SLOT_TWO_FNGR_SINGLE_CLICK  = SLOT_ONE_FNGR_CLICK_DRAG + 1,
+    SLOT_ONE_FNGR_SCROLL        = SLOT_TWO_FNGR_SINGLE_CLICK + 1,
+    SLOT_TWO_FNGR_SCROLL        = SLOT_ONE_FNGR_SCROLL + GESTURE_DIRS(ONE_SCROLL),
+    SLOT_ONE_FNGR_EDGE_SWIPE    = SLOT_TWO_FNGR_SCROLL + GESTURE_DIRS(TWO_SCROLL),
+    SLOT_ONE_FNGR_FLICK         = SLOT_ONE_FNGR_EDGE_SWIPE + GESTURE_DIRS(ONE_EDGE),
+    SLOT_ONE_FNGR_ROTATE        = SLOT_ONE_FNGR_FLICK + GESTURE_DIRS(ONE_FLICK),
+    SLOT_TWO_FNGR_ZOOM          = SLOT_ONE_FNGR_ROTATE + GESTURE_DIRS(ONE_ROTATE),
+    SLOT_ONE_FNGR_LONG_PRESS    = SLOT_TWO_FNGR_ZOOM + GESTURE_DIRS(TWO_ZOOM),
+    GESTURE_TABLE_SLOTS         = SLOT_ONE_FNGR_LONG_PRESS + 1
+};
+
+typedef struct
+{
+    uint8_t first_slot;
+    uint8_t dir_offset;
+    uint8_t dir_mask;           /* Direction field mask after the shift */
+} gesture_group_t;
+
+/*******************************************************************************
+ * Compile-time checks of the middleware gesture layout
+ ******************************************************************************/
+/* The group bits are contiguous from bit 0, in the order used below */
+_Static_assert(CY_CAPSENSE_GESTURE_ALL_GESTURES_MASK == ((1UL << GESTURE_GROUP_COUNT) - 1UL),
+               "Unexpected gesture group mask");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_SINGLE_CLICK_MASK == (1UL << 0U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_DOUBLE_CLICK_MASK == (1UL << 1U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_CLICK_DRAG_MASK == (1UL << 2U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_TWO_FNGR_SINGLE_CLICK_MASK == (1UL << 3U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_SCROLL_MASK == (1UL << 4U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_TWO_FNGR_SCROLL_MASK == (1UL << 5U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_EDGE_SWIPE_MASK == (1UL << 6U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_FLICK_MASK == (1UL << 7U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_ROTATE_MASK == (1UL << 8U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_TWO_FNGR_ZOOM_MASK == (1UL << 9U), "Gesture group order");
+_Static_assert(CY_CAPSENSE_GESTURE_ONE_FNGR_LONG_PRESS_MASK == (1UL << 10U), "Gesture group order");
+
+/* Direction fields lie above the group bits and do not overlap */
+_Static_assert(CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_ONE_SCROLL >= CY_CAPSENSE_GESTURE_DIRECTION_OFFSET,
+               "Direction field overlaps the group bits");
+_Static_assert(0U == (CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_SCROLL & CY_CAPSENSE_GESTURE_DIRECTION_MASK_TWO_SCROLL),
+               "Direction fields overlap");
+_Static_assert(0U == (CY_CAPSENSE_GESTURE_DIRECTION_MASK_TWO_SCROLL & CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_EDGE),
+               "Direction fields overlap");
+_Static_assert(0U == (CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_EDGE & CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_ROTATE),
+               "Direction fields overlap");
+_Static_assert(0U == (CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_ROTATE & CY_CAPSENSE_GESTURE_DIRECTION_MASK_TWO_ZOOM),
+               "Direction fields overlap");
+_Static_assert(0U == (CY_CAPSENSE_GESTURE_DIRECTION_MASK_TWO_ZOOM & CY_CAPSENSE_GESTURE_DIRECTION_MASK_ONE_FLICK),
+               "Direction fields overlap");
+_Static_assert(GESTURE_TABLE_SLOTS <= 255, "Slot index does not fit in uint8_t");
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+#define GESTURE_GROUP(slot, name) \
+    { (uint8_t)(slot), (uint8_t)CY_CAPSENSE_GESTURE_DIRECTION_OFFSET_##name, (uint8_t)(GESTURE_DIRS(name) - 1U) }
+#define GESTURE_GROUP_NO_DIR(slot) \
+    { (uint8_t)(slot), 0U, 0U }
+
+/* Indexed by the bit number of the gesture group */
+static const gesture_group_t gesture_groups[GESTURE_GROUP_COUNT] =
+{
+    GESTURE_GROUP_NO_DIR(SLOT_ONE_FNGR_SINGLE_CLICK),
+    GESTURE_GROUP_NO_DIR(SLOT_ONE_FNGR_DOUBLE_CLICK),
+    GESTURE_GROUP_NO_DIR(SLOT_ONE_FNGR_CLICK_DRAG),
+    GESTURE_GROUP_NO_DIR(SLOT_TWO_FNGR_SINGLE_CLICK),
+    GESTURE_GROUP(SLOT_ONE_FNGR_SCROLL, ONE_SCROLL),
+    GESTURE_GROUP(SLOT_TWO_FNGR_SCROLL, TWO_SCROLL),
+    GESTURE_GROUP(SLOT_ONE_FNGR_EDGE_SWIPE, ONE_EDGE),
+    GESTURE_GROUP(SLOT_ONE_FNGR_FLICK, ONE_FLICK),
+    GESTURE_GROUP(SLOT_ONE_FNGR_ROTATE, ONE_ROTATE),
+    GESTURE_GROUP(SLOT_TWO_FNGR_ZOOM, TWO_ZOOM),
+    GESTURE_GROUP_NO_DIR(SLOT_ONE_FNGR_LONG_PRESS),
+};
+
+/* Bit number of an isolated bit, indexed by (bit * GESTURE_DEBRUIJN) >> 27 */
+static const uint8_t debruijn_bit[32] =
+{
+    0U, 1U, 28U, 2U, 29U, 14U, 24U, 3U, 30U, 22U, 20U, 15U, 25U, 17U, 4U, 8U,
+    31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U, 26U, 12U, 18U, 6U, 11U, 5U, 10U, 9U
+};
+
+static gesture_action_fn gesture_actions[GESTURE_TABLE_SLOTS];
+
+/*******************************************************************************
+ * Function Name: gesture_slot
+ ********************************************************************************
+ * Summary:
+ *  Maps a gesture code to its action slot. A code is valid when exactly one
+ *  group bit is set and no bits other than that group's direction field.
+ *
+ * Return:
+ *  Slot index, or GESTURE_TABLE_SLOTS if the code is not valid
+ *
+ *******************************************************************************/
+static uint32_t gesture_slot(uint32_t gesture)
+{
+    uint32_t group_bit = gesture & CY_CAPSENSE_GESTURE_ALL_GESTURES_MASK;
+    const gesture_group_t *group;
+    uint32_t dir;
+
+    if ((0U == group_bit) || (0U != (group_bit & (group_bit - 1U))))
+    {
+        return GESTURE_TABLE_SLOTS;
+    }
+
+    group = &gesture_groups[debruijn_bit[(uint32_t)(group_bit * GESTURE_DEBRUIJN) >> 27U]];
+    dir = (gesture >> group->dir_offset) & group->dir_mask;
+
+    if (gesture != (group_bit | (dir << group->dir_offset)))
+    {
+        return GESTURE_TABLE_SLOTS;
+    }
+    return group->first_slot + dir;
+}
+
+/*******************************************************************************
+ * Function Name: gesture_table_init
+ ********************************************************************************
+ * Summary:
+ *  Clears the action table and registers the given entries.
+ *
+ * Parameters:
+ *  entries: gesture to action map, may be NULL if num_entries is 0
+ *  num_entries: number of entries
+ *
+ * Return:
+ *  false if any entry holds an invalid gesture code
+ *
+ *******************************************************************************/
+bool gesture_table_init(const gesture_table_entry_t *entries, uint32_t num_entries)
+{
+    bool valid = true;
+
+    for (uint32_t i = 0U; i < GESTURE_TABLE_SLOTS; i++)
+    {
+        gesture_actions[i] = NULL;
+    }
+
+    for (uint32_t i = 0U; i < num_entries; i++)
+    {
+        valid = gesture_table_register(entries[i].gesture, entries[i].action) && valid;
+    }
+    return valid;
+}
+
+/*******************************************************************************
+ * Function Name: gesture_table_register
+ ********************************************************************************
+ * Summary:
+ *  Sets or replaces the action of one gesture. A NULL action removes it.
+ *
+ * Return:
+ *  false if the gesture code is not valid
+ *
+ *******************************************************************************/
+bool gesture_table_register(uint32_t gesture, gesture_action_fn action)
+{
+    uint32_t slot = gesture_slot(gesture);
+
+    if (GESTURE_TABLE_SLOTS == slot)
+    {
+        return false;
+    }
+    gesture_actions[slot] = action;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: gesture_table_dispatch
+ ********************************************************************************
+ * Summary:
+ *  Runs the action registered for a decoded gesture.
+ *
+ * Return:
+ *  true if an action was run
+ *
+ *******************************************************************************/
+bool gesture_table_dispatch(uint32_t gesture)
+{
+    uint32_t slot = gesture_slot(gesture);
+
+    if ((GESTURE_TABLE_SLOTS == slot) || (NULL == gesture_actions[slot]))
+    {
+        return false;
+    }
+    gesture_actions[slot](gesture);
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * File Name: gesture_table.h
+ *
+ * Description: Table-driven dispatch of decoded touchpad gestures. Gesture
+ * codes returned by Cy_CapSense_DecodeWidgetGestures() are split into their
+ * group bit and direction field and mapped to a dense action table, so the cost
+ * of a dispatch does not depend on the number of gestures handled.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef GESTURE_TABLE_H
+#define GESTURE_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Gesture code of a group without a direction field */
+#define GESTURE_CODE(group_mask)                    ((uint32_t)(group_mask))
+
+/* Gesture code of a group with a direction field */
+#define GESTURE_CODE_DIR(group_mask, dir_offset, dir) \
+    ((uint32_t)(group_mask) | ((uint32_t)(dir) << (dir_offset)))
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* Called with the full gesture code */
+typedef void (*gesture_action_fn)(uint32_t gesture);
+
+typedef struct
+{
+    uint32_t gesture;
+    gesture_action_fn action;
+} gesture_table_entry_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool gesture_table_init(const gesture_table_entry_t *entries, uint32_t num_entries);
+bool gesture_table_register(uint32_t gesture, gesture_action_fn action);
+bool gesture_table_dispatch(uint32_t gesture);
+
+#endif /* GESTURE_TABLE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * File Name: ilo_comp.c
+ *
+ * Description: Cached ILO compensation for the WDT wake-up interval.
+ * Cy_SysClk_IloCompensate() busy-waits in Active mode until the ILO has been
+ * counted against the IMO; this module pays that cost once per recalibration
+ * period instead of on every wake-up.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "cy_pdl.h"
+#include "ilo_comp.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t interval_us;
+    uint32_t counts;
+} ilo_comp_entry_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Compensated ILO counts of ILO_COMP_REFERENCE_US */
+static uint32_t reference_counts = 0U;
+
+/* Cached compensated counts per wake-up interval, 0 - free entry */
+static ilo_comp_entry_t cache[ILO_COMP_MAX_INTERVALS];
+
+/* Device time accounted since the last measurement */
+static uint32_t elapsed_us = 0U;
+static bool recal_pending = true;
+static uint32_t recal_count = 0U;
+
+/*******************************************************************************
+ * Function Name: scale_counts
+ ********************************************************************************
+ * Summary:
+ *  Converts the reference measurement to the counts of another interval,
+ *  rounded to the nearest count.
+ *
+ *******************************************************************************/
+static uint32_t scale_counts(uint32_t interval_us)
+{
+    return (uint32_t)((((uint64_t)reference_counts * interval_us) + (ILO_COMP_REFERENCE_US / 2U)) /
+                      ILO_COMP_REFERENCE_US);
+}
+
+/*******************************************************************************
+ * Function Name: measure
+ ********************************************************************************
+ * Summary:
+ *  Measures the ILO against the IMO and refreshes every cached entry.
+ *  Blocks in Active mode for the duration of the measurement.
+ *
+ *******************************************************************************/
+static void measure(void)
+{
+    uint32_t counts = 0U;
+
+    Cy_SysClk_IloStartMeasurement();
+    while (CY_SYSCLK_SUCCESS != Cy_SysClk_IloCompensate(ILO_COMP_REFERENCE_US, &counts))
+    {
+    }
+    Cy_SysClk_IloStopMeasurement();
+
+    reference_counts = counts;
+    for (uint32_t i = 0U; i < ILO_COMP_MAX_INTERVALS; i++)
+    {
+        if (0U != cache[i].interval_us)
+        {
+            cache[i].counts = scale_counts(cache[i].interval_us);
+        }
+    }
+
+    elapsed_us = 0U;
+    recal_pending = false;
+    recal_count++;
+}
+
+/*******************************************************************************
+ * Function Name: ilo_comp_init
+ ********************************************************************************
+ * Summary:
+ *  Performs the initial ILO measurement. The ILO must be enabled.
+ *
+ *******************************************************************************/
+void ilo_comp_init(void)
+{
+    for (uint32_t i = 0U; i < ILO_COMP_MAX_INTERVALS; i++)
+    {
+        cache[i].interval_us = 0U;
+        cache[i].counts = 0U;
+    }
+    measure();
+}
+
+/*******************************************************************************
+ * Function Name: ilo_comp_get_counts
+ ********************************************************************************
+ * Summary:
+ *  Returns the WDT counts of the requested interval and accounts the interval
+ *  as elapsed device time. Call once per programmed WDT period. A new ILO
+ *  measurement is taken only when the recalibration period has expired or a
+ *  recalibration was requested.
+ *
+ * Parameters:
+ *  interval_us: wake-up interval in microseconds
+ *
+ * Return:
+ *  Compensated ILO counts of interval_us
+ *
+ *******************************************************************************/
+uint32_t ilo_comp_get_counts(uint32_t interval_us)
+{
+    uint32_t free_idx = ILO_COMP_MAX_INTERVALS;
+    uint32_t i;
+
+    if (recal_pending || (elapsed_us >= ILO_COMP_RECAL_PERIOD_US))
+    {
+        measure();
+    }
+    elapsed_us += interval_us;
+
+    for (i = 0U; i < ILO_COMP_MAX_INTERVALS; i++)
+    {
+        if (interval_us == cache[i].interval_us)
+        {
+            return cache[i].counts;
+        }
+        if ((0U == cache[i].interval_us) && (ILO_COMP_MAX_INTERVALS == free_idx))
+        {
+            free_idx = i;
+        }
+    }
+
+    /* Not cached yet. Without a free entry replace the first one. */
+    if (ILO_COMP_MAX_INTERVALS == free_idx)
+    {
+        free_idx = 0U;
+    }
+    cache[free_idx].interval_us = interval_us;
+    cache[free_idx].counts = scale_counts(interval_us);
+    return cache[free_idx].counts;
+}
+
+/*******************************************************************************
+ * Function Name: ilo_comp_get_reference_counts
+ ********************************************************************************
+ * Summary:
+ *  Returns the compensated ILO counts of ILO_COMP_REFERENCE_US from the last
+ *  measurement, for converting ILO ticks to device time. Does not account
+ *  elapsed device time and never measures.
+ *
+ *******************************************************************************/
+uint32_t ilo_comp_get_reference_counts(void)
+{
+    return reference_counts;
+}
+
+/*******************************************************************************
+ * Function Name: ilo_comp_request_recal
+ ********************************************************************************
+ * Summary:
+ *  Forces a new ILO measurement at the next ilo_comp_get_counts() call, for
+ *  example after a known temperature change.
+ *
+ *******************************************************************************/
+void ilo_comp_request_recal(void)
+{
+    recal_pending = true;
+}
+
+/*******************************************************************************
+ * Function Name: ilo_comp_get_recal_count
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of ILO measurements taken since initialization.
+ *
+ *******************************************************************************/
+uint32_t ilo_comp_get_recal_count(void)
+{
+    return recal_count;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * File Name: ilo_comp.h
+ *
+ * Description: Cached ILO compensation for the WDT wake-up interval. The ILO is
+ * measured against the IMO once and then only on a fixed recalibration
+ * schedule; the compensated WDT match counts of every wake-up interval in use
+ * are cached between measurements.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef ILO_COMP_H
+#define ILO_COMP_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Reference interval of the ILO measurement. Counts for other intervals are
+ * scaled from it, so it should be the longest interval in use. */
+#define ILO_COMP_REFERENCE_US           (100000UL)
+
+/* Device time between two ILO measurements. The ILO drifts mainly with
+ * temperature, which changes slowly compared to this period. */
+#define ILO_COMP_RECAL_PERIOD_US        (60000000UL)
+
+/* Number of distinct wake-up intervals kept in the cache */
+#define ILO_COMP_MAX_INTERVALS          (5U)
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void ilo_comp_init(void);
+uint32_t ilo_comp_get_counts(uint32_t interval_us);
+uint32_t ilo_comp_get_reference_counts(void);
+void ilo_comp_request_recal(void);
+uint32_t ilo_comp_get_recal_count(void);
+
+#endif /* ILO_COMP_H */
+
+/* [] END OF FILE */
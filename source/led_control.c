@@ -0,0 +1,477 @@
+/******************************************************************************
+ * File Name: led_control.c
+ *
+ * Description: LED1 brightness driven by the touchpad. The movement of a
+ * single finger between two consecutive touchpad frames moves the brightness,
+ * with a gain that grows with the finger speed, so a slow slide gives fine
+ * control and a fast one sweeps the whole range. Larger changes fade: the
+ * compare values of the fade are computed once and streamed by the PWM
+ * terminal count interrupt, one per PWM period, through the compare buffer.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stddef.h>
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "led_control.h"
+#include "touch_history.h"
+#include "boot_profile.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Segments of the gamma table */
+#define GAMMA_SEGMENTS              (32U)
+
+/* States of the fade after its last value */
+#define RAMP_SETTLING               (LED_CONTROL_RAMP_STEPS)
+#define RAMP_IDLE                   (LED_CONTROL_RAMP_STEPS + 1U)
+
+/* PWM terminal count interrupt priority, lowest: a fade step may slip by a
+ * PWM period */
+#define LED_CONTROL_INTR_PRIORITY   (3U)
+
+/* Axis of the slide being tracked */
+#define SLIDE_NONE                  (0U)
+#define SLIDE_X                     (1U)
+#define SLIDE_Y                     (2U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* (i / 32)^2.2 in Q16, interpolated linearly between the points */
+static const uint16_t gamma_table[GAMMA_SEGMENTS + 1U] =
+{
+        0U,    32U,   147U,   359U,   676U,  1104U,  1648U,  2314U,
+     3104U,  4022U,  5072U,  6255U,  7574U,  9033U, 10632U, 12375U,
+    14263U, 16298U, 18482U, 20816U, 23303U, 25943U, 28739U, 31692U,
+    34802U, 38072U, 41503U, 45097U, 48853U, 52774U, 56860U, 61114U,
+    65535U
+};
+
+static uint32_t target = 0U;        /* Level requested */
+static uint32_t output = 0U;        /* Level applied, or being faded to */
+static uint32_t on_level = LED_CONTROL_ON_LEVEL;    /* Level restored by a toggle */
+static uint32_t period = 0U;
+static led_control_stats_t stats;
+
+/* The PWM is brought up when the LED first lights */
+static bool pwm_started = false;
+
+/* PWM terminal count interrupt configuration, streams the fades */
+static const cy_stc_sysint_t pwm_isr_cfg =
+{
+    .intrSrc = pwm2_IRQ,
+    .intrPriority = LED_CONTROL_INTR_PRIORITY
+};
+
+/* Compare values of the fade in progress, and the index of the next one the
+ * interrupt writes. RAMP_SETTLING: the last value written waits for its
+ * swap; RAMP_IDLE: nothing left to do. */
+static uint16_t ramp[LED_CONTROL_RAMP_STEPS];
+static volatile uint32_t ramp_next = RAMP_IDLE;
+static uint32_t ramp_from = 0U;
+
+/* Landing point of the finger and axis of its slide */
+static touch_history_finger_t anchor;
+static uint32_t slide = SLIDE_NONE;
+
+/*******************************************************************************
+ * Function Name: level_to_compare
+ ********************************************************************************
+ * Summary:
+ *  Converts a perceptual level to a compare value. A level above 0 never
+ *  gives a dark LED.
+ *
+ *******************************************************************************/
+static uint32_t level_to_compare(uint32_t level)
+{
+    uint32_t pos = (level * (GAMMA_SEGMENTS << 8U)) / LED_CONTROL_LEVEL_MAX;
+    uint32_t index = pos >> 8U;
+    uint32_t frac = gamma_table[index];
+    uint32_t result;
+
+    if (index < GAMMA_SEGMENTS)
+    {
+        frac += ((gamma_table[index + 1U] - frac) * (pos & 0xFFU)) >> 8U;
+    }
+    result = ((frac * period) + 0x8000UL) >> 16U;
+    if ((0U != level) && (0U == result))
+    {
+        result = 1U;
+    }
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: write_compare
+ ********************************************************************************
+ * Summary:
+ *  Loads a compare value into the compare buffer and requests the swap, which
+ *  the PWM performs on its next terminal count, so that no period is cut.
+ *
+ *******************************************************************************/
+static void write_compare(uint32_t value)
+{
+    Cy_TCPWM_PWM_SetCompare1(pwm2_HW, pwm2_NUM, value);
+    Cy_TCPWM_TriggerCaptureOrSwap(pwm2_HW, pwm2_MASK);
+}
+
+/*******************************************************************************
+ * Function Name: led_control_init
+ ********************************************************************************
+ * Summary:
+ *  Starts with the LED off. The PWM is left alone until led_control_start().
+ *
+ *******************************************************************************/
+void led_control_init(void)
+{
+    target = 0U;
+    output = 0U;
+    on_level = LED_CONTROL_ON_LEVEL;
+    ramp_next = RAMP_IDLE;
+    slide = SLIDE_NONE;
+    stats = (led_control_stats_t){ 0U, 0U, 0U };
+}
+
+/*******************************************************************************
+ * Function Name: led_control_start
+ ********************************************************************************
+ * Summary:
+ *  Brings up the PWM with a dark LED and routes its terminal count interrupt
+ *  to led_control_isr(), once. led_control_apply() calls it when the LED
+ *  first lights.
+ *
+ *******************************************************************************/
+void led_control_start(void)
+{
+    uint32_t start;
+
+    if (pwm_started)
+    {
+        return;
+    }
+    start = stage_profile_now();
+
+    Cy_TCPWM_PWM_Init(pwm2_HW, pwm2_NUM, &pwm2_config);
+    Cy_TCPWM_PWM_Enable(pwm2_HW, pwm2_NUM);
+    Cy_TCPWM_TriggerStart(pwm2_HW, pwm2_MASK);
+
+    period = Cy_TCPWM_PWM_GetPeriod0(pwm2_HW, pwm2_NUM);
+    Cy_TCPWM_SetInterruptMask(pwm2_HW, pwm2_NUM, CY_TCPWM_INT_NONE);
+    Cy_TCPWM_PWM_SetCompare0(pwm2_HW, pwm2_NUM, 0U);
+    Cy_TCPWM_PWM_SetCompare1(pwm2_HW, pwm2_NUM, 0U);
+
+    if (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&pwm_isr_cfg, led_control_isr))
+    {
+        CY_ASSERT(0);
+    }
+    NVIC_EnableIRQ(pwm_isr_cfg.intrSrc);
+
+    pwm_started = true;
+    boot_profile_since(BOOT_PROFILE_PWM, start);
+}
+
+/*******************************************************************************
+ * Function Name: led_control_toggle
+ ********************************************************************************
+ * Summary:
+ *  Turns the LED off, or back on at the level it had when turned off.
+ *
+ *******************************************************************************/
+void led_control_toggle(void)
+{
+    if (0U != target)
+    {
+        on_level = target;
+        target = 0U;
+    }
+    else
+    {
+        target = on_level;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: led_control_adjust
+ ********************************************************************************
+ * Summary:
+ *  Moves the brightness by a number of levels, within the range.
+ *
+ * Parameters:
+ *  levels: change, negative to dim
+ *
+ *******************************************************************************/
+void led_control_adjust(int32_t levels)
+{
+    int32_t level = (int32_t)target + levels;
+
+    if (level < 0)
+    {
+        level = 0;
+    }
+    else if (level > (int32_t)LED_CONTROL_LEVEL_MAX)
+    {
+        level = (int32_t)LED_CONTROL_LEVEL_MAX;
+    }
+    else
+    {
+        /* Within the range */
+    }
+    target = (uint32_t)level;
+}
+
+/*******************************************************************************
+ * Function Name: led_control_track
+ ********************************************************************************
+ * Summary:
+ *  Moves the brightness with the newest touchpad frame of the touch history.
+ *  Once a single finger has slid LED_CONTROL_SLIDE_START from where it landed,
+ *  its movement along the axis it slid on changes the brightness on every
+ *  frame: right and up brighten, left and down dim. Two fingers or a lift end
+ *  the slide.
+ *
+ * Parameters:
+ *  frame_us: device time since the previous touchpad frame
+ *
+ *******************************************************************************/
+void led_control_track(uint32_t frame_us)
+{
+    const touch_history_entry_t *now = touch_history_get(0U);
+    const touch_history_entry_t *before = touch_history_get(1U);
+    int32_t step;
+    uint32_t speed;
+    uint32_t gain;
+
+    if ((NULL == now) || (1U != now->fingers))
+    {
+        slide = SLIDE_NONE;
+        return;
+    }
+    if ((NULL == before) || (1U != before->fingers))
+    {
+        /* The finger has just landed */
+        anchor = now->finger[0];
+        slide = SLIDE_NONE;
+        return;
+    }
+
+    if (SLIDE_NONE == slide)
+    {
+        int32_t dx = (int32_t)now->finger[0].x - (int32_t)anchor.x;
+        int32_t dy = (int32_t)now->finger[0].y - (int32_t)anchor.y;
+        uint32_t adx = (uint32_t)((dx < 0) ? -dx : dx);
+        uint32_t ady = (uint32_t)((dy < 0) ? -dy : dy);
+
+        if ((adx + ady) <= LED_CONTROL_SLIDE_START)
+        {
+            return;
+        }
+        slide = (adx >= ady) ? SLIDE_X : SLIDE_Y;
+    }
+
+    /* The Y position grows downwards */
+    step = (SLIDE_X == slide) ? ((int32_t)now->finger[0].x - (int32_t)before->finger[0].x) :
+                                ((int32_t)before->finger[0].y - (int32_t)now->finger[0].y);
+    if ((0 == step) || (0U == frame_us))
+    {
+        return;
+    }
+
+    speed = (uint32_t)((step < 0) ? -step : step);
+    gain = LED_CONTROL_GAIN_BASE + (((speed * LED_CONTROL_FRAME_US) / frame_us) * LED_CONTROL_GAIN_ACCEL);
+    if (gain > LED_CONTROL_GAIN_MAX)
+    {
+        gain = LED_CONTROL_GAIN_MAX;
+    }
+
+    led_control_adjust((step * (int32_t)gain) / (int32_t)(1UL << LED_CONTROL_GAIN_SHIFT));
+    stats.tracked++;
+}
+
+/*******************************************************************************
+ * Function Name: led_control_apply
+ ********************************************************************************
+ * Summary:
+ *  Applies the requested level. A change up to LED_CONTROL_FADE_THRESHOLD is
+ *  written at once and takes effect on the next PWM period; a larger one
+ *  fades over LED_CONTROL_RAMP_STEPS periods, starting from where a fade in
+ *  progress has got to. Call once per frame, after the gesture actions and
+ *  led_control_track().
+ *
+ *******************************************************************************/
+void led_control_apply(void)
+{
+    uint32_t from = output;
+    uint32_t next;
+
+    if (output == target)
+    {
+        return;
+    }
+    led_control_start();
+
+    /* Stop the interrupt; a fade in progress stops at the last value written */
+    Cy_TCPWM_SetInterruptMask(pwm2_HW, pwm2_NUM, CY_TCPWM_INT_NONE);
+    next = ramp_next;
+    if (next < RAMP_SETTLING)
+    {
+        from = (uint32_t)((int32_t)ramp_from +
+                          ((((int32_t)output - (int32_t)ramp_from) * (int32_t)next) / (int32_t)LED_CONTROL_RAMP_STEPS));
+    }
+
+    if (((target > from) ? (target - from) : (from - target)) > LED_CONTROL_FADE_THRESHOLD)
+    {
+        for (uint32_t i = 0U; i < LED_CONTROL_RAMP_STEPS; i++)
+        {
+            int32_t level = (int32_t)from + ((((int32_t)target - (int32_t)from) * (int32_t)(i + 1U)) /
+                                             (int32_t)LED_CONTROL_RAMP_STEPS);
+
+            ramp[i] = (uint16_t)level_to_compare((uint32_t)level);
+        }
+        ramp_from = from;
+        ramp_next = 0U;
+        stats.fades++;
+    }
+    else
+    {
+        write_compare(level_to_compare(target));
+        ramp_next = RAMP_SETTLING;
+        stats.writes++;
+    }
+    output = target;
+
+    Cy_TCPWM_ClearInterrupt(pwm2_HW, pwm2_NUM, CY_TCPWM_INT_ON_TC);
+    Cy_TCPWM_SetInterruptMask(pwm2_HW, pwm2_NUM, CY_TCPWM_INT_ON_TC);
+}
+
+/*******************************************************************************
+ * Function Name: led_control_isr
+ ********************************************************************************
+ * Summary:
+ *  PWM terminal count interrupt: the previous compare value has just been
+ *  swapped in; loads the next one of the fade. The interrupt is disabled once
+ *  the last value is in use.
+ *
+ *******************************************************************************/
+void led_control_isr(void)
+{
+    uint32_t next = ramp_next;
+
+    if (0U == (Cy_TCPWM_GetInterruptStatusMasked(pwm2_HW, pwm2_NUM) & CY_TCPWM_INT_ON_TC))
+    {
+        return;
+    }
+    Cy_TCPWM_ClearInterrupt(pwm2_HW, pwm2_NUM, CY_TCPWM_INT_ON_TC);
+
+    if (next < RAMP_SETTLING)
+    {
+        write_compare(ramp[next]);
+    }
+    next++;
+    ramp_next = next;
+    if (next >= RAMP_IDLE)
+    {
+        Cy_TCPWM_SetInterruptMask(pwm2_HW, pwm2_NUM, CY_TCPWM_INT_NONE);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: led_control_is_lit
+ ********************************************************************************
+ * Summary:
+ *  Returns true while the LED is on or its compare value is changing. The
+ *  PWM is not clocked in Deep Sleep, where its output would freeze.
+ *
+ *******************************************************************************/
+bool led_control_is_lit(void)
+{
+    return (0U != output) || (RAMP_IDLE != ramp_next);
+}
+
+/*******************************************************************************
+ * Function Name: led_control_suspend
+ ********************************************************************************
+ * Summary:
+ *  Disables the PWM before Deep Sleep, which it would freeze with the output
+ *  in an arbitrary state. Not used with LED_CONTROL_SLEEP_WHILE_LIT 1.
+ *
+ *******************************************************************************/
+void led_control_suspend(void)
+{
+    Cy_TCPWM_PWM_Disable(pwm2_HW, pwm2_NUM);
+}
+
+/*******************************************************************************
+ * Function Name: led_control_resume
+ ********************************************************************************
+ * Summary:
+ *  Enables and restarts the PWM after Deep Sleep. The compare values and a
+ *  fade in progress are retained and continue from where they stopped.
+ *
+ *******************************************************************************/
+void led_control_resume(void)
+{
+    Cy_TCPWM_PWM_Enable(pwm2_HW, pwm2_NUM);
+    Cy_TCPWM_TriggerStart(pwm2_HW, pwm2_MASK);
+}
+
+/*******************************************************************************
+ * Function Name: led_control_get_level
+ ********************************************************************************
+ * Summary:
+ *  Returns the level applied to the PWM.
+ *
+ *******************************************************************************/
+uint32_t led_control_get_level(void)
+{
+    return output;
+}
+
+/*******************************************************************************
+ * Function Name: led_control_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the control counters.
+ *
+ *******************************************************************************/
+const led_control_stats_t *led_control_get_stats(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
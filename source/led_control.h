@@ -0,0 +1,126 @@
+/******************************************************************************
+ * File Name: led_control.h
+ *
+ * Description: LED1 brightness driven by the touchpad. The brightness is kept
+ * as a perceptual level, converted to the pwm2 compare value through a gamma
+ * curve and written through the compare buffer, which the PWM swaps in on
+ * its terminal count. Large changes fade from a precomputed ramp.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef LED_CONTROL_H
+#define LED_CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* 1: one-finger movement sets the brightness on every touchpad frame.
+ * 0: only the scroll and flick gesture actions step it. */
+#ifndef LED_CONTROL_CONTINUOUS
+#define LED_CONTROL_CONTINUOUS          (1U)
+#endif
+
+/* 0: the device deep-sleeps regardless; the PWM is stopped around each Deep
+ *    Sleep and LED1 is dark for most of every wake interval.
+ * 1: while LED1 is lit or fading only the CPU sleeps, so the PWM keeps
+ *    running at the cost of the CPU Sleep current, more than 5x the average
+ *    current of the demo.
+ * The TCPWM is not clocked in Deep Sleep, so no setting keeps LED1 lit
+ * through Deep Sleep. */
+#ifndef LED_CONTROL_SLEEP_WHILE_LIT
+#define LED_CONTROL_SLEEP_WHILE_LIT     (0U)
+#endif
+
+/* Perceptual brightness range; the gamma curve maps it onto the PWM period */
+#define LED_CONTROL_LEVEL_MAX           (1000U)
+
+/* Level restored when the LED is first turned on, 10% duty cycle */
+#define LED_CONTROL_ON_LEVEL            (351U)
+
+/* Level changes above this fade; finger movement stays below it and is
+ * applied on the next PWM period */
+#define LED_CONTROL_FADE_THRESHOLD      (250U)
+
+/* Compare values of a fade, one per PWM period: 85 ms at 750 Hz */
+#define LED_CONTROL_RAMP_STEPS          (64U)
+
+/* Distance, in position units, a finger has to slide from where it landed
+ * before it moves the brightness; a click stays below it */
+#define LED_CONTROL_SLIDE_START         (8U)
+
+/* Levels per position unit along the slide, Q4: the gain grows with the
+ * finger speed, by LED_CONTROL_GAIN_ACCEL per position unit per reference
+ * frame */
+#define LED_CONTROL_GAIN_SHIFT          (4U)
+#define LED_CONTROL_GAIN_BASE           (32U)
+#define LED_CONTROL_GAIN_ACCEL          (16U)
+#define LED_CONTROL_GAIN_MAX            (160U)
+
+/* Frame period the finger speed is normalized to, in us */
+#define LED_CONTROL_FRAME_US            (10000U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t tracked;           /* Touchpad frames that moved the brightness */
+    uint32_t fades;             /* Fades started */
+    uint32_t writes;            /* Level changes applied without a fade */
+} led_control_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void led_control_init(void);
+void led_control_start(void);
+void led_control_toggle(void);
+void led_control_adjust(int32_t levels);
+void led_control_track(uint32_t frame_us);
+void led_control_apply(void);
+void led_control_isr(void);
+bool led_control_is_lit(void);
+void led_control_suspend(void);
+void led_control_resume(void);
+uint32_t led_control_get_level(void);
+const led_control_stats_t *led_control_get_stats(void);
+
+#endif /* LED_CONTROL_H */
+
+/* [] END OF FILE */
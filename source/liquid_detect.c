@@ -0,0 +1,314 @@
+/******************************************************************************
+ * File Name: liquid_detect.c
+ *
+ * Description: Liquid film detection. A film or a droplet raises the diff count
+ * of the sensors under it without forming a touch; the baseline stops following
+ * at the noise threshold, so the signal stays visible for as long as the liquid
+ * does. Only the sensors found wet are filtered.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "liquid_detect.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define LIQUID_TP_WDGT_ID           (CY_CAPSENSE_TOUCHPAD0_WDGT_ID)
+#define LIQUID_TP_NUM_SNS           (CY_CAPSENSE_TOUCHPAD0_NUM_SNS)
+#define LIQUID_PROX_WDGT_ID         (CY_CAPSENSE_PROXIMITY0_WDGT_ID)
+
+/* One bit per touchpad sensor */
+_Static_assert(LIQUID_TP_NUM_SNS <= 32U, "Wet mask too narrow for the touchpad");
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+static uint8_t score[LIQUID_TP_NUM_SNS];
+
+/* Touchpad sensors currently wet */
+static uint32_t wet_mask = 0U;
+
+/* Filtered raw counts of the wet sensors, Q(LIQUID_IIR_SHIFT + 8) */
+static uint32_t iir[LIQUID_TP_NUM_SNS];
+
+/* Sensors whose filter has been seeded */
+static uint32_t iir_mask = 0U;
+
+/* Proximity sensor state */
+static bool prox_wet = false;
+static uint16_t prox_last_diff = 0U;
+static uint8_t prox_count = 0U;
+
+static bool wet = false;
+static liquid_detect_stats_t stats;
+
+/*******************************************************************************
+ * Function Name: update_wet
+ ********************************************************************************
+ * Summary:
+ *  Recomputes the wet condition from the touchpad and proximity state.
+ *
+ *******************************************************************************/
+static void update_wet(void)
+{
+    bool now = (0U != wet_mask) || prox_wet;
+
+    if (now && !wet)
+    {
+        stats.wet_entries++;
+    }
+    wet = now;
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_init
+ ********************************************************************************
+ * Summary:
+ *  Starts with a dry panel.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void liquid_detect_init(cy_stc_capsense_context_t *context)
+{
+    capsense_ctx = context;
+    for (uint32_t i = 0U; i < LIQUID_TP_NUM_SNS; i++)
+    {
+        score[i] = 0U;
+    }
+    wet_mask = 0U;
+    iir_mask = 0U;
+    prox_wet = false;
+    prox_last_diff = 0U;
+    prox_count = 0U;
+    wet = false;
+    stats = (liquid_detect_stats_t){ 0 };
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_filter
+ ********************************************************************************
+ * Summary:
+ *  Replaces the raw counts of the wet touchpad sensors with their IIR filtered
+ *  value. Call on a completed touchpad frame before Cy_CapSense_ProcessWidget().
+ *  Dry sensors are left untouched and cost nothing.
+ *
+ *******************************************************************************/
+void liquid_detect_filter(void)
+{
+    cy_stc_capsense_sensor_context_t *sns = capsense_ctx->ptrWdConfig[LIQUID_TP_WDGT_ID].ptrSnsContext;
+    uint32_t pending = wet_mask;
+
+    /* A sensor that has dried restarts its filter when it gets wet again */
+    iir_mask &= wet_mask;
+
+    for (uint32_t i = 0U; 0U != pending; i++, pending >>= 1U)
+    {
+        uint32_t bit = 1UL << i;
+        uint32_t raw;
+
+        if (0U == (pending & 1U))
+        {
+            continue;
+        }
+
+        raw = (uint32_t)sns[i].raw << (LIQUID_IIR_SHIFT + 8U);
+        if (0U == (iir_mask & bit))
+        {
+            iir[i] = raw;
+            iir_mask |= bit;
+        }
+        else
+        {
+            iir[i] = (uint32_t)((int32_t)iir[i] + (((int32_t)raw - (int32_t)iir[i]) >> LIQUID_IIR_SHIFT));
+        }
+        sns[i].raw = (uint16_t)(iir[i] >> (LIQUID_IIR_SHIFT + 8U));
+        stats.filtered++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_touchpad
+ ********************************************************************************
+ * Summary:
+ *  Updates the wet sensors from a processed touchpad frame. Frames with a
+ *  reported touch are skipped: the edges of a finger look like liquid.
+ *
+ *******************************************************************************/
+void liquid_detect_touchpad(void)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[LIQUID_TP_WDGT_ID];
+    const cy_stc_capsense_sensor_context_t *sns = wd->ptrSnsContext;
+    uint32_t noise_th = wd->ptrWdContext->noiseTh;
+
+    if (wet)
+    {
+        stats.wet_frames++;
+    }
+    if (0U != wd->ptrWdContext->wdTouch.numPosition)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0U; i < LIQUID_TP_NUM_SNS; i++)
+    {
+        if (sns[i].diff >= noise_th)
+        {
+            score[i] = (score[i] < (LIQUID_SCORE_MAX - 1U)) ? (uint8_t)(score[i] + 2U) : (uint8_t)LIQUID_SCORE_MAX;
+        }
+        else if (score[i] > 0U)
+        {
+            score[i]--;
+        }
+        else
+        {
+            /* Dry */
+        }
+
+        if (score[i] >= LIQUID_WET_SCORE)
+        {
+            wet_mask |= 1UL << i;
+        }
+        else if (0U == score[i])
+        {
+            wet_mask &= ~(1UL << i);
+        }
+        else
+        {
+            /* Keep the state until the score has fully decayed */
+        }
+    }
+    update_wet();
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_proximity
+ ********************************************************************************
+ * Summary:
+ *  Updates the wet state from a processed proximity frame. A hand produces a
+ *  changing signal that reaches the proximity threshold; liquid on the panel
+ *  produces a steady signal below it.
+ *
+ *******************************************************************************/
+void liquid_detect_proximity(void)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[LIQUID_PROX_WDGT_ID];
+    const cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+    uint16_t diff = wd->ptrSnsContext[0].diff;
+    uint32_t step = (diff > prox_last_diff) ? (uint32_t)(diff - prox_last_diff) : (uint32_t)(prox_last_diff - diff);
+    bool steady = (diff >= wdc->noiseTh) && (diff < wdc->proxTh) && (step < wdc->noiseTh);
+
+    prox_last_diff = diff;
+
+    if (prox_wet != steady)
+    {
+        prox_count++;
+        if (prox_count >= (prox_wet ? LIQUID_PROX_DRY_FRAMES : LIQUID_PROX_WET_FRAMES))
+        {
+            prox_wet = steady;
+            prox_count = 0U;
+            if (prox_wet)
+            {
+                stats.prox_wet_entries++;
+            }
+        }
+    }
+    else
+    {
+        prox_count = 0U;
+    }
+    update_wet();
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_proximity_clear
+ ********************************************************************************
+ * Summary:
+ *  Drops the proximity wet state when the touchpad takes over. The proximity
+ *  sensor is not scanned in the touchpad levels, so its last verdict could
+ *  not decay there; the touchpad sensors report liquid on their own. The
+ *  steady-signal count restarts from the next proximity frame.
+ *
+ *******************************************************************************/
+void liquid_detect_proximity_clear(void)
+{
+    prox_wet = false;
+    prox_last_diff = 0U;
+    prox_count = 0U;
+    update_wet();
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_is_wet
+ ********************************************************************************
+ * Summary:
+ *  Returns true while liquid is present on the touchpad or the proximity
+ *  sensor.
+ *
+ *******************************************************************************/
+bool liquid_detect_is_wet(void)
+{
+    return wet;
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_get_mask
+ ********************************************************************************
+ * Summary:
+ *  Returns the wet touchpad sensors, bit N is sensor N of the widget.
+ *
+ *******************************************************************************/
+uint32_t liquid_detect_get_mask(void)
+{
+    return wet_mask;
+}
+
+/*******************************************************************************
+ * Function Name: liquid_detect_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the liquid detection counters.
+ *
+ *******************************************************************************/
+const liquid_detect_stats_t *liquid_detect_get_stats(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * File Name: liquid_detect.h
+ *
+ * Description: Liquid film detection on the touchpad and the proximity sensor.
+ * Flags the touchpad sensors that carry a sustained signal without a reported
+ * touch, filters their raw counts, and reports the wet condition that selects
+ * the faster wet scan intervals of the power levels.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef LIQUID_DETECT_H
+#define LIQUID_DETECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Score of a touchpad sensor: +2 per frame with a signal at or above the
+ * noise threshold and no reported touch, -1 per frame without. The sensor is
+ * wet from LIQUID_WET_SCORE (ten frames) until the score has decayed to 0. */
+#define LIQUID_WET_SCORE                (20U)
+#define LIQUID_SCORE_MAX                (60U)
+
+/* Consecutive proximity frames with a steady sub-threshold signal before the
+ * panel is considered wet, and without a signal before it is dry again */
+#define LIQUID_PROX_WET_FRAMES          (10U)
+#define LIQUID_PROX_DRY_FRAMES          (10U)
+
+/* Raw count IIR of the wet sensors: new = old + (raw - old) / 2^SHIFT */
+#define LIQUID_IIR_SHIFT                (2U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t wet_entries;       /* Dry to wet transitions */
+    uint32_t prox_wet_entries;  /* Wet transitions reported by the proximity sensor */
+    uint32_t wet_frames;        /* Touchpad frames processed while wet */
+    uint32_t filtered;          /* Sensor raw counts filtered, all frames */
+} liquid_detect_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void liquid_detect_init(cy_stc_capsense_context_t *context);
+void liquid_detect_filter(void);
+void liquid_detect_touchpad(void);
+void liquid_detect_proximity(void);
+void liquid_detect_proximity_clear(void);
+bool liquid_detect_is_wet(void);
+uint32_t liquid_detect_get_mask(void);
+const liquid_detect_stats_t *liquid_detect_get_stats(void);
+
+#endif /* LIQUID_DETECT_H */
+
+/* [] END OF FILE */
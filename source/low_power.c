@@ -0,0 +1,570 @@
+/******************************************************************************
+ * File Name: low_power.c
+ *
+ * Description: Deep Sleep entry gated on the actual state of the debug UART
+ * transmitter and the MSC scan, with a counter of the Active time saved
+ * compared to a fixed pre-sleep delay, CPU Sleep entry for the frames that
+ * need the peripheral clocks, and the Deep Sleep callback of the application
+ * peripherals.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "low_power.h"
+#include "gesture_log.h"
+#include "led_control.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    bool (*idle)(void);         /* Nothing to do for this Deep Sleep entry */
+    cy_en_syspm_status_t (*transition)(cy_en_syspm_callback_mode_t mode);
+} periph_ops_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+static bool uart_idle(void);
+static cy_en_syspm_status_t uart_transition(cy_en_syspm_callback_mode_t mode);
+static bool pwm_idle(void);
+static cy_en_syspm_status_t pwm_transition(cy_en_syspm_callback_mode_t mode);
+static bool ezi2c_idle(void);
+static cy_en_syspm_status_t ezi2c_transition(cy_en_syspm_callback_mode_t mode);
+static bool msc_idle(void);
+static cy_en_syspm_status_t refuse(cy_en_syspm_callback_mode_t mode);
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static CySCB_Type *uart_hw = NULL;
+static cy_stc_scb_uart_context_t *uart_ctx = NULL;
+static const cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/* The UART is left disabled after Deep Sleep until it is needed */
+static bool uart_enabled = false;
+
+/* Peripherals that have been brought up; the others are left out */
+static uint32_t started_mask = 0U;
+
+static const periph_ops_t periph_ops[LOW_POWER_PERIPH_COUNT] =
+{
+    [LOW_POWER_UART]  = { uart_idle,  uart_transition },
+    [LOW_POWER_PWM]   = { pwm_idle,   pwm_transition },
+    [LOW_POWER_EZI2C] = { ezi2c_idle, ezi2c_transition },
+    [LOW_POWER_MSC]   = { msc_idle,   refuse },
+};
+
+/* Peripherals prepared by the Deep Sleep entry in progress */
+static uint32_t prepared_mask = 0U;
+static uint32_t entry_start = 0U;
+static low_power_periph_stats_t periph_stats[LOW_POWER_PERIPH_COUNT];
+
+/* The one Deep Sleep callback */
+static cy_stc_syspm_callback_params_t ezi2c_params;
+static cy_stc_syspm_callback_params_t callback_params;
+static cy_stc_syspm_callback_t callback;
+
+/* Active time saved compared to a fixed LOW_POWER_DRAIN_BUDGET_US delay */
+static uint64_t saved_us = 0U;
+
+/* Number of Deep Sleep entries that had to wait for the UART or the scan */
+static uint32_t wait_count = 0U;
+
+/*******************************************************************************
+ * Function Name: sleep_blocked
+ ********************************************************************************
+ * Summary:
+ *  Returns true while the UART is transmitting, gesture events are still
+ *  queued for it or a scan is in progress. All of these are stopped by Deep
+ *  Sleep, so the transition must wait for them.
+ *
+ *******************************************************************************/
+static bool sleep_blocked(void)
+{
+    return (uart_enabled && (!Cy_SCB_UART_IsTxComplete(uart_hw) || gesture_log_is_busy())) ||
+           ((NULL != capsense_ctx) && (CY_CAPSENSE_NOT_BUSY != Cy_CapSense_IsBusy(capsense_ctx)));
+}
+
+/*******************************************************************************
+ * Function Name: uart_idle
+ ********************************************************************************
+ * Summary:
+ *  The UART is idle once disabled: nothing was sent since the last Deep Sleep.
+ *
+ *******************************************************************************/
+static bool uart_idle(void)
+{
+    return !uart_enabled;
+}
+
+/*******************************************************************************
+ * Function Name: uart_transition
+ ********************************************************************************
+ * Summary:
+ *  Disables the UART once the last byte has left the shifter. It is not
+ *  enabled again on wake-up; low_power_resume() does that when a gesture is
+ *  to be sent.
+ *
+ *******************************************************************************/
+static cy_en_syspm_status_t uart_transition(cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t status = CY_SYSPM_SUCCESS;
+
+    switch (mode)
+    {
+    case CY_SYSPM_CHECK_READY:
+        if (!Cy_SCB_UART_IsTxComplete(uart_hw) || gesture_log_is_busy())
+        {
+            status = CY_SYSPM_FAIL;
+        }
+        else
+        {
+            Cy_SCB_UART_Disable(uart_hw, uart_ctx);
+            uart_enabled = false;
+        }
+        break;
+
+    case CY_SYSPM_CHECK_FAIL:
+        Cy_SCB_UART_Enable(uart_hw);
+        uart_enabled = true;
+        break;
+
+    default:
+        /* Nothing to do on the transition itself */
+        break;
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: pwm_idle
+ ********************************************************************************
+ * Summary:
+ *  The PWM is idle while LED1 is off. Its registers are retained, so it needs
+ *  no transition; while lit it is handled by pwm_transition(), since its
+ *  output would freeze in Deep Sleep.
+ *
+ *******************************************************************************/
+static bool pwm_idle(void)
+{
+    return !led_control_is_lit();
+}
+
+/*******************************************************************************
+ * Function Name: pwm_transition
+ ********************************************************************************
+ * Summary:
+ *  Stops the PWM for the Deep Sleep and restarts it on wake-up. Refuses Deep
+ *  Sleep while LED1 is lit when LED_CONTROL_SLEEP_WHILE_LIT keeps the CPU in
+ *  Sleep instead.
+ *
+ *******************************************************************************/
+static cy_en_syspm_status_t pwm_transition(cy_en_syspm_callback_mode_t mode)
+{
+#if (0U != LED_CONTROL_SLEEP_WHILE_LIT)
+    return refuse(mode);
+#else
+    switch (mode)
+    {
+    case CY_SYSPM_BEFORE_TRANSITION:
+        led_control_suspend();
+        break;
+
+    case CY_SYSPM_AFTER_TRANSITION:
+        led_control_resume();
+        break;
+
+    default:
+        /* Nothing to check: the PWM can stop at any time */
+        break;
+    }
+    return CY_SYSPM_SUCCESS;
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: ezi2c_idle
+ ********************************************************************************
+ * Summary:
+ *  The EZI2C slave always takes part: it wakes the device on its address.
+ *
+ *******************************************************************************/
+static bool ezi2c_idle(void)
+{
+    return (NULL == ezi2c_params.base);
+}
+
+/*******************************************************************************
+ * Function Name: ezi2c_transition
+ ********************************************************************************
+ * Summary:
+ *  Runs the EZI2C driver Deep Sleep callback.
+ *
+ *******************************************************************************/
+static cy_en_syspm_status_t ezi2c_transition(cy_en_syspm_callback_mode_t mode)
+{
+    return Cy_SCB_EZI2C_DeepSleepCallback(&ezi2c_params, mode);
+}
+
+/*******************************************************************************
+ * Function Name: msc_idle
+ ********************************************************************************
+ * Summary:
+ *  The MSC blocks are idle when no scan is in progress. Their configuration is
+ *  retained, so they need no transition; while scanning they refuse Deep
+ *  Sleep.
+ *
+ *******************************************************************************/
+static bool msc_idle(void)
+{
+    return (NULL == capsense_ctx) || (CY_CAPSENSE_NOT_BUSY == Cy_CapSense_IsBusy(capsense_ctx));
+}
+
+/*******************************************************************************
+ * Function Name: refuse
+ ********************************************************************************
+ * Summary:
+ *  Transition of a peripheral that cannot enter Deep Sleep unless idle.
+ *
+ *******************************************************************************/
+static cy_en_syspm_status_t refuse(cy_en_syspm_callback_mode_t mode)
+{
+    return (CY_SYSPM_CHECK_READY == mode) ? CY_SYSPM_FAIL : CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: restore
+ ********************************************************************************
+ * Summary:
+ *  Runs a restoring mode on the prepared peripherals, in reverse order.
+ *
+ * Return:
+ *  CPU cycles spent
+ *
+ *******************************************************************************/
+static uint32_t restore(cy_en_syspm_callback_mode_t mode)
+{
+    uint32_t start = stage_profile_now();
+
+    for (uint32_t i = LOW_POWER_PERIPH_COUNT; i > 0U; i--)
+    {
+        if (0U != (prepared_mask & (1UL << (i - 1U))))
+        {
+            uint32_t periph_start = stage_profile_now();
+            low_power_periph_stats_t *stats = &periph_stats[i - 1U];
+
+            (void)periph_ops[i - 1U].transition(mode);
+            stats->exit_cycles = stage_profile_elapsed(periph_start);
+            if (stats->exit_cycles > stats->max_exit_cycles)
+            {
+                stats->max_exit_cycles = stats->exit_cycles;
+            }
+        }
+    }
+    prepared_mask = 0U;
+    return stage_profile_elapsed(start);
+}
+
+/*******************************************************************************
+ * Function Name: deep_sleep_callback
+ ********************************************************************************
+ * Summary:
+ *  Deep Sleep callback of all the application peripherals. Each peripheral
+ *  that is not idle is checked and prepared once, in low_power_periph_t
+ *  order, and restored in reverse order. A refusal rolls back the
+ *  peripherals already prepared.
+ *
+ * Parameters:
+ *  callbackParams: unused
+ *  mode: callback mode
+ *
+ * Return:
+ *  CY_SYSPM_FAIL if a peripheral refused Deep Sleep
+ *
+ *******************************************************************************/
+static cy_en_syspm_status_t deep_sleep_callback(cy_stc_syspm_callback_params_t *callbackParams,
+                                                cy_en_syspm_callback_mode_t mode)
+{
+    cy_en_syspm_status_t status = CY_SYSPM_SUCCESS;
+
+    (void)callbackParams;
+
+    switch (mode)
+    {
+    case CY_SYSPM_CHECK_READY:
+        entry_start = stage_profile_now();
+        prepared_mask = 0U;
+        for (uint32_t i = 0U; (i < LOW_POWER_PERIPH_COUNT) && (CY_SYSPM_SUCCESS == status); i++)
+        {
+            uint32_t start = stage_profile_now();
+
+            if ((0U == (started_mask & (1UL << i))) || periph_ops[i].idle())
+            {
+                periph_stats[i].skipped++;
+            }
+            else if (CY_SYSPM_SUCCESS == periph_ops[i].transition(CY_SYSPM_CHECK_READY))
+            {
+                prepared_mask |= (1UL << i);
+                periph_stats[i].prepared++;
+                periph_stats[i].enter_cycles = stage_profile_elapsed(start);
+            }
+            else
+            {
+                periph_stats[i].refused++;
+                status = CY_SYSPM_FAIL;
+            }
+        }
+        if (CY_SYSPM_SUCCESS != status)
+        {
+            (void)restore(CY_SYSPM_CHECK_FAIL);
+        }
+        break;
+
+    case CY_SYSPM_CHECK_FAIL:
+        /* A later callback refused */
+        (void)restore(CY_SYSPM_CHECK_FAIL);
+        break;
+
+    case CY_SYSPM_BEFORE_TRANSITION:
+        for (uint32_t i = 0U; i < LOW_POWER_PERIPH_COUNT; i++)
+        {
+            if (0U != (prepared_mask & (1UL << i)))
+            {
+                uint32_t start = stage_profile_now();
+
+                (void)periph_ops[i].transition(CY_SYSPM_BEFORE_TRANSITION);
+                periph_stats[i].enter_cycles += stage_profile_elapsed(start);
+            }
+        }
+        stage_profile_since(STAGE_PROFILE_PM_SLEEP, entry_start);
+        break;
+
+    case CY_SYSPM_AFTER_TRANSITION:
+        stage_profile_record(STAGE_PROFILE_PM_WAKE, restore(CY_SYSPM_AFTER_TRANSITION));
+        break;
+
+    default:
+        /* Not registered for the other modes */
+        break;
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_init
+ ********************************************************************************
+ * Summary:
+ *  Sets the peripherals whose state gates Deep Sleep entry and registers the
+ *  Deep Sleep callback that prepares them. The UART and the EZI2C slave are
+ *  left out until low_power_start(); the PWM is idle until the LED lights.
+ *
+ * Parameters:
+ *  config: peripherals of the application; a NULL base leaves the
+ *          peripheral out
+ *
+ * Return:
+ *  false if the callback could not be registered
+ *
+ *******************************************************************************/
+bool low_power_init(const low_power_config_t *config)
+{
+    uart_hw = config->uart_base;
+    uart_ctx = config->uart_context;
+    uart_enabled = false;
+    started_mask = (1UL << LOW_POWER_PWM) | (1UL << LOW_POWER_MSC);
+    capsense_ctx = config->capsense_context;
+    ezi2c_params.base = config->ezi2c_base;
+    ezi2c_params.context = config->ezi2c_context;
+    saved_us = 0U;
+    wait_count = 0U;
+    prepared_mask = 0U;
+    for (uint32_t i = 0U; i < LOW_POWER_PERIPH_COUNT; i++)
+    {
+        periph_stats[i] = (low_power_periph_stats_t){ 0U, 0U, 0U, 0U, 0U, 0U };
+    }
+
+    callback_params.base = NULL;
+    callback_params.context = NULL;
+    callback.callback = &deep_sleep_callback;
+    callback.type = CY_SYSPM_DEEPSLEEP;
+    callback.skipMode = 0UL;
+    callback.callbackParams = &callback_params;
+    callback.prevItm = NULL;
+    callback.nextItm = NULL;
+    callback.order = 0U;
+    return Cy_SysPm_RegisterCallback(&callback);
+}
+
+/*******************************************************************************
+ * Function Name: low_power_start
+ ********************************************************************************
+ * Summary:
+ *  Takes a peripheral brought up after low_power_init() into the Deep Sleep
+ *  callback. The UART is enabled.
+ *
+ * Parameters:
+ *  periph: peripheral that has just been initialized
+ *
+ *******************************************************************************/
+void low_power_start(low_power_periph_t periph)
+{
+    started_mask |= (1UL << periph);
+    low_power_resume(periph);
+}
+
+/*******************************************************************************
+ * Function Name: low_power_resume
+ ********************************************************************************
+ * Summary:
+ *  Enables a peripheral that the Deep Sleep callback left off, before it is
+ *  used. Only the UART is left off; the other peripherals are restored on
+ *  wake-up.
+ *
+ * Parameters:
+ *  periph: peripheral about to be used
+ *
+ *******************************************************************************/
+void low_power_resume(low_power_periph_t periph)
+{
+    if ((LOW_POWER_UART == periph) && !uart_enabled && (NULL != uart_hw) &&
+        (0U != (started_mask & (1UL << LOW_POWER_UART))))
+    {
+        Cy_SCB_UART_Enable(uart_hw);
+        uart_enabled = true;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: low_power_enter_deep_sleep
+ ********************************************************************************
+ * Summary:
+ *  Enters Deep Sleep as soon as the debug UART has nothing left to transmit
+ *  and no scan is in progress. When neither is pending, Deep Sleep is entered
+ *  immediately.
+ *
+ *******************************************************************************/
+void low_power_enter_deep_sleep(void)
+{
+    uint32_t waited_us = 0U;
+
+    if (sleep_blocked())
+    {
+        wait_count++;
+        do
+        {
+            Cy_SysLib_DelayUs(LOW_POWER_POLL_US);
+            waited_us += LOW_POWER_POLL_US;
+        } while (sleep_blocked());
+    }
+
+    if (waited_us < LOW_POWER_DRAIN_BUDGET_US)
+    {
+        saved_us += (LOW_POWER_DRAIN_BUDGET_US - waited_us);
+    }
+
+    Cy_SysPm_CpuEnterDeepSleep();
+}
+
+/*******************************************************************************
+ * Function Name: low_power_enter_sleep
+ ********************************************************************************
+ * Summary:
+ *  Keeps the CPU in Sleep until the wake-up flag is set. The peripherals stay
+ *  clocked, so the UART and the scan need not be waited for; their interrupts
+ *  are served and the CPU goes back to Sleep.
+ *
+ * Parameters:
+ *  wake: set by the interrupt that ends the sleep
+ *
+ *******************************************************************************/
+void low_power_enter_sleep(const volatile bool *wake)
+{
+    while (!*wake)
+    {
+        uint32_t saved = Cy_SysLib_EnterCriticalSection();
+
+        /* A pending interrupt ends the sleep even while masked, so the flag
+         * cannot be set between the check and the sleep unnoticed */
+        if (!*wake)
+        {
+            (void)Cy_SysPm_CpuEnterSleep();
+        }
+        Cy_SysLib_ExitCriticalSection(saved);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: low_power_get_saved_us
+ ********************************************************************************
+ * Summary:
+ *  Returns the Active time saved since initialization, in microseconds,
+ *  compared to waiting LOW_POWER_DRAIN_BUDGET_US before every Deep Sleep
+ *  entry.
+ *
+ *******************************************************************************/
+uint64_t low_power_get_saved_us(void)
+{
+    return saved_us;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_get_wait_count
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of Deep Sleep entries that waited for the UART or the
+ *  scan.
+ *
+ *******************************************************************************/
+uint32_t low_power_get_wait_count(void)
+{
+    return wait_count;
+}
+
+/*******************************************************************************
+ * Function Name: low_power_get_periph_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the Deep Sleep transition counters and times of a peripheral.
+ *
+ *******************************************************************************/
+const low_power_periph_stats_t *low_power_get_periph_stats(low_power_periph_t periph)
+{
+    return &periph_stats[periph];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * File Name: low_power.h
+ *
+ * Description: Deep Sleep entry gated on the actual state of the peripherals
+ * that stop in Deep Sleep: the debug UART transmitter and the MSC scan. A wake-
+ * up with no UART output and no scan in progress goes straight back to Deep
+ * Sleep; otherwise it waits only until the last byte has left the shifter and
+ * the scan has completed. Frames that need the peripheral clocks, such as a
+ * lit PWM LED, sleep in CPU Sleep instead.
+ *
+ * A single Deep Sleep callback prepares every peripheral the application
+ * uses, once per transition, skips the idle ones and times each of them.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Worst-case pre-sleep delay reserved for the UART to drain and the scan to
+ * complete. The Active time saved by gating on the actual state is counted
+ * against this value. */
+#define LOW_POWER_DRAIN_BUDGET_US       (5000UL)
+
+/* Poll period while waiting for the UART or the scan */
+#define LOW_POWER_POLL_US               (10U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* Peripherals prepared by the Deep Sleep callback, in the order they are
+ * prepared for Deep Sleep; they are restored in reverse order */
+typedef enum
+{
+    LOW_POWER_UART,             /* Debug UART: disabled, enabled again when a gesture is queued */
+    LOW_POWER_PWM,              /* LED PWM: not clocked in Deep Sleep, stopped while lit */
+    LOW_POWER_EZI2C,            /* Tuner and telemetry EZI2C: wakes on its address */
+    LOW_POWER_MSC,              /* Both MSC blocks, which scan together: refuse while scanning */
+    LOW_POWER_PERIPH_COUNT
+} low_power_periph_t;
+
+typedef struct
+{
+    CySCB_Type *uart_base;
+    cy_stc_scb_uart_context_t *uart_context;
+    CySCB_Type *ezi2c_base;
+    cy_stc_scb_ezi2c_context_t *ezi2c_context;
+    const cy_stc_capsense_context_t *capsense_context;
+} low_power_config_t;
+
+/* Deep Sleep transitions of one peripheral; times in CPU cycles */
+typedef struct
+{
+    uint32_t prepared;          /* Entries that had work to do for it */
+    uint32_t skipped;           /* Entries that found it idle */
+    uint32_t refused;           /* Entries it refused */
+    uint32_t enter_cycles;      /* Last CHECK_READY and BEFORE_TRANSITION time */
+    uint32_t exit_cycles;       /* Last AFTER_TRANSITION time */
+    uint32_t max_exit_cycles;
+} low_power_periph_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool low_power_init(const low_power_config_t *config);
+void low_power_start(low_power_periph_t periph);
+void low_power_resume(low_power_periph_t periph);
+void low_power_enter_deep_sleep(void);
+void low_power_enter_sleep(const volatile bool *wake);
+uint64_t low_power_get_saved_us(void);
+uint32_t low_power_get_wait_count(void);
+const low_power_periph_stats_t *low_power_get_periph_stats(low_power_periph_t periph);
+
+#endif /* LOW_POWER_H */
+
+/* [] END OF FILE */
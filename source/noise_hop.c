@@ -0,0 +1,433 @@
+/******************************************************************************
+ * File Name: noise_hop.c
+ *
+ * Description: Noise-triggered sense clock hopping of the touchpad. Moving to
+ * another channel changes the sense clock divider of the widget, calibrates its
+ * CDACs for the new clock and reinitializes its baseline, so it is done between
+ * frames while the MSC blocks are idle.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "noise_hop.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* No move pending */
+#define NOISE_HOP_NONE                  (NOISE_HOP_CHANNELS)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/* Divider offset of each channel */
+static const uint16_t channel_offset[NOISE_HOP_CHANNELS] = { 0U, NOISE_HOP_OFFSET_F1, NOISE_HOP_OFFSET_F2 };
+
+/* Configured column and row dividers, channel 0 */
+static uint16_t home_clk = 0U;
+static uint16_t home_row_clk = 0U;
+
+static uint32_t channel = 0U;
+static uint32_t pending = NOISE_HOP_NONE;
+
+/* Noisy and quiet frames in a row on the current channel */
+static uint32_t noisy_run = 0U;
+static uint32_t quiet_run = 0U;
+
+/* Channels left for noise since the last quiet period, NOISE_HOP_CHANNELS
+ * once all of them were found noisy */
+static uint32_t tried = 0U;
+
+/* Doublings of the decay period; the last move was a return, and the frames
+ * checked since the last move */
+static uint32_t backoff = 0U;
+static bool returned = false;
+static uint32_t since_move = 0U;
+
+/* Raw counts of the previous frame */
+static uint16_t prev_raw[CY_CAPSENSE_TOUCHPAD0_NUM_SNS];
+
+/* Frames averaged into the baseline since a move, including the calibration
+ * scan, and their sums */
+static uint32_t settled = NOISE_HOP_SETTLE_FRAMES;
+static uint32_t settle_sum[CY_CAPSENSE_TOUCHPAD0_NUM_SNS];
+
+/* Settled baselines of each channel, kept when the channel is left */
+static uint16_t saved_bsln[NOISE_HOP_CHANNELS][CY_CAPSENSE_TOUCHPAD0_NUM_SNS];
+static bool saved_valid[NOISE_HOP_CHANNELS];
+
+static noise_hop_stats_t stats;
+
+/*******************************************************************************
+ * Function Name: save_raw
+ ********************************************************************************
+ * Summary:
+ *  Keeps the raw counts of the frame for the next check.
+ *
+ *******************************************************************************/
+static void save_raw(const cy_stc_capsense_widget_config_t *wd)
+{
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        prev_raw[i] = wd->ptrSnsContext[i].raw;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: settle_baseline
+ ********************************************************************************
+ * Summary:
+ *  Adds the frame to the baseline average started by a move: the baseline is
+ *  the mean raw count of the frames since the move.
+ *
+ *******************************************************************************/
+static void settle_baseline(const cy_stc_capsense_widget_config_t *wd)
+{
+    settled++;
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        cy_stc_capsense_sensor_context_t *sns = &wd->ptrSnsContext[i];
+
+        settle_sum[i] += sns->raw;
+        sns->bsln = (uint16_t)((settle_sum[i] + (settled / 2U)) / settled);
+        sns->bslnExt = 0U;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: restore_baseline
+ ********************************************************************************
+ * Summary:
+ *  Restores the baseline kept for a channel if the calibration scan agrees
+ *  with it: the mean difference over the sensors must be within the negative
+ *  noise threshold, which also rejects a finger on the touchpad.
+ *
+ * Return:
+ *  true if the baseline was restored
+ *
+ *******************************************************************************/
+static bool restore_baseline(const cy_stc_capsense_widget_config_t *wd, uint32_t target)
+{
+    int32_t offset = 0;
+
+    if (!saved_valid[target])
+    {
+        return false;
+    }
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        offset += (int32_t)wd->ptrSnsContext[i].raw - (int32_t)saved_bsln[target][i];
+    }
+    offset /= (int32_t)wd->numSns;
+    if ((offset > (int32_t)wd->ptrWdContext->nNoiseTh) || (offset < -(int32_t)wd->ptrWdContext->nNoiseTh))
+    {
+        return false;
+    }
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        wd->ptrSnsContext[i].bsln = saved_bsln[target][i];
+        wd->ptrSnsContext[i].bslnExt = 0U;
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: noise_hop_init
+ ********************************************************************************
+ * Summary:
+ *  Starts on the configured sense clock of the touchpad. Call after
+ *  Cy_CapSense_Enable().
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void noise_hop_init(cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_context_t *wdc = context->ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID].ptrWdContext;
+
+    capsense_ctx = context;
+    home_clk = wdc->snsClk;
+    home_row_clk = wdc->rowSnsClk;
+    channel = 0U;
+    pending = NOISE_HOP_NONE;
+    noisy_run = 0U;
+    quiet_run = 0U;
+    tried = 0U;
+    backoff = 0U;
+    returned = false;
+    since_move = 0U;
+    settled = NOISE_HOP_SETTLE_FRAMES;
+    for (uint32_t i = 0U; i < NOISE_HOP_CHANNELS; i++)
+    {
+        saved_valid[i] = false;
+    }
+    save_raw(context->ptrWdConfig + CY_CAPSENSE_TOUCHPAD0_WDGT_ID);
+    stats = (noise_hop_stats_t){ 0 };
+}
+
+/*******************************************************************************
+ * Function Name: noise_hop_check
+ ********************************************************************************
+ * Summary:
+ *  Checks a touchpad frame for noise and decides whether to change channel.
+ *  The move is made by noise_hop_apply() before the next scan starts. Call
+ *  before the raw counts are filtered and processed; sensors outside the
+ *  scanned slots must read their baseline. After a move, the frames are also
+ *  averaged into the new baseline.
+ *
+ * Return:
+ *  true if the frame is noisy
+ *
+ *******************************************************************************/
+bool noise_hop_check(void)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID];
+    const cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+    uint32_t dropped = 0U;
+    uint32_t decay = NOISE_HOP_DECAY_FRAMES << backoff;
+    bool noisy;
+
+    /* The difference counts are still those of the previous frame */
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        const cy_stc_capsense_sensor_context_t *sns = &wd->ptrSnsContext[i];
+
+        if ((sns->diff < wdc->noiseTh) && (sns->raw < prev_raw[i]) &&
+            ((uint32_t)(prev_raw[i] - sns->raw) > wdc->nNoiseTh))
+        {
+            dropped++;
+        }
+    }
+    noisy = (dropped >= NOISE_HOP_MIN_SENSORS);
+    save_raw(wd);
+    if (settled < NOISE_HOP_SETTLE_FRAMES)
+    {
+        settle_baseline(wd);
+    }
+
+    stats.frames++;
+    stats.channel_frames[channel]++;
+    if (since_move < decay)
+    {
+        since_move++;
+    }
+
+    if (noisy)
+    {
+        stats.noisy_frames++;
+        noisy_run++;
+        if ((noisy_run >= NOISE_HOP_DETECT_FRAMES) && (NOISE_HOP_NONE == pending))
+        {
+            if (tried < (NOISE_HOP_CHANNELS - 1U))
+            {
+                /* The noise came back soon after a return: stay away longer */
+                if (returned && (since_move < decay) && (backoff < NOISE_HOP_MAX_BACKOFF))
+                {
+                    backoff++;
+                }
+                pending = (channel + 1U) % NOISE_HOP_CHANNELS;
+                tried++;
+            }
+            else if (tried < NOISE_HOP_CHANNELS)
+            {
+                /* Every channel is noisy: go back to the configured one,
+                 * whose baseline was learned before the noise */
+                tried = NOISE_HOP_CHANNELS;
+                stats.holds++;
+                if (0U != channel)
+                {
+                    pending = 0U;
+                }
+            }
+            else
+            {
+                /* Holding */
+            }
+            noisy_run = 0U;
+        }
+        quiet_run = 0U;
+    }
+    else
+    {
+        noisy_run = 0U;
+        if (quiet_run < decay)
+        {
+            quiet_run++;
+        }
+        if (quiet_run >= decay)
+        {
+            tried = 0U;
+            if (0U == channel)
+            {
+                /* The configured channel has stayed quiet */
+                backoff = 0U;
+                returned = false;
+            }
+            else if (NOISE_HOP_NONE == pending)
+            {
+                pending = 0U;
+            }
+            else
+            {
+                /* Move already pending */
+            }
+        }
+    }
+    return noisy;
+}
+
+/*******************************************************************************
+ * Function Name: noise_hop_apply
+ ********************************************************************************
+ * Summary:
+ *  Moves the touchpad to the channel chosen by noise_hop_check(): sets the
+ *  sense clock dividers and calibrates the CDACs. The settled baseline of the
+ *  channel left is kept; the baseline of the new channel is restored if it
+ *  was kept before, else taken from the calibration scan and refined by the
+ *  next frames. The raw counts of the last frame are replaced. The blocking
+ *  calibration is recorded in the stage profile. Nothing is done while the
+ *  MSC blocks are busy; the move is then retried on the next call.
+ *
+ * Return:
+ *  true if the channel has changed
+ *
+ *******************************************************************************/
+bool noise_hop_apply(void)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[CY_CAPSENSE_TOUCHPAD0_WDGT_ID];
+    cy_stc_capsense_widget_context_t *wdc = wd->ptrWdContext;
+    uint32_t start;
+    uint32_t cal_start;
+    uint32_t target = pending;
+    bool moved = false;
+
+    if ((NOISE_HOP_NONE == target) || (CY_CAPSENSE_NOT_BUSY != Cy_CapSense_IsBusy(capsense_ctx)))
+    {
+        return false;
+    }
+
+    start = stage_profile_now();
+    pending = NOISE_HOP_NONE;
+    if (settled >= NOISE_HOP_SETTLE_FRAMES)
+    {
+        for (uint32_t i = 0U; i < wd->numSns; i++)
+        {
+            saved_bsln[channel][i] = wd->ptrSnsContext[i].bsln;
+        }
+        saved_valid[channel] = true;
+    }
+    wdc->snsClk = (uint16_t)(home_clk + channel_offset[target]);
+    wdc->rowSnsClk = (uint16_t)(home_row_clk + channel_offset[target]);
+    cal_start = stage_profile_now();
+    if (CY_CAPSENSE_STATUS_SUCCESS != Cy_CapSense_CalibrateWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, capsense_ctx))
+    {
+        /* Stay on the current channel */
+        stats.failures++;
+        wdc->snsClk = (uint16_t)(home_clk + channel_offset[channel]);
+        wdc->rowSnsClk = (uint16_t)(home_row_clk + channel_offset[channel]);
+        (void)Cy_CapSense_CalibrateWidget(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, capsense_ctx);
+        target = channel;
+    }
+    stage_profile_since(STAGE_PROFILE_CLOCK_CAL, cal_start);
+    save_raw(wd);
+    if (restore_baseline(wd, target))
+    {
+        settled = NOISE_HOP_SETTLE_FRAMES;
+    }
+    else
+    {
+        Cy_CapSense_InitializeWidgetBaseline(CY_CAPSENSE_TOUCHPAD0_WDGT_ID, capsense_ctx);
+        settled = 1U;
+        for (uint32_t i = 0U; i < wd->numSns; i++)
+        {
+            settle_sum[i] = prev_raw[i];
+        }
+    }
+
+    if (target != channel)
+    {
+        returned = (0U == target);
+        if (returned)
+        {
+            stats.returns++;
+        }
+        else
+        {
+            stats.hops++;
+        }
+        channel = target;
+        moved = true;
+    }
+    noisy_run = 0U;
+    quiet_run = 0U;
+    since_move = 0U;
+
+    stats.last_cycles = stage_profile_elapsed(start);
+    if (stats.last_cycles > stats.max_cycles)
+    {
+        stats.max_cycles = stats.last_cycles;
+    }
+    return moved;
+}
+
+/*******************************************************************************
+ * Function Name: noise_hop_get_channel
+ ********************************************************************************
+ * Summary:
+ *  Returns the channel of the touchpad, 0 for the configured sense clock.
+ *
+ *******************************************************************************/
+uint32_t noise_hop_get_channel(void)
+{
+    return channel;
+}
+
+/*******************************************************************************
+ * Function Name: noise_hop_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the noise and hopping counters.
+ *
+ *******************************************************************************/
+const noise_hop_stats_t *noise_hop_get_stats(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * File Name: noise_hop.h
+ *
+ * Description: Noise-triggered sense clock hopping of the touchpad. The
+ * touchpad is scanned at a single sense clock frequency. While conducted noise
+ * is detected in its raw counts, the touchpad moves to one of the alternate
+ * frequencies of multi-frequency scanning, and it returns to the configured
+ * frequency once the noise has stopped.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef NOISE_HOP_H
+#define NOISE_HOP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* 1 - hop to an alternate sense clock while noise is detected, 0 - always
+ * scan at the configured sense clock */
+#ifndef NOISE_HOP_ENABLED
+#define NOISE_HOP_ENABLED               (1)
+#endif
+
+/* Sense clock channels: the configured divider and the two alternates */
+#define NOISE_HOP_CHANNELS              (3U)
+
+/* Divider offsets of the alternate channels, as CSD_MFS_DIVIDER_OFFSET_F1
+ * and CSD_MFS_DIVIDER_OFFSET_F2 of the CAPSENSE configuration */
+#define NOISE_HOP_OFFSET_F1             (4U)
+#define NOISE_HOP_OFFSET_F2             (8U)
+
+/* A frame is noisy when at least this many sensors that were quiet on the
+ * previous frame have dropped by more than the negative noise threshold. A
+ * finger only raises the raw counts of quiet sensors, conducted noise moves
+ * them both ways. */
+#define NOISE_HOP_MIN_SENSORS           (3U)
+
+/* Noisy frames in a row before hopping */
+#define NOISE_HOP_DETECT_FRAMES         (2U)
+
+/* Quiet frames on an alternate channel before returning to the configured
+ * one; doubled, up to NOISE_HOP_MAX_BACKOFF times, while the noise is still
+ * there on return */
+#define NOISE_HOP_DECAY_FRAMES          (200U)
+#define NOISE_HOP_MAX_BACKOFF           (4U)
+
+/* Frames averaged into the baseline after a move. The calibration scan may
+ * be noisy, so the baseline is not taken from it alone. */
+#define NOISE_HOP_SETTLE_FRAMES         (16U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t frames;                        /* Touchpad frames checked */
+    uint32_t noisy_frames;                  /* Frames found noisy */
+    uint32_t channel_frames[NOISE_HOP_CHANNELS]; /* Frames checked on each channel */
+    uint32_t hops;                          /* Moves to an alternate channel */
+    uint32_t returns;                       /* Moves back to the configured channel */
+    uint32_t holds;                         /* Every channel was found noisy; no
+                                             * more moves until a quiet period */
+    uint32_t failures;                      /* Calibrations that failed */
+    uint32_t last_cycles;                   /* CPU cycles of the last move */
+    uint32_t max_cycles;                    /* Longest move, in CPU cycles */
+} noise_hop_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void noise_hop_init(cy_stc_capsense_context_t *context);
+bool noise_hop_check(void);
+bool noise_hop_apply(void);
+uint32_t noise_hop_get_channel(void);
+const noise_hop_stats_t *noise_hop_get_stats(void);
+
+#endif /* NOISE_HOP_H */
+
+/* [] END OF FILE */
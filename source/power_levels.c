@@ -0,0 +1,62 @@
+/******************************************************************************
+ * File Name: power_levels.c
+ *
+ * Description: Power levels of the application. The touchpad is scanned at the
+ * gesture rate while in use and at half that rate shortly after, then only the
+ * proximity sensor is scanned, less often the longer the device stays unused.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "power_levels.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Any proximity or touch activity returns to POWER_LEVEL_ACTIVE. The active
+ * interval matches the 10 ms gesture timestamp tick the gesture thresholds are
+ * tuned for. While liquid is present the touchpad levels scan twice as often,
+ * so that the filtered wet sensors keep their response time; the proximity
+ * levels gain nothing from it. */
+const power_level_config_t power_levels[POWER_LEVEL_COUNT] =
+{
+    [POWER_LEVEL_ACTIVE]    = {  10000U, CY_CAPSENSE_TOUCHPAD0_WDGT_ID,    300U, POWER_LEVEL_FAST_IDLE,  5000U },
+    [POWER_LEVEL_FAST_IDLE] = {  20000U, CY_CAPSENSE_TOUCHPAD0_WDGT_ID,    700U, POWER_LEVEL_PROX_IDLE, 10000U },
+    [POWER_LEVEL_PROX_IDLE] = { 100000U, CY_CAPSENSE_PROXIMITY0_WDGT_ID, 60000U, POWER_LEVEL_DEEP_IDLE,     0U },
+    [POWER_LEVEL_DEEP_IDLE] = { 500000U, CY_CAPSENSE_PROXIMITY0_WDGT_ID,     0U, POWER_LEVEL_DEEP_IDLE,     0U },
+};
+
+/* [] END OF FILE */
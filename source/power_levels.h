@@ -0,0 +1,67 @@
+/******************************************************************************
+ * File Name: power_levels.h
+ *
+ * Description: Power levels of the application: wake-up interval, scanned
+ * widget and dwell time of each level of the power state machine. Shared with
+ * the host power policy comparison tool.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef POWER_LEVELS_H
+#define POWER_LEVELS_H
+
+#include "power_policy.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+enum
+{
+    POWER_LEVEL_ACTIVE,         /* Touchpad in use */
+    POWER_LEVEL_FAST_IDLE,      /* Touchpad recently used */
+    POWER_LEVEL_PROX_IDLE,      /* Waiting for a hand */
+    POWER_LEVEL_DEEP_IDLE,      /* Unused for a long time */
+    POWER_LEVEL_COUNT
+};
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+extern const power_level_config_t power_levels[POWER_LEVEL_COUNT];
+
+#endif /* POWER_LEVELS_H */
+
+/* [] END OF FILE */
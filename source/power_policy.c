@@ -0,0 +1,233 @@
+/******************************************************************************
+ * File Name: power_policy.c
+ *
+ * Description: Power state machine. Dwell times are measured in device time,
+ * the sum of the wake-up intervals the caller reports, so a level lasts as long
+ * regardless of its frame rate. The module does not touch any peripheral and
+ * builds unchanged on the host.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include <stddef.h>
+#include "power_policy.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static const power_level_config_t *level_table = NULL;
+static uint32_t level_count = 0U;
+static uint32_t level = 0U;
+static power_policy_hook_fn transition_hook = NULL;
+
+/* Device time since the last activity or level change */
+static uint32_t idle_us = 0U;
+
+static uint32_t transitions = 0U;
+
+/* Liquid is present, the wet intervals apply */
+static bool wet_panel = false;
+
+/*******************************************************************************
+ * Function Name: enter_level
+ ********************************************************************************
+ * Summary:
+ *  Switches to another level and reports the transition.
+ *
+ *******************************************************************************/
+static void enter_level(uint32_t next)
+{
+    uint32_t prev = level;
+
+    idle_us = 0U;
+    if (next == prev)
+    {
+        return;
+    }
+
+    level = next;
+    transitions++;
+    if (NULL != transition_hook)
+    {
+        transition_hook(prev, next);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_init
+ ********************************************************************************
+ * Summary:
+ *  Loads a level table. The table must stay valid while in use.
+ *
+ * Parameters:
+ *  levels: level table, level 0 is entered on activity
+ *  num_levels: number of levels
+ *  initial_level: level to start in
+ *  hook: called on every level change, may be NULL
+ *
+ * Return:
+ *  false if the table is invalid; the previous table is kept
+ *
+ *******************************************************************************/
+bool power_policy_init(const power_level_config_t *levels, uint32_t num_levels, uint32_t initial_level,
+                       power_policy_hook_fn hook)
+{
+    if ((NULL == levels) || (0U == num_levels) || (num_levels > POWER_POLICY_MAX_LEVELS) ||
+        (initial_level >= num_levels))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0U; i < num_levels; i++)
+    {
+        if ((0U == levels[i].interval_us) || (levels[i].interval_us > POWER_POLICY_MAX_INTERVAL_US) ||
+            (levels[i].wet_interval_us > POWER_POLICY_MAX_INTERVAL_US) || (levels[i].idle_level >= num_levels))
+        {
+            return false;
+        }
+    }
+
+    level_table = levels;
+    level_count = num_levels;
+    level = initial_level;
+    transition_hook = hook;
+    idle_us = 0U;
+    transitions = 0U;
+    wet_panel = false;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_update
+ ********************************************************************************
+ * Summary:
+ *  Advances the state machine by one frame.
+ *
+ * Parameters:
+ *  elapsed_us: device time since the previous update, normally the wake-up
+ *              interval that just expired
+ *  events: POWER_POLICY_EVENT_* seen in this frame
+ *
+ *******************************************************************************/
+void power_policy_update(uint32_t elapsed_us, uint32_t events)
+{
+    const power_level_config_t *cfg;
+
+    if (NULL == level_table)
+    {
+        return;
+    }
+
+    if (POWER_POLICY_EVENT_NONE != events)
+    {
+        enter_level(0U);
+        return;
+    }
+
+    cfg = &level_table[level];
+    idle_us = ((UINT32_MAX - idle_us) > elapsed_us) ? (idle_us + elapsed_us) : UINT32_MAX;
+    if ((0U != cfg->dwell_ms) && (idle_us >= (cfg->dwell_ms * 1000UL)))
+    {
+        enter_level(cfg->idle_level);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_get_level
+ ********************************************************************************
+ * Summary:
+ *  Returns the current level.
+ *
+ *******************************************************************************/
+uint32_t power_policy_get_level(void)
+{
+    return level;
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_get_config
+ ********************************************************************************
+ * Summary:
+ *  Returns the configuration of the current level.
+ *
+ *******************************************************************************/
+const power_level_config_t *power_policy_get_config(void)
+{
+    return &level_table[level];
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_set_wet
+ ********************************************************************************
+ * Summary:
+ *  Selects the wet or the dry wake-up intervals. Does not change the level.
+ *
+ * Parameters:
+ *  wet: liquid is present on the panel
+ *
+ *******************************************************************************/
+void power_policy_set_wet(bool wet)
+{
+    wet_panel = wet;
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_get_interval_us
+ ********************************************************************************
+ * Summary:
+ *  Returns the wake-up interval of the current level for the current panel
+ *  condition.
+ *
+ *******************************************************************************/
+uint32_t power_policy_get_interval_us(void)
+{
+    const power_level_config_t *cfg = &level_table[level];
+
+    return (wet_panel && (0U != cfg->wet_interval_us)) ? cfg->wet_interval_us : cfg->interval_us;
+}
+
+/*******************************************************************************
+ * Function Name: power_policy_get_transitions
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of level changes since initialization.
+ *
+ *******************************************************************************/
+uint32_t power_policy_get_transitions(void)
+{
+    return transitions;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * File Name: power_policy.h
+ *
+ * Description: Power state machine. The device runs in one of a small number of
+ * power levels, each with its own wake-up interval and scanned widget. Activity
+ * moves the device to the most responsive level; a level is left for its idle
+ * level once no activity has been seen for its dwell time.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef POWER_POLICY_H
+#define POWER_POLICY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define POWER_POLICY_MAX_LEVELS         (8U)
+
+/* The WDT match is 16 bits wide: 65535 counts of a fast ILO (80 kHz) */
+#define POWER_POLICY_MAX_INTERVAL_US    (800000UL)
+
+/* Activity reported by the application for one frame */
+#define POWER_POLICY_EVENT_NONE         (0x0U)
+#define POWER_POLICY_EVENT_PROXIMITY    (0x1U)
+#define POWER_POLICY_EVENT_TOUCH        (0x2U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t interval_us;       /* WDT wake-up interval */
+    uint32_t scan_widget;       /* Widget scanned on every wake-up */
+    uint32_t dwell_ms;          /* Time without activity before idle_level is entered, 0 - never */
+    uint8_t idle_level;         /* Level entered once the dwell time has expired */
+    uint32_t wet_interval_us;   /* Wake-up interval while liquid is present, 0 - interval_us */
+} power_level_config_t;
+
+/* Called on every level change, after the new level has taken effect */
+typedef void (*power_policy_hook_fn)(uint32_t from_level, uint32_t to_level);
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+/* Level 0 is the most responsive level and is entered on any activity */
+bool power_policy_init(const power_level_config_t *levels, uint32_t num_levels, uint32_t initial_level,
+                       power_policy_hook_fn hook);
+void power_policy_update(uint32_t elapsed_us, uint32_t events);
+uint32_t power_policy_get_level(void);
+const power_level_config_t *power_policy_get_config(void);
+void power_policy_set_wet(bool wet);
+uint32_t power_policy_get_interval_us(void);
+uint32_t power_policy_get_transitions(void);
+
+#endif /* POWER_POLICY_H */
+
+/* [] END OF FILE */
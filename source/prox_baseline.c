@@ -0,0 +1,194 @@
+/******************************************************************************
+ * File Name: prox_baseline.c
+ *
+ * Description: Baseline lifecycle of the proximity widget. Processing time is
+ * measured with SysTick, which runs from the CPU clock and therefore only
+ * counts while the CPU is awake.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "prox_baseline.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define PROX_BASELINE_WDGT_ID       (CY_CAPSENSE_PROXIMITY0_WDGT_ID)
+#define PROX_BASELINE_SNS_ID        (CY_CAPSENSE_PROXIMITY0_SNS0_ID)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/* Baseline is not updated while the touchpad is active */
+static bool frozen = false;
+
+/* Baseline is reinitialized from the next processed frame */
+static bool reinit_pending = false;
+
+static prox_baseline_stats_t stats;
+
+/*******************************************************************************
+ * Function Name: prox_baseline_init
+ ********************************************************************************
+ * Summary:
+ *  Starts tracking the proximity baseline set up by Cy_CapSense_Enable(). The
+ *  SysTick cycle counter is started if it is not running yet.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void prox_baseline_init(cy_stc_capsense_context_t *context)
+{
+    capsense_ctx = context;
+    frozen = false;
+    reinit_pending = false;
+    stats = (prox_baseline_stats_t){ 0 };
+
+    /* Left running if already started, so that the boot phase timed across
+     * this call stays valid */
+    stage_profile_start();
+}
+
+/*******************************************************************************
+ * Function Name: prox_baseline_process
+ ********************************************************************************
+ * Summary:
+ *  Processes a completed proximity frame. While frozen the frame is discarded,
+ *  so that a hand over the touchpad does not end up in the baseline.
+ *
+ * Return:
+ *  true if the proximity sensor is active
+ *
+ *******************************************************************************/
+bool prox_baseline_process(void)
+{
+    uint32_t start;
+    uint32_t cycles;
+    bool active;
+
+    if (frozen)
+    {
+        stats.skipped++;
+        return false;
+    }
+
+    start = stage_profile_now();
+
+    (void)Cy_CapSense_ProcessWidget(PROX_BASELINE_WDGT_ID, capsense_ctx);
+
+    if (reinit_pending)
+    {
+        const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[PROX_BASELINE_WDGT_ID];
+
+        /* First frame scanned after the active period. A hand still over the
+         * sensor shows against the frozen baseline; keep that baseline until
+         * the hand has gone so it is not learned as the new idle level. */
+        if (wd->ptrSnsContext[0].diff < wd->ptrWdContext->proxTh)
+        {
+            Cy_CapSense_InitializeWidgetBaseline(PROX_BASELINE_WDGT_ID, capsense_ctx);
+            reinit_pending = false;
+            stats.reinits++;
+        }
+    }
+
+    active = (0U != Cy_CapSense_IsProximitySensorActive(PROX_BASELINE_WDGT_ID, PROX_BASELINE_SNS_ID, capsense_ctx));
+
+    cycles = stage_profile_elapsed(start);
+    stats.frames++;
+    stats.last_cycles = cycles;
+    stats.total_cycles += cycles;
+    if (cycles > stats.max_cycles)
+    {
+        stats.max_cycles = cycles;
+    }
+    return active;
+}
+
+/*******************************************************************************
+ * Function Name: prox_baseline_freeze
+ ********************************************************************************
+ * Summary:
+ *  Stops baseline tracking when the device switches to the touchpad.
+ *
+ *******************************************************************************/
+void prox_baseline_freeze(void)
+{
+    frozen = true;
+}
+
+/*******************************************************************************
+ * Function Name: prox_baseline_resume
+ ********************************************************************************
+ * Summary:
+ *  Resumes baseline tracking on the return to the proximity-only state. The
+ *  raw counts in the sensor context date from before the active period, so
+ *  the baseline is reinitialized from the next scanned frame instead.
+ *
+ *******************************************************************************/
+void prox_baseline_resume(void)
+{
+    frozen = false;
+    reinit_pending = true;
+}
+
+/*******************************************************************************
+ * Function Name: prox_baseline_is_frozen
+ ********************************************************************************
+ * Summary:
+ *  Returns true while proximity frames are discarded.
+ *
+ *******************************************************************************/
+bool prox_baseline_is_frozen(void)
+{
+    return frozen;
+}
+
+/*******************************************************************************
+ * Function Name: prox_baseline_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the frame and timing counters.
+ *
+ *******************************************************************************/
+const prox_baseline_stats_t *prox_baseline_get_stats(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * File Name: prox_baseline.h
+ *
+ * Description: Baseline lifecycle of the proximity widget. The proximity
+ * baseline tracks drift and liquid only while the proximity sensor is the
+ * sensor in use; it is frozen while the touchpad is active and reinitialized
+ * from the first fresh proximity frame after returning to the proximity-only
+ * state.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef PROX_BASELINE_H
+#define PROX_BASELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t frames;            /* Proximity frames processed */
+    uint32_t skipped;           /* Proximity frames discarded while frozen */
+    uint32_t reinits;           /* Baseline reinitializations */
+    uint32_t last_cycles;       /* CPU cycles spent on the last processed frame */
+    uint32_t max_cycles;        /* Longest frame, in CPU cycles */
+    uint64_t total_cycles;      /* All processed frames, in CPU cycles */
+} prox_baseline_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void prox_baseline_init(cy_stc_capsense_context_t *context);
+bool prox_baseline_process(void);
+void prox_baseline_freeze(void);
+void prox_baseline_resume(void);
+bool prox_baseline_is_frozen(void);
+const prox_baseline_stats_t *prox_baseline_get_stats(void);
+
+#endif /* PROX_BASELINE_H */
+
+/* [] END OF FILE */
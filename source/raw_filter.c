@@ -0,0 +1,305 @@
+/******************************************************************************
+ * File Name: raw_filter.c
+ *
+ * Description: Raw count filters of the touchpad. Each stage works on two raw
+ * counts per 32-bit word: the lanes are kept below 2^14, so bit 15 of each lane
+ * is free as a guard for comparisons and sums never carry into the next lane.
+ * The Cortex-M0+ has no SIMD instructions; plain 32-bit logic and arithmetic
+ * does the work of two 16-bit operations.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "raw_filter.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define RAW_FILTER_WDGT_ID          (CY_CAPSENSE_TOUCHPAD0_WDGT_ID)
+
+/* A constant in both lanes */
+#define LANES(x)                    ((uint32_t)(x) * 0x00010001UL)
+
+/* Bit 15 of both lanes */
+#define LANE_GUARD                  LANES(0x8000U)
+
+#define IIR_MASK                    LANES(0xFFFFU >> RAW_FILTER_IIR_SHIFT)
+#define IIR_HALF                    LANES(1U << (RAW_FILTER_IIR_SHIFT - 1U))
+
+#define SPATIAL_MASK                LANES(0x3FFFU)
+#define SPATIAL_HALF                LANES(2U)
+
+/* Columns and rows each fill whole words */
+_Static_assert(0U == (RAW_FILTER_NUM_COLS % 2U), "Columns must fill whole packed words");
+_Static_assert(0U == (RAW_FILTER_NUM_ROWS % 2U), "Rows must fill whole packed words");
+_Static_assert(RAW_FILTER_IIR_SHIFT >= 2U, "Spatial sums need raw counts below 2^14");
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+static bool enabled = false;
+static raw_filter_state_t state;
+static raw_filter_stats_t stats;
+
+/*******************************************************************************
+ * Function Name: lanes_ge
+ ********************************************************************************
+ * Summary:
+ *  Returns 0xFFFF in each lane where a >= b, 0 elsewhere. Lanes must be below
+ *  0x8000.
+ *
+ *******************************************************************************/
+static inline uint32_t lanes_ge(uint32_t a, uint32_t b)
+{
+    uint32_t t = ((a | LANE_GUARD) - b) & LANE_GUARD;
+
+    return t | (t - (t >> 15U));
+}
+
+/*******************************************************************************
+ * Function Name: median3
+ ********************************************************************************
+ * Summary:
+ *  Returns the lane-wise median of three packed words.
+ *
+ *******************************************************************************/
+static inline uint32_t median3(uint32_t a, uint32_t b, uint32_t c)
+{
+    uint32_t swap = (a ^ b) & lanes_ge(a, b);
+    uint32_t low = a ^ swap;
+    uint32_t high = b ^ swap;
+
+    /* min(high, c), then max(low, that) */
+    high ^= (high ^ c) & lanes_ge(high, c);
+    return high ^ ((low ^ high) & lanes_ge(low, high));
+}
+
+/*******************************************************************************
+ * Function Name: spatial_axis
+ ********************************************************************************
+ * Summary:
+ *  Smooths one axis of the touchpad with [1 2 1] / 4, repeating the edge
+ *  sensors. The neighbours of both lanes are built by shifting the halves of
+ *  the adjacent words in.
+ *
+ * Parameters:
+ *  frame: first packed word of the axis
+ *  num_words: words of the axis
+ *
+ *******************************************************************************/
+static void spatial_axis(uint32_t *frame, uint32_t num_words)
+{
+    uint32_t prev_high = frame[0] & 0xFFFFU;
+
+    for (uint32_t w = 0U; w < num_words; w++)
+    {
+        uint32_t center = frame[w];
+        uint32_t next_low = ((w + 1U) < num_words) ? (frame[w + 1U] & 0xFFFFU) : (center >> 16U);
+        uint32_t left = (center << 16U) | prev_high;
+        uint32_t right = (center >> 16U) | (next_low << 16U);
+
+        prev_high = center >> 16U;
+        frame[w] = ((left + (center << 1U) + right + SPATIAL_HALF) >> 2U) & SPATIAL_MASK;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_filter_init
+ ********************************************************************************
+ * Summary:
+ *  Starts with no filter state. The filters are never applied if the raw
+ *  counts of the touchpad can exceed RAW_FILTER_MAX_RAW.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ * Return:
+ *  true if the filters can be applied to the touchpad
+ *
+ *******************************************************************************/
+bool raw_filter_init(cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_context_t *wdc = context->ptrWdConfig[RAW_FILTER_WDGT_ID].ptrWdContext;
+
+    capsense_ctx = context;
+    state.oldest = 0U;
+    state.seeded = 0U;
+    stats = (raw_filter_stats_t){ 0 };
+    enabled = (wdc->maxRawCount <= RAW_FILTER_MAX_RAW) && (wdc->maxRawCountRow <= RAW_FILTER_MAX_RAW);
+    return enabled;
+}
+
+/*******************************************************************************
+ * Function Name: raw_filter_run
+ ********************************************************************************
+ * Summary:
+ *  Filters a packed touchpad frame in place. A stage that was not used on the
+ *  previous frame starts from this frame: the median passes it through and
+ *  the IIR output equals it.
+ *
+ * Parameters:
+ *  state: filter state, kept between frames
+ *  frame: RAW_FILTER_WORDS packed raw counts, each below RAW_FILTER_MAX_RAW
+ *  stages: RAW_FILTER_* stages to apply
+ *
+ *******************************************************************************/
+void raw_filter_run(raw_filter_state_t *state, uint32_t *frame, uint32_t stages)
+{
+    uint32_t seed = stages & ~state->seeded;
+
+    state->seeded = stages;
+
+    if (0U != (stages & RAW_FILTER_MEDIAN))
+    {
+        uint32_t *oldest = state->history[state->oldest];
+        uint32_t *newest = state->history[state->oldest ^ 1U];
+
+        if (0U != (seed & RAW_FILTER_MEDIAN))
+        {
+            for (uint32_t w = 0U; w < RAW_FILTER_WORDS; w++)
+            {
+                oldest[w] = frame[w];
+                newest[w] = frame[w];
+            }
+        }
+        for (uint32_t w = 0U; w < RAW_FILTER_WORDS; w++)
+        {
+            uint32_t raw = frame[w];
+
+            frame[w] = median3(raw, newest[w], oldest[w]);
+            oldest[w] = raw;
+        }
+        state->oldest ^= 1U;
+    }
+
+    if (0U != (stages & RAW_FILTER_IIR))
+    {
+        if (0U != (seed & RAW_FILTER_IIR))
+        {
+            for (uint32_t w = 0U; w < RAW_FILTER_WORDS; w++)
+            {
+                state->iir[w] = frame[w] << RAW_FILTER_IIR_SHIFT;
+            }
+        }
+        for (uint32_t w = 0U; w < RAW_FILTER_WORDS; w++)
+        {
+            /* old - old / 2^SHIFT + raw is the new value times 2^SHIFT; it
+             * stays within the lane as all terms are non-negative */
+            uint32_t iir = state->iir[w];
+
+            iir = (iir - ((iir >> RAW_FILTER_IIR_SHIFT) & IIR_MASK)) + frame[w];
+            state->iir[w] = iir;
+            frame[w] = ((iir + IIR_HALF) >> RAW_FILTER_IIR_SHIFT) & IIR_MASK;
+        }
+    }
+
+    if (0U != (stages & RAW_FILTER_SPATIAL))
+    {
+        spatial_axis(&frame[0], RAW_FILTER_NUM_COLS / 2U);
+        spatial_axis(&frame[RAW_FILTER_NUM_COLS / 2U], RAW_FILTER_NUM_ROWS / 2U);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_filter_apply
+ ********************************************************************************
+ * Summary:
+ *  Filters the raw counts of a completed touchpad frame. Call before
+ *  Cy_CapSense_ProcessWidget(); with no stages, the stage state is dropped
+ *  and the call costs nothing.
+ *
+ * Parameters:
+ *  stages: RAW_FILTER_* stages to apply
+ *
+ *******************************************************************************/
+void raw_filter_apply(uint32_t stages)
+{
+    cy_stc_capsense_sensor_context_t *sns;
+    uint32_t frame[RAW_FILTER_WORDS];
+
+    if ((!enabled) || (0U == stages))
+    {
+        state.seeded = 0U;
+        return;
+    }
+
+    sns = capsense_ctx->ptrWdConfig[RAW_FILTER_WDGT_ID].ptrSnsContext;
+    for (uint32_t w = 0U; w < RAW_FILTER_WORDS; w++)
+    {
+        frame[w] = (uint32_t)sns[2U * w].raw | ((uint32_t)sns[(2U * w) + 1U].raw << 16U);
+    }
+
+    if (0U != (stages & ~state.seeded))
+    {
+        stats.seeds++;
+    }
+    raw_filter_run(&state, frame, stages);
+    stats.frames++;
+
+    for (uint32_t w = 0U; w < RAW_FILTER_WORDS; w++)
+    {
+        sns[2U * w].raw = (uint16_t)frame[w];
+        sns[(2U * w) + 1U].raw = (uint16_t)(frame[w] >> 16U);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: raw_filter_reset
+ ********************************************************************************
+ * Summary:
+ *  Drops the stage state, so that the next frame seeds every stage. Call when
+ *  the raw counts change scale, such as after a sense clock move; the median
+ *  history would otherwise mix frames of both clocks.
+ *
+ *******************************************************************************/
+void raw_filter_reset(void)
+{
+    state.seeded = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: raw_filter_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the filter counters.
+ *
+ *******************************************************************************/
+const raw_filter_stats_t *raw_filter_get_stats(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
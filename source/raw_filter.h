@@ -0,0 +1,108 @@
+/******************************************************************************
+ * File Name: raw_filter.h
+ *
+ * Description: Raw count filters of the touchpad, applied by the application
+ * between the scan and Cy_CapSense_ProcessWidget(). The whole frame is kept as
+ * packed pairs of 16-bit raw counts, so each 32-bit operation filters two
+ * sensors.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef RAW_FILTER_H
+#define RAW_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Filter stages, applied in this order */
+#define RAW_FILTER_MEDIAN               (0x01U) /* Median of the last three frames */
+#define RAW_FILTER_IIR                  (0x02U) /* new = old + (raw - old) / 2^RAW_FILTER_IIR_SHIFT */
+#define RAW_FILTER_SPATIAL              (0x04U) /* [1 2 1] / 4 along the columns and along the rows */
+#define RAW_FILTER_ALL                  (RAW_FILTER_MEDIAN | RAW_FILTER_IIR | RAW_FILTER_SPATIAL)
+
+/* Stages used while the panel is dry and while it is wet. The wet sensors
+ * already get their own IIR filter in liquid_detect.c, and the spatial
+ * filter lowers the finger peak enough to lose scrolls on a wet panel; the
+ * median removes single-frame spikes without either cost. */
+#define RAW_FILTER_DRY_STAGES           (0U)
+#define RAW_FILTER_WET_STAGES           (RAW_FILTER_MEDIAN)
+
+/* The IIR state keeps RAW_FILTER_IIR_SHIFT fractional bits in 16 bits, and
+ * four raw counts of the spatial kernel must add up within 16 bits */
+#define RAW_FILTER_IIR_SHIFT            (2U)
+#define RAW_FILTER_MAX_RAW              (0xFFFFU >> RAW_FILTER_IIR_SHIFT)
+
+#define RAW_FILTER_NUM_COLS             (CY_CAPSENSE_TOUCHPAD0_NUM_COLS)
+#define RAW_FILTER_NUM_ROWS             (CY_CAPSENSE_TOUCHPAD0_NUM_ROWS)
+#define RAW_FILTER_NUM_SNS              (CY_CAPSENSE_TOUCHPAD0_NUM_SNS)
+
+/* Packed frame: raw count of sensor 2N in the low half of word N, sensor
+ * 2N + 1 in the high half. Columns come first, then rows. */
+#define RAW_FILTER_WORDS                ((RAW_FILTER_NUM_SNS + 1U) / 2U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t iir[RAW_FILTER_WORDS];         /* Packed IIR state, Q(RAW_FILTER_IIR_SHIFT) */
+    uint32_t history[2][RAW_FILTER_WORDS];  /* Unfiltered previous two frames */
+    uint32_t oldest;                        /* History entry to replace next */
+    uint32_t seeded;                        /* Stages whose state holds a frame */
+} raw_filter_state_t;
+
+typedef struct
+{
+    uint32_t frames;            /* Touchpad frames filtered */
+    uint32_t seeds;             /* Stages restarted from the current frame */
+} raw_filter_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool raw_filter_init(cy_stc_capsense_context_t *context);
+void raw_filter_apply(uint32_t stages);
+void raw_filter_reset(void);
+void raw_filter_run(raw_filter_state_t *state, uint32_t *frame, uint32_t stages);
+const raw_filter_stats_t *raw_filter_get_stats(void);
+
+#endif /* RAW_FILTER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,347 @@
+/******************************************************************************
+ * File Name: scan_pipeline.c
+ *
+ * Description: Interrupt-driven frame scanning. The main loop starts the scan
+ * of a frame, waits for it in CPU Sleep and processes it in the same wake-up.
+ * A frame may span several runs of slots; each run is started from the MSC
+ * interrupt when the previous one completes. Scanning does not overlap
+ * processing: the middleware processes the raw counts in place in the sensor
+ * contexts, and the DMA writes each slot there as soon as it is converted. A
+ * frame that is never taken is counted as an overrun.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "scan_pipeline.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/* Widget being scanned, written by the main loop on start and by the MSC
+ * interrupt on completion */
+static volatile uint32_t inflight_widget = SCAN_PIPELINE_NONE;
+
+/* Widget of the last completed frame, not yet taken by the main loop */
+static volatile uint32_t completed_widget = SCAN_PIPELINE_NONE;
+
+/* Slots of the in-flight frame, relative to the first slot of its widget:
+ * all of them, and those not started yet */
+static volatile uint32_t inflight_slots = 0U;
+static volatile uint32_t pending_slots = 0U;
+
+/* Slots of the last completed frame and of the frame being processed */
+static volatile uint32_t completed_slots = 0U;
+static uint32_t processing_slots = 0U;
+
+/* Frames whose raw counts were replaced before being taken */
+static volatile uint32_t overruns = 0U;
+
+/*******************************************************************************
+ * Function Name: start_next_range
+ ********************************************************************************
+ * Summary:
+ *  Starts the scan of the lowest run of consecutive pending slots.
+ *
+ * Return:
+ *  Status of Cy_CapSense_ScanSlots()
+ *
+ *******************************************************************************/
+static cy_capsense_status_t start_next_range(void)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[inflight_widget];
+    uint32_t pending = pending_slots;
+    uint32_t first = 0U;
+    uint32_t count = 0U;
+
+    while (0U == (pending & (1UL << first)))
+    {
+        first++;
+    }
+    while (((first + count) < SCAN_PIPELINE_MAX_SLOTS) && (0U != (pending & (1UL << (first + count)))))
+    {
+        count++;
+    }
+
+    pending_slots = (count < SCAN_PIPELINE_MAX_SLOTS) ? (pending & ~(((1UL << count) - 1U) << first)) : 0U;
+    return Cy_CapSense_ScanSlots(wd->firstSlotId + first, count, capsense_ctx);
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_init
+ ********************************************************************************
+ * Summary:
+ *  Sets the CAPSENSE context driven by the pipeline. The MSC interrupt
+ *  handlers call scan_pipeline_isr() after Cy_CapSense_InterruptHandler().
+ *
+ *******************************************************************************/
+void scan_pipeline_init(cy_stc_capsense_context_t *context)
+{
+    capsense_ctx = context;
+    inflight_widget = SCAN_PIPELINE_NONE;
+    completed_widget = SCAN_PIPELINE_NONE;
+    inflight_slots = 0U;
+    pending_slots = 0U;
+    completed_slots = 0U;
+    processing_slots = 0U;
+    overruns = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_start
+ ********************************************************************************
+ * Summary:
+ *  Starts the scan of all slots of a widget.
+ *
+ * Parameters:
+ *  widget_id: widget to scan
+ *
+ * Return:
+ *  Status of Cy_CapSense_ScanSlots()
+ *
+ *******************************************************************************/
+cy_capsense_status_t scan_pipeline_start(uint32_t widget_id)
+{
+    return scan_pipeline_start_slots(widget_id, SCAN_PIPELINE_ALL_SLOTS);
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_start_slots
+ ********************************************************************************
+ * Summary:
+ *  Starts the scan of a subset of the slots of a widget. Every run of
+ *  consecutive slots is one Cy_CapSense_ScanSlots() call; the next run is
+ *  started from the MSC interrupt when the previous one completes, and the
+ *  frame completes with the last run. Start a frame only once the previous
+ *  one has been processed: the scan writes the raw counts in place.
+ *
+ * Parameters:
+ *  widget_id: widget to scan
+ *  slots: bit N selects slot N of the widget; slots beyond the widget are
+ *         ignored
+ *
+ * Return:
+ *  Status of Cy_CapSense_ScanSlots() for the first run
+ *
+ *******************************************************************************/
+cy_capsense_status_t scan_pipeline_start_slots(uint32_t widget_id, uint32_t slots)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[widget_id];
+    cy_capsense_status_t status;
+
+    if (SCAN_PIPELINE_NONE != inflight_widget)
+    {
+        return CY_CAPSENSE_STATUS_HW_BUSY;
+    }
+
+    if (wd->numSlots < SCAN_PIPELINE_MAX_SLOTS)
+    {
+        slots &= (1UL << wd->numSlots) - 1U;
+        if (((1UL << wd->numSlots) - 1U) == slots)
+        {
+            slots = SCAN_PIPELINE_ALL_SLOTS;
+        }
+    }
+    else
+    {
+        /* Too many slots for a mask, always scanned in full */
+        slots = SCAN_PIPELINE_ALL_SLOTS;
+    }
+    if (0U == slots)
+    {
+        return CY_CAPSENSE_STATUS_BAD_PARAM;
+    }
+
+    /* Set before the start: the completion interrupt may fire at any time after */
+    inflight_widget = widget_id;
+    inflight_slots = slots;
+    pending_slots = slots;
+    if (SCAN_PIPELINE_ALL_SLOTS == slots)
+    {
+        pending_slots = 0U;
+        status = Cy_CapSense_ScanSlots(wd->firstSlotId, wd->numSlots, capsense_ctx);
+    }
+    else
+    {
+        status = start_next_range();
+    }
+    if (CY_CAPSENSE_STATUS_SUCCESS != status)
+    {
+        inflight_widget = SCAN_PIPELINE_NONE;
+        pending_slots = 0U;
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_take
+ ********************************************************************************
+ * Summary:
+ *  Takes the last completed frame for processing. Its raw counts are valid in
+ *  the sensor contexts until the next scan is started.
+ *
+ * Return:
+ *  Widget ID of the frame, SCAN_PIPELINE_NONE if no frame has completed
+ *
+ *******************************************************************************/
+uint32_t scan_pipeline_take(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t widget_id = completed_widget;
+
+    processing_slots = completed_slots;
+    completed_widget = SCAN_PIPELINE_NONE;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    return widget_id;
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_isr
+ ********************************************************************************
+ * Summary:
+ *  Records the end of a frame. Called from both MSC interrupt handlers; the
+ *  frame is complete once the middleware reports that no channel is busy.
+ *
+ *******************************************************************************/
+void scan_pipeline_isr(void)
+{
+    if ((SCAN_PIPELINE_NONE == inflight_widget) || (CY_CAPSENSE_NOT_BUSY != Cy_CapSense_IsBusy(capsense_ctx)))
+    {
+        return;
+    }
+
+    /* Next run of the frame; if it cannot start, the frame ends with the
+     * slots scanned so far */
+    if (0U != pending_slots)
+    {
+        uint32_t pending = pending_slots;
+
+        if (CY_CAPSENSE_STATUS_SUCCESS == start_next_range())
+        {
+            return;
+        }
+        inflight_slots &= ~pending;
+        pending_slots = 0U;
+    }
+
+    /* The previous frame was never taken */
+    if (SCAN_PIPELINE_NONE != completed_widget)
+    {
+        overruns++;
+    }
+    completed_widget = inflight_widget;
+    completed_slots = inflight_slots;
+    inflight_widget = SCAN_PIPELINE_NONE;
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_get_slots
+ ********************************************************************************
+ * Summary:
+ *  Returns the slots scanned in the frame returned by scan_pipeline_take(),
+ *  bit N is slot N of its widget; SCAN_PIPELINE_ALL_SLOTS for a full scan.
+ *
+ *******************************************************************************/
+uint32_t scan_pipeline_get_slots(void)
+{
+    return processing_slots;
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_get_inflight_slots
+ ********************************************************************************
+ * Summary:
+ *  Returns the slots of the frame being scanned, bit N is slot N of its
+ *  widget; SCAN_PIPELINE_ALL_SLOTS for a full scan.
+ *
+ *******************************************************************************/
+uint32_t scan_pipeline_get_inflight_slots(void)
+{
+    return inflight_slots;
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_is_busy
+ ********************************************************************************
+ * Summary:
+ *  Returns true while a frame is being scanned.
+ *
+ *******************************************************************************/
+bool scan_pipeline_is_busy(void)
+{
+    return (SCAN_PIPELINE_NONE != inflight_widget);
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_wait
+ ********************************************************************************
+ * Summary:
+ *  Keeps the CPU in Sleep until the frame being scanned has completed. The MSC
+ *  interrupts end each Sleep: one that starts the next run of the frame sends
+ *  the CPU back to Sleep, the one that completes the frame ends the wait.
+ *  Returns at once when no frame is being scanned.
+ *
+ *******************************************************************************/
+void scan_pipeline_wait(void)
+{
+    while (SCAN_PIPELINE_NONE != inflight_widget)
+    {
+        uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+        /* A pending interrupt ends the Sleep even while masked, so the frame
+         * cannot complete between the check and the Sleep unnoticed */
+        if (SCAN_PIPELINE_NONE != inflight_widget)
+        {
+            (void)Cy_SysPm_CpuEnterSleep();
+        }
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: scan_pipeline_get_overruns
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of frames replaced before the main loop took them.
+ *
+ *******************************************************************************/
+uint32_t scan_pipeline_get_overruns(void)
+{
+    return overruns;
+}
+
+/* [] END OF FILE */
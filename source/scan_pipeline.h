@@ -0,0 +1,77 @@
+/******************************************************************************
+ * File Name: scan_pipeline.h
+ *
+ * Description: Interrupt-driven frame scanning. A frame is scanned while the
+ * CPU sleeps and processed in the same wake-up; the runs of slots of a frame
+ * are chained and its completion is signalled from the MSC interrupts rather
+ * than by polling the middleware.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef SCAN_PIPELINE_H
+#define SCAN_PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* No frame completed or in flight */
+#define SCAN_PIPELINE_NONE              (0xFFFFFFFFUL)
+
+/* Slot masks hold one bit per slot of a widget */
+#define SCAN_PIPELINE_MAX_SLOTS         (32U)
+#define SCAN_PIPELINE_ALL_SLOTS         (0xFFFFFFFFUL)
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void scan_pipeline_init(cy_stc_capsense_context_t *context);
+cy_capsense_status_t scan_pipeline_start(uint32_t widget_id);
+cy_capsense_status_t scan_pipeline_start_slots(uint32_t widget_id, uint32_t slots);
+uint32_t scan_pipeline_take(void);
+void scan_pipeline_isr(void);
+uint32_t scan_pipeline_get_slots(void);
+uint32_t scan_pipeline_get_inflight_slots(void);
+bool scan_pipeline_is_busy(void);
+void scan_pipeline_wait(void);
+uint32_t scan_pipeline_get_overruns(void);
+
+#endif /* SCAN_PIPELINE_H */
+
+/* [] END OF FILE */
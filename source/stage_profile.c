@@ -0,0 +1,255 @@
+/******************************************************************************
+ * File Name: stage_profile.c
+ *
+ * Description: Main loop stage profiler. Samples are SysTick cycle counts,
+ * counted into log2 histograms that the I2C host reads from the telemetry
+ * region.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "cy_pdl.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* De Bruijn sequence mapping 2^n - 1 to n - 1 */
+#define STAGE_PROFILE_DEBRUIJN          (0x07C4ACDDUL)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static volatile stage_profile_buffer_t *profile = NULL;
+static bool counter_started = false;
+
+static const uint8_t msb_index[32] =
+{
+     0U,  9U,  1U, 10U, 13U, 21U,  2U, 29U, 11U, 14U, 16U, 18U, 22U, 25U,  3U, 30U,
+     8U, 12U, 20U, 28U, 15U, 17U, 24U,  7U, 19U, 27U, 23U,  6U, 26U,  5U,  4U, 31U
+};
+
+/*******************************************************************************
+ * Function Name: bin_index
+ ********************************************************************************
+ * Summary:
+ *  Returns the histogram bin of a sample: the number of significant bits,
+ *  limited to the last bin. The Cortex-M0+ has no CLZ instruction.
+ *
+ *******************************************************************************/
+static uint32_t bin_index(uint32_t cycles)
+{
+    uint32_t bin;
+
+    if (0U == cycles)
+    {
+        return 0U;
+    }
+
+    /* Set every bit below the most significant one */
+    cycles |= cycles >> 1U;
+    cycles |= cycles >> 2U;
+    cycles |= cycles >> 4U;
+    cycles |= cycles >> 8U;
+    cycles |= cycles >> 16U;
+    bin = (uint32_t)msb_index[(uint32_t)(cycles * STAGE_PROFILE_DEBRUIJN) >> 27U] + 1U;
+
+    return (bin < STAGE_PROFILE_BINS) ? bin : (STAGE_PROFILE_BINS - 1U);
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_clear
+ ********************************************************************************
+ * Summary:
+ *  Empties all histograms.
+ *
+ *******************************************************************************/
+void stage_profile_clear(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    for (uint32_t i = 0U; i < STAGE_PROFILE_COUNT; i++)
+    {
+        volatile stage_profile_hist_t *hist = &profile->stage[i];
+
+        hist->count = 0U;
+        hist->last = 0U;
+        hist->min = 0xFFFFFFFFUL;
+        hist->max = 0U;
+        for (uint32_t b = 0U; b < STAGE_PROFILE_BINS; b++)
+        {
+            hist->bins[b] = 0U;
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_start
+ ********************************************************************************
+ * Summary:
+ *  Starts SysTick as a free-running cycle counter, once; later calls leave it
+ *  running so that a span timed across them stays valid. SysTick stops in Deep
+ *  Sleep, so a stage must not span a Deep Sleep period.
+ *
+ *******************************************************************************/
+void stage_profile_start(void)
+{
+    if (!counter_started)
+    {
+        Cy_SysTick_SetClockSource(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU);
+        Cy_SysTick_SetReload(CY_SYSTICK_RELOAD_MAX);
+        Cy_SysTick_Clear();
+        Cy_SysTick_Enable();
+        counter_started = true;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_init
+ ********************************************************************************
+ * Summary:
+ *  Empties the histograms, fills in the buffer header and starts the cycle
+ *  counter if stage_profile_start() has not already done so.
+ *
+ * Parameters:
+ *  buffer: histogram buffer, exposed to the I2C host by the application
+ *
+ *******************************************************************************/
+void stage_profile_init(volatile stage_profile_buffer_t *buffer)
+{
+    profile = buffer;
+    profile->version = STAGE_PROFILE_VERSION;
+    profile->num_stages = (uint8_t)STAGE_PROFILE_COUNT;
+    profile->num_bins = (uint8_t)STAGE_PROFILE_BINS;
+    profile->reserved = 0U;
+    profile->cpu_hz = Cy_SysClk_ClkSysGetFrequency();
+    stage_profile_clear();
+    stage_profile_start();
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_now
+ ********************************************************************************
+ * Summary:
+ *  Returns a SysTick timestamp for stage_profile_since().
+ *
+ *******************************************************************************/
+uint32_t stage_profile_now(void)
+{
+    return Cy_SysTick_GetValue();
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_record
+ ********************************************************************************
+ * Summary:
+ *  Adds one sample to the histogram of a stage. May be called from an
+ *  interrupt handler.
+ *
+ * Parameters:
+ *  stage: stage the sample belongs to
+ *  cycles: duration in CPU cycles
+ *
+ *******************************************************************************/
+void stage_profile_record(stage_profile_stage_t stage, uint32_t cycles)
+{
+    volatile stage_profile_hist_t *hist = &profile->stage[stage];
+    uint32_t bin = bin_index(cycles);
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (hist->count != 0xFFFFFFFFUL)
+    {
+        hist->count++;
+    }
+    if (hist->bins[bin] != 0xFFFFU)
+    {
+        hist->bins[bin]++;
+    }
+    hist->last = cycles;
+    if (cycles < hist->min)
+    {
+        hist->min = cycles;
+    }
+    if (cycles > hist->max)
+    {
+        hist->max = cycles;
+    }
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_since
+ ********************************************************************************
+ * Summary:
+ *  Records the cycles elapsed since a stage_profile_now() timestamp.
+ *
+ * Parameters:
+ *  stage: stage the sample belongs to
+ *  start: timestamp taken at the start of the stage
+ *
+ *******************************************************************************/
+void stage_profile_since(stage_profile_stage_t stage, uint32_t start)
+{
+    stage_profile_record(stage, stage_profile_elapsed(start));
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_elapsed
+ ********************************************************************************
+ * Summary:
+ *  Returns the cycles elapsed since a stage_profile_now() timestamp, for
+ *  spans shorter than one SysTick period.
+ *
+ *******************************************************************************/
+uint32_t stage_profile_elapsed(uint32_t start)
+{
+    /* SysTick counts down */
+    return (start - Cy_SysTick_GetValue()) & CY_SYSTICK_RELOAD_MAX;
+}
+
+/*******************************************************************************
+ * Function Name: stage_profile_get_cpu_hz
+ ********************************************************************************
+ * Summary:
+ *  Returns the cycle rate of all samples.
+ *
+ *******************************************************************************/
+uint32_t stage_profile_get_cpu_hz(void)
+{
+    return profile->cpu_hz;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * File Name: stage_profile.h
+ *
+ * Description: Main loop stage profiler. Every stage of a wake-up (WDT wake,
+ * ILO compensation, scans, processing and decoding) is timed in CPU cycles with
+ * SysTick and counted into a fixed-size log2 histogram per stage. The
+ * histograms are kept in a buffer inside the telemetry region, which is
+ * exposed to the I2C host so they can be read while the device runs.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef STAGE_PROFILE_H
+#define STAGE_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Bin 0 counts zero-cycle samples, bin n samples of 2^(n-1) to 2^n - 1
+ * cycles; the last bin also holds everything longer */
+#define STAGE_PROFILE_BINS              (32U)
+
+/* Layout version of stage_profile_buffer_t */
+#define STAGE_PROFILE_VERSION           (7U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef enum
+{
+    STAGE_PROFILE_WAKE,             /* WDT match to the return from Deep Sleep */
+    STAGE_PROFILE_ILO,              /* ILO compensation lookup or measurement */
+    STAGE_PROFILE_PROX_SCAN,        /* Proximity scan start to completion interrupt */
+    STAGE_PROFILE_TOUCH_SCAN,       /* Touchpad scan start to completion interrupt */
+    STAGE_PROFILE_PROX_PROCESS,     /* Proximity frame processing */
+    STAGE_PROFILE_TOUCH_PROCESS,    /* Cy_CapSense_ProcessWidget() of the touchpad */
+    STAGE_PROFILE_DECODE,           /* Cy_CapSense_DecodeWidgetGestures() */
+    STAGE_PROFILE_LOOP,             /* Return from Deep Sleep to the next Deep Sleep request */
+    STAGE_PROFILE_TUNER,            /* Tuner servicing, including skipped synchronizations */
+    STAGE_PROFILE_RAW_FILTER,       /* Touchpad raw count filters, frames with a stage enabled */
+    STAGE_PROFILE_PM_SLEEP,         /* Deep Sleep callback, preparing the peripherals */
+    STAGE_PROFILE_PM_WAKE,          /* Deep Sleep callback, restoring the peripherals */
+    STAGE_PROFILE_SCAN_WAIT,        /* CPU Sleep until the frame of the wake-up is scanned */
+    STAGE_PROFILE_ACTIVE,           /* Active CPU time from the return from Deep Sleep to the next
+                                     * Deep Sleep request, without the scan wait */
+    STAGE_PROFILE_CLOCK_CAL,        /* Touchpad calibration on a sense clock move, retry included */
+    STAGE_PROFILE_CAPSENSE_START,   /* Middleware start at boot: calibration or restore */
+    STAGE_PROFILE_FIRST_GESTURE,    /* Proximity detection to the first gesture, device time */
+    STAGE_PROFILE_COUNT
+} stage_profile_stage_t;
+
+/* All fields are little-endian, as read over I2C */
+typedef struct
+{
+    uint32_t count;                 /* Samples, saturating */
+    uint32_t last;                  /* Last sample, in CPU cycles */
+    uint32_t min;
+    uint32_t max;
+    uint16_t bins[STAGE_PROFILE_BINS];  /* Saturating counts */
+} stage_profile_hist_t;
+
+typedef struct
+{
+    uint8_t version;
+    uint8_t num_stages;
+    uint8_t num_bins;
+    uint8_t reserved;
+    uint32_t cpu_hz;                /* Cycle rate of all samples */
+    stage_profile_hist_t stage[STAGE_PROFILE_COUNT];
+} stage_profile_buffer_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void stage_profile_start(void);
+void stage_profile_init(volatile stage_profile_buffer_t *buffer);
+uint32_t stage_profile_now(void);
+void stage_profile_record(stage_profile_stage_t stage, uint32_t cycles);
+void stage_profile_since(stage_profile_stage_t stage, uint32_t start);
+uint32_t stage_profile_elapsed(uint32_t start);
+void stage_profile_clear(void);
+uint32_t stage_profile_get_cpu_hz(void);
+
+#endif /* STAGE_PROFILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,230 @@
+/******************************************************************************
+ * File Name: telemetry.c
+ *
+ * Description: Compact telemetry region. Publishes every processed frame as a
+ * delta-encoded record with an absolute snapshot for resynchronization, and
+ * serves the control word written by the I2C host.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "telemetry.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+volatile telemetry_region_t telemetry_region;
+
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/*******************************************************************************
+ * Function Name: checksum
+ ********************************************************************************
+ * Summary:
+ *  XOR of a byte range.
+ *
+ *******************************************************************************/
+static uint8_t checksum(const volatile uint8_t *data, uint32_t length)
+{
+    uint8_t sum = 0U;
+
+    for (uint32_t i = 0U; i < length; i++)
+    {
+        sum ^= data[i];
+    }
+    return sum;
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_init
+ ********************************************************************************
+ * Summary:
+ *  Clears the region and takes the initial snapshot. The stage profile is
+ *  initialized on its buffer inside the region.
+ *
+ * Parameters:
+ *  context: CAPSENSE context whose sensors are published
+ *
+ *******************************************************************************/
+void telemetry_init(cy_stc_capsense_context_t *context)
+{
+    volatile telemetry_frame_t *frame = &telemetry_region.frame;
+    volatile telemetry_snapshot_t *snapshot = &telemetry_region.snapshot;
+
+    capsense_ctx = context;
+    telemetry_region.control = 0U;
+
+    frame->version = TELEMETRY_VERSION;
+    frame->frame = 0U;
+    frame->payload_len = 0U;
+    frame->num_touch = 0U;
+    frame->timestamp = 0U;
+    frame->changed = 0U;
+    frame->gesture = 0U;
+    frame->x = TELEMETRY_NO_POSITION;
+    frame->y = TELEMETRY_NO_POSITION;
+    frame->checksum = 0U;
+    frame->checksum = checksum((const volatile uint8_t *)frame, TELEMETRY_FRAME_HEADER_SIZE);
+
+    snapshot->version = TELEMETRY_VERSION;
+    snapshot->frame = 0U;
+    for (uint32_t i = 0U; i < TELEMETRY_NUM_SENSORS; i++)
+    {
+        snapshot->diff[i] = 0U;
+    }
+    snapshot->checksum = 0U;
+    snapshot->checksum = checksum((const volatile uint8_t *)snapshot, sizeof(*snapshot));
+
+    stage_profile_init(&telemetry_region.profile);
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_encode_delta
+ ********************************************************************************
+ * Summary:
+ *  Writes a signed delta as a zigzag varint.
+ *
+ * Parameters:
+ *  buffer: at least TELEMETRY_DELTA_MAX_BYTES bytes
+ *  delta: difference of two diff counts
+ *
+ * Return:
+ *  Number of bytes written
+ *
+ *******************************************************************************/
+uint32_t telemetry_encode_delta(uint8_t *buffer, int32_t delta)
+{
+    uint32_t value = ((uint32_t)delta << 1U) ^ (uint32_t)(delta >> 31);
+    uint32_t length = 0U;
+
+    while (value >= 0x80U)
+    {
+        buffer[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7U;
+    }
+    buffer[length++] = (uint8_t)value;
+
+    return length;
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_publish
+ ********************************************************************************
+ * Summary:
+ *  Publishes the frame just processed. Sensors of the widget that was not
+ *  scanned keep their diff counts and are not reported as changed.
+ *
+ * Parameters:
+ *  widget_id: widget of the processed frame
+ *  gesture: gesture decoded from a touchpad frame, 0 otherwise
+ *  touch: touch information of a touchpad frame, NULL otherwise
+ *
+ *******************************************************************************/
+void telemetry_publish(uint32_t widget_id, uint32_t gesture, const cy_stc_capsense_touch_t *touch)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[widget_id];
+    volatile telemetry_frame_t *frame = &telemetry_region.frame;
+    volatile telemetry_snapshot_t *snapshot = &telemetry_region.snapshot;
+    uint8_t payload[TELEMETRY_PAYLOAD_MAX];
+    uint32_t first = (CY_CAPSENSE_TOUCHPAD0_WDGT_ID == widget_id) ? 0U : TELEMETRY_PROX_SENSOR;
+    uint32_t length = 0U;
+    uint32_t changed = 0U;
+    uint16_t number = (uint16_t)(frame->frame + 1U);
+
+    /* Encode against the snapshot of the previous frame, then update it */
+    for (uint32_t i = 0U; i < wd->numSns; i++)
+    {
+        uint16_t diff = wd->ptrSnsContext[i].diff;
+        uint16_t previous = snapshot->diff[first + i];
+
+        if (diff != previous)
+        {
+            changed |= 1UL << (first + i);
+            length += telemetry_encode_delta(&payload[length], (int32_t)diff - (int32_t)previous);
+            snapshot->diff[first + i] = diff;
+        }
+    }
+    snapshot->frame = number;
+    snapshot->checksum = 0U;
+    snapshot->checksum = checksum((const volatile uint8_t *)snapshot, sizeof(*snapshot));
+
+    frame->frame = number;
+    frame->payload_len = (uint8_t)length;
+    frame->timestamp = (uint16_t)capsense_ctx->ptrCommonContext->timestamp;
+    frame->changed = changed;
+    frame->gesture = gesture;
+    if ((NULL != touch) && (touch->numPosition > 0U))
+    {
+        frame->num_touch = touch->numPosition;
+        frame->x = touch->ptrPosition[0].x;
+        frame->y = touch->ptrPosition[0].y;
+    }
+    else
+    {
+        frame->num_touch = 0U;
+        frame->x = TELEMETRY_NO_POSITION;
+        frame->y = TELEMETRY_NO_POSITION;
+    }
+    for (uint32_t i = 0U; i < length; i++)
+    {
+        frame->payload[i] = payload[i];
+    }
+    frame->checksum = 0U;
+    frame->checksum = checksum((const volatile uint8_t *)frame, TELEMETRY_FRAME_HEADER_SIZE + length);
+}
+
+/*******************************************************************************
+ * Function Name: telemetry_service
+ ********************************************************************************
+ * Summary:
+ *  Serves requests written to the control word by the I2C host. Called from
+ *  the main loop.
+ *
+ *******************************************************************************/
+void telemetry_service(void)
+{
+    uint32_t control = telemetry_region.control;
+
+    if (0U != (control & TELEMETRY_CONTROL_CLEAR_PROFILE))
+    {
+        stage_profile_clear();
+    }
+    if (0U != control)
+    {
+        telemetry_region.control = 0U;
+    }
+}
+
+/* [] END OF FILE */
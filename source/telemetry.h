@@ -0,0 +1,138 @@
+/******************************************************************************
+ * File Name: telemetry.h
+ *
+ * Description: Compact telemetry region exposed on the secondary EZI2C address.
+ * Each processed frame is published as a small versioned record: frame counter,
+ * bitmap of the sensors whose diff count changed, varint delta-encoded diff
+ * counts of those sensors, and touch and gesture state. A snapshot of the
+ * absolute diff counts of the same frame lets a host that missed frames
+ * resynchronize. The region also carries the stage profile histograms.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "cycfg_capsense.h"
+#include "stage_profile.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Layout version of telemetry_frame_t and telemetry_snapshot_t */
+#define TELEMETRY_VERSION               (1U)
+
+/* Touchpad sensors in widget order, followed by the proximity sensor */
+#define TELEMETRY_NUM_SENSORS           (CY_CAPSENSE_TOUCHPAD0_NUM_SNS + 1U)
+#define TELEMETRY_PROX_SENSOR           (CY_CAPSENSE_TOUCHPAD0_NUM_SNS)
+
+/* A delta takes at most three varint bytes */
+#define TELEMETRY_DELTA_MAX_BYTES       (3U)
+#define TELEMETRY_PAYLOAD_MAX           (((TELEMETRY_NUM_SENSORS * TELEMETRY_DELTA_MAX_BYTES) + 3U) & ~3U)
+
+/* Position of a frame without a touch */
+#define TELEMETRY_NO_POSITION           (0xFFFFU)
+
+/* Bits of telemetry_region_t.control, written by the I2C host */
+#define TELEMETRY_CONTROL_CLEAR_PROFILE (0x1U)
+
+/* Bytes of the region the I2C host may write: the control word */
+#define TELEMETRY_RW_BOUNDARY           (4U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+/* Latest frame. A host reads the fixed header and payload_len bytes of
+ * payload in one transfer. The payload holds one zigzag varint delta per set
+ * bit of changed, lowest bit first: seven bits per byte, least significant
+ * group first, bit 7 set on all but the last byte. */
+typedef struct
+{
+    uint8_t version;                /* TELEMETRY_VERSION */
+    uint8_t checksum;               /* XOR of the header and payload, taken as 0 here */
+    uint16_t frame;                 /* Frame counter */
+    uint8_t payload_len;
+    uint8_t num_touch;              /* Fingers on the touchpad */
+    uint16_t timestamp;             /* Gesture timestamp, low 16 bits */
+    uint32_t changed;               /* Bit n: diff count of sensor n changed */
+    uint32_t gesture;               /* Gesture decoded from this frame, 0 - none */
+    uint16_t x;                     /* First touch, TELEMETRY_NO_POSITION if none */
+    uint16_t y;
+    uint8_t payload[TELEMETRY_PAYLOAD_MAX];
+} telemetry_frame_t;
+
+/* Absolute diff counts as of frame */
+typedef struct
+{
+    uint8_t version;                /* TELEMETRY_VERSION */
+    uint8_t checksum;               /* XOR of the snapshot, taken as 0 here */
+    uint16_t frame;
+    uint16_t diff[TELEMETRY_NUM_SENSORS];
+} telemetry_snapshot_t;
+
+/* Secondary EZI2C buffer, all fields little-endian */
+typedef struct
+{
+    uint32_t control;               /* TELEMETRY_CONTROL_*, cleared once served */
+    telemetry_frame_t frame;
+    telemetry_snapshot_t snapshot;
+    stage_profile_buffer_t profile;
+} telemetry_region_t;
+
+#define TELEMETRY_FRAME_HEADER_SIZE     (offsetof(telemetry_frame_t, payload))
+
+_Static_assert(TELEMETRY_NUM_SENSORS <= 32U, "Changed-sensor bitmap is 32 bits wide");
+_Static_assert(TELEMETRY_FRAME_HEADER_SIZE == 20U, "Unexpected telemetry frame layout");
+_Static_assert(offsetof(telemetry_region_t, frame) == 4U, "Unexpected telemetry region layout");
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+extern volatile telemetry_region_t telemetry_region;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void telemetry_init(cy_stc_capsense_context_t *context);
+void telemetry_publish(uint32_t widget_id, uint32_t gesture, const cy_stc_capsense_touch_t *touch);
+void telemetry_service(void);
+uint32_t telemetry_encode_delta(uint8_t *buffer, int32_t delta);
+
+#endif /* TELEMETRY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,269 @@
+/******************************************************************************
+ * File Name: touch_history.c
+ *
+ * Description: Recent touchpad frames in a fixed ring. The middleware reports
+ * the positions of two fingers in no fixed order; each frame is matched to the
+ * previous one so that finger N stays the same finger while both are down.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "touch_history.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define TOUCH_HISTORY_MASK          (TOUCH_HISTORY_DEPTH - 1U)
+
+_Static_assert(0U == (TOUCH_HISTORY_DEPTH & TOUCH_HISTORY_MASK), "History depth must be a power of two");
+_Static_assert(2U == TOUCH_HISTORY_MAX_FINGERS, "Finger matching handles two fingers");
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static touch_history_entry_t arena[TOUCH_HISTORY_DEPTH];
+
+/* Index of the next entry to write */
+static uint32_t head = 0U;
+static uint32_t count = 0U;
+
+/*******************************************************************************
+ * Function Name: distance
+ ********************************************************************************
+ * Summary:
+ *  Returns the city-block distance between two positions.
+ *
+ *******************************************************************************/
+static uint32_t distance(const touch_history_finger_t *a, const cy_stc_capsense_position_t *b)
+{
+    uint32_t dx = (a->x > b->x) ? (uint32_t)(a->x - b->x) : (uint32_t)(b->x - a->x);
+    uint32_t dy = (a->y > b->y) ? (uint32_t)(a->y - b->y) : (uint32_t)(b->y - a->y);
+
+    return dx + dy;
+}
+
+/*******************************************************************************
+ * Function Name: touch_history_init
+ ********************************************************************************
+ * Summary:
+ *  Empties the history.
+ *
+ *******************************************************************************/
+void touch_history_init(void)
+{
+    head = 0U;
+    count = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: touch_history_push
+ ********************************************************************************
+ * Summary:
+ *  Appends a touchpad frame, replacing the oldest one when the ring is full.
+ *
+ * Parameters:
+ *  touch: touch information of the processed frame
+ *  timestamp: gesture timestamp of the frame
+ *  gesture: gesture first reported on this frame, 0 if none
+ *  flags: TOUCH_HISTORY_FLAG_* besides TOUCH_HISTORY_FLAG_LIFT, which is
+ *         set here
+ *
+ *******************************************************************************/
+void touch_history_push(const cy_stc_capsense_touch_t *touch, uint32_t timestamp, uint32_t gesture,
+                        uint32_t flags)
+{
+    const touch_history_entry_t *prev = touch_history_get(0U);
+    touch_history_entry_t *entry = &arena[head];
+    uint32_t fingers = (touch->numPosition < TOUCH_HISTORY_MAX_FINGERS) ? touch->numPosition :
+                       TOUCH_HISTORY_MAX_FINGERS;
+    uint32_t first = 0U;
+
+    /* Keep the finger order of the previous frame while two fingers stay down */
+    if ((2U == fingers) && (NULL != prev) && (2U == prev->fingers) &&
+        ((distance(&prev->finger[0], &touch->ptrPosition[1]) + distance(&prev->finger[1], &touch->ptrPosition[0])) <
+         (distance(&prev->finger[0], &touch->ptrPosition[0]) + distance(&prev->finger[1], &touch->ptrPosition[1]))))
+    {
+        first = 1U;
+    }
+
+    entry->timestamp = timestamp;
+    entry->gesture = gesture;
+    entry->fingers = touch->numPosition;
+    entry->flags = (uint8_t)(flags & ~TOUCH_HISTORY_FLAG_LIFT);
+    if ((0U == touch->numPosition) && (NULL != prev) && (0U != prev->fingers))
+    {
+        entry->flags |= TOUCH_HISTORY_FLAG_LIFT;
+    }
+    for (uint32_t i = 0U; i < TOUCH_HISTORY_MAX_FINGERS; i++)
+    {
+        if (i < fingers)
+        {
+            const cy_stc_capsense_position_t *pos = &touch->ptrPosition[(i + first) % fingers];
+
+            entry->finger[i].x = pos->x;
+            entry->finger[i].y = pos->y;
+            entry->finger[i].z = pos->z;
+        }
+        else
+        {
+            entry->finger[i] = (touch_history_finger_t){ 0U, 0U, 0U };
+        }
+    }
+
+    head = (head + 1U) & TOUCH_HISTORY_MASK;
+    if (count < TOUCH_HISTORY_DEPTH)
+    {
+        count++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: touch_history_count
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of frames held.
+ *
+ *******************************************************************************/
+uint32_t touch_history_count(void)
+{
+    return count;
+}
+
+/*******************************************************************************
+ * Function Name: touch_history_get
+ ********************************************************************************
+ * Summary:
+ *  Returns a frame in place. The entry stays valid until TOUCH_HISTORY_DEPTH
+ *  more frames have been appended.
+ *
+ * Parameters:
+ *  age: 0 for the newest frame, 1 for the one before, and so on
+ *
+ * Return:
+ *  The frame, NULL if the history does not go back that far
+ *
+ *******************************************************************************/
+const touch_history_entry_t *touch_history_get(uint32_t age)
+{
+    if (age >= count)
+    {
+        return NULL;
+    }
+    return &arena[(head - 1U - age) & TOUCH_HISTORY_MASK];
+}
+
+/*******************************************************************************
+ * Function Name: touch_history_summarize
+ ********************************************************************************
+ * Summary:
+ *  Summarizes the frames whose timestamp is within span_ticks of the newest
+ *  frame. The movement is measured over the newest run of touched frames in
+ *  the window, so that it covers one contact only.
+ *
+ * Parameters:
+ *  span_ticks: window length in gesture timestamp ticks
+ *  summary: filled with the summary
+ *
+ * Return:
+ *  false if the history is empty
+ *
+ *******************************************************************************/
+bool touch_history_summarize(uint32_t span_ticks, touch_history_summary_t *summary)
+{
+    const touch_history_entry_t *newest = touch_history_get(0U);
+    const touch_history_entry_t *contact_end = NULL;
+    const touch_history_entry_t *contact_start = NULL;
+    bool contact_open = true;
+
+    *summary = (touch_history_summary_t){ 0 };
+    if (NULL == newest)
+    {
+        return false;
+    }
+
+    for (uint32_t age = 0U; age < count; age++)
+    {
+        const touch_history_entry_t *entry = &arena[(head - 1U - age) & TOUCH_HISTORY_MASK];
+
+        if ((newest->timestamp - entry->timestamp) > span_ticks)
+        {
+            break;
+        }
+
+        summary->frames++;
+        summary->flags |= entry->flags;
+        if ((0U == summary->gesture) && (0U != entry->gesture))
+        {
+            summary->gesture = entry->gesture;
+        }
+        if (0U == entry->fingers)
+        {
+            /* Lift-off: the newest contact, if any was seen, ends here */
+            contact_open = (NULL == contact_end);
+            continue;
+        }
+
+        summary->touched++;
+        if (entry->fingers > summary->max_fingers)
+        {
+            summary->max_fingers = entry->fingers;
+        }
+        for (uint32_t i = 0U; (i < entry->fingers) && (i < TOUCH_HISTORY_MAX_FINGERS); i++)
+        {
+            if (entry->finger[i].z > summary->max_z)
+            {
+                summary->max_z = entry->finger[i].z;
+            }
+        }
+        if (contact_open)
+        {
+            if (NULL == contact_end)
+            {
+                contact_end = entry;
+            }
+            contact_start = entry;
+        }
+    }
+
+    if (NULL != contact_end)
+    {
+        summary->dx = (int32_t)contact_end->finger[0].x - (int32_t)contact_start->finger[0].x;
+        summary->dy = (int32_t)contact_end->finger[0].y - (int32_t)contact_start->finger[0].y;
+        summary->ticks = contact_end->timestamp - contact_start->timestamp;
+    }
+    return true;
+}
+
+/* [] END OF FILE */
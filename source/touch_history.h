@@ -0,0 +1,109 @@
+/******************************************************************************
+ * File Name: touch_history.h
+ *
+ * Description: Recent touchpad frames in a fixed ring: finger positions and
+ * sizes, finger count, gesture timestamp and the gesture reported on each
+ * frame. Appending is O(1) and queries read the ring in place, so gesture
+ * actions can look back without the heap or copies.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef TOUCH_HISTORY_H
+#define TOUCH_HISTORY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Frames kept, a power of two: 0.64 s of touchpad frames at 10 ms */
+#define TOUCH_HISTORY_DEPTH             (64U)
+
+/* Fingers tracked per frame, the most the gestures use */
+#define TOUCH_HISTORY_MAX_FINGERS       (2U)
+
+/* Entry flags */
+#define TOUCH_HISTORY_FLAG_WET          (0x01U) /* Liquid was detected on the panel */
+#define TOUCH_HISTORY_FLAG_LIFT         (0x02U) /* First frame without fingers after a contact */
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t z;                 /* Signal of the contact, grows with its size */
+} touch_history_finger_t;
+
+typedef struct
+{
+    uint32_t timestamp;         /* CAPSENSE gesture timestamp of the frame */
+    uint32_t gesture;           /* Gesture first reported on this frame, 0 if none */
+    touch_history_finger_t finger[TOUCH_HISTORY_MAX_FINGERS];
+    uint8_t fingers;            /* Fingers reported, may exceed TOUCH_HISTORY_MAX_FINGERS */
+    uint8_t flags;              /* TOUCH_HISTORY_FLAG_* */
+} touch_history_entry_t;
+
+/* Frames within a window, ending with the newest frame */
+typedef struct
+{
+    uint32_t frames;            /* Frames in the window */
+    uint32_t touched;           /* Frames with at least one finger */
+    uint32_t max_fingers;       /* Most fingers on one frame */
+    uint32_t max_z;             /* Largest contact signal */
+    uint32_t flags;             /* TOUCH_HISTORY_FLAG_* of any frame */
+    uint32_t gesture;           /* Newest gesture reported, 0 if none */
+    int32_t dx;                 /* Movement of the first finger over the last contact */
+    int32_t dy;
+    uint32_t ticks;             /* Timestamp ticks covered by dx and dy */
+} touch_history_summary_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void touch_history_init(void);
+void touch_history_push(const cy_stc_capsense_touch_t *touch, uint32_t timestamp, uint32_t gesture,
+                        uint32_t flags);
+uint32_t touch_history_count(void);
+const touch_history_entry_t *touch_history_get(uint32_t age);
+bool touch_history_summarize(uint32_t span_ticks, touch_history_summary_t *summary);
+
+#endif /* TOUCH_HISTORY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,281 @@
+/******************************************************************************
+ * File Name: touch_roi.c
+ *
+ * Description: Region-of-interest scanning of the touchpad. The slot of every
+ * touchpad sensor is taken from the scan slot table, so a window of columns and
+ * rows maps to the slots that cover it; sensors sharing a slot with the window
+ * are scanned for free.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "touch_roi.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define TOUCH_ROI_WDGT_ID           (CY_CAPSENSE_TOUCHPAD0_WDGT_ID)
+#define TOUCH_ROI_NUM_SNS           (CY_CAPSENSE_TOUCHPAD0_NUM_SNS)
+
+/* Slot masks are one bit per slot of the widget */
+#define TOUCH_ROI_MAX_SLOTS         (32U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/* Slot of each touchpad sensor, relative to the first slot of the widget */
+static uint8_t sensor_slot[TOUCH_ROI_NUM_SNS];
+
+/* All slots of the widget */
+static uint32_t full_mask = 0U;
+
+/* Slots to scan in the next touchpad frame */
+static uint32_t next_mask = 0U;
+
+static uint32_t confirm_count = 0U;
+static uint32_t sweep_count = 0U;
+static bool tracking = false;
+
+static touch_roi_stats_t stats;
+
+/*******************************************************************************
+ * Function Name: window_mask
+ ********************************************************************************
+ * Summary:
+ *  Returns the slots of the sensors within radius of the sensor at pos, on
+ *  one axis of the touchpad.
+ *
+ *******************************************************************************/
+static uint32_t window_mask(uint32_t pos, uint32_t resolution, uint32_t first_sns, uint32_t num_sns,
+                            uint32_t radius)
+{
+    uint32_t center = ((pos * (num_sns - 1U)) + (resolution / 2U)) / resolution;
+    uint32_t low;
+    uint32_t high;
+    uint32_t mask = 0U;
+
+    if (center >= num_sns)
+    {
+        center = num_sns - 1U;
+    }
+    low = (center > radius) ? (center - radius) : 0U;
+    high = ((center + radius) < num_sns) ? (center + radius) : (num_sns - 1U);
+
+    for (uint32_t i = low; i <= high; i++)
+    {
+        mask |= 1UL << sensor_slot[first_sns + i];
+    }
+    return mask;
+}
+
+/*******************************************************************************
+ * Function Name: touch_roi_init
+ ********************************************************************************
+ * Summary:
+ *  Maps the touchpad sensors to their slots and starts with full scans. If a
+ *  sensor has no slot or the widget has too many slots, windows are never
+ *  used.
+ *
+ * Parameters:
+ *  context: CAPSENSE context
+ *
+ *******************************************************************************/
+void touch_roi_init(cy_stc_capsense_context_t *context)
+{
+    const cy_stc_capsense_widget_config_t *wd = &context->ptrWdConfig[TOUCH_ROI_WDGT_ID];
+    uint32_t mapped = 0U;
+
+    capsense_ctx = context;
+    full_mask = (wd->numSlots >= TOUCH_ROI_MAX_SLOTS) ? UINT32_MAX : ((1UL << wd->numSlots) - 1U);
+    next_mask = full_mask;
+    confirm_count = 0U;
+    sweep_count = 0U;
+    tracking = false;
+    stats = (touch_roi_stats_t){ 0 };
+
+    for (uint32_t slot = 0U; (slot < wd->numSlots) && (slot < TOUCH_ROI_MAX_SLOTS); slot++)
+    {
+        for (uint32_t ch = 0U; ch < CY_CAPSENSE_TOTAL_CH_NUMBER; ch++)
+        {
+            const cy_stc_capsense_scan_slot_t *entry =
+                &context->ptrScanSlots[((wd->firstSlotId + slot) * CY_CAPSENSE_TOTAL_CH_NUMBER) + ch];
+
+            if ((TOUCH_ROI_WDGT_ID == entry->wdId) && (entry->snsId < TOUCH_ROI_NUM_SNS))
+            {
+                sensor_slot[entry->snsId] = (uint8_t)slot;
+                mapped++;
+            }
+        }
+    }
+
+    /* Windows need every sensor in a slot mask */
+    if ((TOUCH_ROI_NUM_SNS != mapped) || (wd->numSlots > TOUCH_ROI_MAX_SLOTS))
+    {
+        full_mask = 0U;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: touch_roi_get_slots
+ ********************************************************************************
+ * Summary:
+ *  Returns the slots to scan in the next touchpad frame, bit N is slot N of
+ *  the widget.
+ *
+ *******************************************************************************/
+uint32_t touch_roi_get_slots(void)
+{
+    return (0U != full_mask) ? next_mask : UINT32_MAX;
+}
+
+/*******************************************************************************
+ * Function Name: touch_roi_prepare
+ ********************************************************************************
+ * Summary:
+ *  Makes a completed touchpad frame ready for processing. The raw counts of
+ *  the sensors outside the scanned slots are left from an older frame; they
+ *  are set to the baseline, so that those sensors read as untouched and their
+ *  baseline does not move.
+ *
+ * Parameters:
+ *  scanned_slots: slots scanned in the frame
+ *
+ *******************************************************************************/
+void touch_roi_prepare(uint32_t scanned_slots)
+{
+    cy_stc_capsense_sensor_context_t *sns = capsense_ctx->ptrWdConfig[TOUCH_ROI_WDGT_ID].ptrSnsContext;
+    uint32_t scanned = 0U;
+
+    if (0U == full_mask)
+    {
+        return;
+    }
+
+    for (uint32_t slots = scanned_slots & full_mask; 0U != slots; slots &= slots - 1U)
+    {
+        scanned++;
+    }
+    stats.slots += scanned;
+
+    if (full_mask == (scanned_slots & full_mask))
+    {
+        stats.full_frames++;
+        return;
+    }
+
+    stats.roi_frames++;
+    for (uint32_t i = 0U; i < TOUCH_ROI_NUM_SNS; i++)
+    {
+        if (0U == (scanned_slots & (1UL << sensor_slot[i])))
+        {
+            sns[i].raw = sns[i].bsln;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: touch_roi_update
+ ********************************************************************************
+ * Summary:
+ *  Chooses the slots of the next touchpad frame from a processed frame.
+ *
+ * Parameters:
+ *  touch: touch information of the processed frame
+ *
+ *******************************************************************************/
+void touch_roi_update(const cy_stc_capsense_touch_t *touch)
+{
+    const cy_stc_capsense_widget_config_t *wd = &capsense_ctx->ptrWdConfig[TOUCH_ROI_WDGT_ID];
+    const cy_stc_capsense_position_t *pos;
+
+    if (0U == full_mask)
+    {
+        return;
+    }
+
+    if (1U != touch->numPosition)
+    {
+        /* Lift-off or a second finger */
+        if (tracking)
+        {
+            stats.fallbacks++;
+        }
+        tracking = false;
+        confirm_count = 0U;
+        next_mask = full_mask;
+        return;
+    }
+
+    if (!tracking)
+    {
+        confirm_count++;
+        if (confirm_count < TOUCH_ROI_CONFIRM_FRAMES)
+        {
+            next_mask = full_mask;
+            return;
+        }
+        tracking = true;
+        sweep_count = 0U;
+    }
+
+    sweep_count++;
+    if (sweep_count >= TOUCH_ROI_SWEEP_FRAMES)
+    {
+        sweep_count = 0U;
+        stats.sweeps++;
+        next_mask = full_mask;
+        return;
+    }
+
+    pos = &touch->ptrPosition[0];
+    next_mask = window_mask(pos->x, wd->xResolution, 0U, wd->numCols, TOUCH_ROI_COL_RADIUS) |
+                window_mask(pos->y, wd->yResolution, wd->numCols, wd->numRows, TOUCH_ROI_ROW_RADIUS);
+}
+
+/*******************************************************************************
+ * Function Name: touch_roi_get_stats
+ ********************************************************************************
+ * Summary:
+ *  Returns the window scanning counters.
+ *
+ *******************************************************************************/
+const touch_roi_stats_t *touch_roi_get_stats(void)
+{
+    return &stats;
+}
+
+/* [] END OF FILE */
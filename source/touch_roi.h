@@ -0,0 +1,89 @@
+/******************************************************************************
+ * File Name: touch_roi.h
+ *
+ * Description: Region-of-interest scanning of the touchpad. While one finger is
+ * tracked, only the slots of the sensors around its last position are scanned,
+ * with a periodic full sweep; any other case scans the full touchpad.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef TOUCH_ROI_H
+#define TOUCH_ROI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Sensors scanned on each side of the column and row of the last position.
+ * The window is chosen one frame ahead of the frame it is used for, because
+ * the next scan starts before the current frame is processed. */
+#define TOUCH_ROI_COL_RADIUS            (2U)
+#define TOUCH_ROI_ROW_RADIUS            (1U)
+
+/* Frames with exactly one finger before tracking starts */
+#define TOUCH_ROI_CONFIRM_FRAMES        (2U)
+
+/* Every Nth tracked frame is a full sweep, so that a second finger landing
+ * outside the window is found */
+#define TOUCH_ROI_SWEEP_FRAMES          (8U)
+
+/*******************************************************************************
+ * Data types
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t roi_frames;        /* Frames scanned with a window */
+    uint32_t full_frames;       /* Frames scanned in full, including sweeps */
+    uint32_t sweeps;            /* Periodic full sweeps while tracking */
+    uint32_t fallbacks;         /* Tracking ended by a lift-off or a second finger */
+    uint64_t slots;             /* Touchpad slots scanned, all frames */
+} touch_roi_stats_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void touch_roi_init(cy_stc_capsense_context_t *context);
+uint32_t touch_roi_get_slots(void);
+void touch_roi_prepare(uint32_t scanned_slots);
+void touch_roi_update(const cy_stc_capsense_touch_t *touch);
+const touch_roi_stats_t *touch_roi_get_stats(void);
+
+#endif /* TOUCH_ROI_H */
+
+/* [] END OF FILE */
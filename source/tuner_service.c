@@ -0,0 +1,147 @@
+/******************************************************************************
+ * File Name: tuner_service.c
+ *
+ * Description: CAPSENSE tuner servicing, lazy synchronization with the tuner
+ * over the primary EZI2C address.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#include "tuner_service.h"
+
+#if TUNER_ENABLED
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static CySCB_Type *ezi2c_base = NULL;
+static cy_stc_scb_ezi2c_context_t *ezi2c_ctx = NULL;
+static cy_stc_capsense_context_t *capsense_ctx = NULL;
+
+/* Device time since the last primary address transfer, saturating */
+static uint32_t idle_us = TUNER_IDLE_TIMEOUT_US;
+
+/* Cy_CapSense_RunTuner() calls */
+static uint32_t syncs = 0U;
+
+/*******************************************************************************
+ * Function Name: tuner_service_init
+ ********************************************************************************
+ * Summary:
+ *  Sets the EZI2C block that exposes cy_capsense_tuner as buffer 1 and the
+ *  CAPSENSE context to synchronize.
+ *
+ *******************************************************************************/
+void tuner_service_init(CySCB_Type *base, cy_stc_scb_ezi2c_context_t *ezi2c_context,
+                        cy_stc_capsense_context_t *capsense_context)
+{
+    ezi2c_base = base;
+    ezi2c_ctx = ezi2c_context;
+    capsense_ctx = capsense_context;
+    idle_us = TUNER_IDLE_TIMEOUT_US;
+    syncs = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_service_run
+ ********************************************************************************
+ * Summary:
+ *  Synchronizes with the tuner once per frame while it is connected. The
+ *  tuner is connected from the first read or write of buffer 1 until none
+ *  has been seen for TUNER_IDLE_TIMEOUT_US.
+ *
+ * Parameters:
+ *  elapsed_us: device time since the previous call
+ *
+ *******************************************************************************/
+void tuner_service_run(uint32_t elapsed_us)
+{
+#if TUNER_LAZY_SYNC
+    /* Reading the activity also clears it */
+    uint32_t activity = Cy_SCB_EZI2C_GetActivity(ezi2c_base, ezi2c_ctx);
+
+    if (0U != (activity & (CY_SCB_EZI2C_STATUS_READ1 | CY_SCB_EZI2C_STATUS_WRITE1)))
+    {
+        idle_us = 0U;
+    }
+    else if (idle_us < TUNER_IDLE_TIMEOUT_US)
+    {
+        idle_us += elapsed_us;
+    }
+    else
+    {
+        /* Not connected */
+    }
+
+    if (idle_us >= TUNER_IDLE_TIMEOUT_US)
+    {
+        return;
+    }
+#else
+    (void)elapsed_us;
+#endif /* TUNER_LAZY_SYNC */
+
+    /* Establishes synchronized communication with the CapSense Tuner tool */
+    (void)Cy_CapSense_RunTuner(capsense_ctx);
+    syncs++;
+}
+
+/*******************************************************************************
+ * Function Name: tuner_service_is_connected
+ ********************************************************************************
+ * Summary:
+ *  Returns true while the tuner is being synchronized.
+ *
+ *******************************************************************************/
+bool tuner_service_is_connected(void)
+{
+    return (TUNER_LAZY_SYNC == 0U) || (idle_us < TUNER_IDLE_TIMEOUT_US);
+}
+
+/*******************************************************************************
+ * Function Name: tuner_service_get_syncs
+ ********************************************************************************
+ * Summary:
+ *  Returns the number of Cy_CapSense_RunTuner() calls.
+ *
+ *******************************************************************************/
+uint32_t tuner_service_get_syncs(void)
+{
+    return syncs;
+}
+
+#endif /* TUNER_ENABLED */
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * File Name: tuner_service.h
+ *
+ * Description: CAPSENSE tuner servicing. Cy_CapSense_RunTuner() is called only
+ * while an I2C host uses the primary EZI2C address, and the tuner interface can
+ * be compiled out for production builds.
+ *
+ * Related Document: See README.md
+ *
+ *******************************************************************************
+ * Copyright 2023, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ *******************************************************************************/
+
+#ifndef TUNER_SERVICE_H
+#define TUNER_SERVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cy_pdl.h"
+#include "cycfg_capsense.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* 0 - production build: the tuner buffer is not exposed and the tuner is
+ * never serviced. Set by the PRODUCTION=1 make variable. */
+#ifndef TUNER_ENABLED
+#define TUNER_ENABLED                   (1U)
+#endif
+
+/* 1 - synchronize with the tuner only after traffic on the primary EZI2C
+ * address has been seen; 0 - on every frame */
+#ifndef TUNER_LAZY_SYNC
+#define TUNER_LAZY_SYNC                 (1U)
+#endif
+
+/* Device time without primary address traffic after which the tuner is
+ * considered disconnected */
+#define TUNER_IDLE_TIMEOUT_US           (5000000UL)
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+#if TUNER_ENABLED
+void tuner_service_init(CySCB_Type *base, cy_stc_scb_ezi2c_context_t *ezi2c_context,
+                        cy_stc_capsense_context_t *capsense_context);
+void tuner_service_run(uint32_t elapsed_us);
+bool tuner_service_is_connected(void);
+uint32_t tuner_service_get_syncs(void);
+#endif /* TUNER_ENABLED */
+
+#endif /* TUNER_SERVICE_H */
+
+/* [] END OF FILE */